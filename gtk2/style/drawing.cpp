@@ -1401,73 +1401,138 @@ drawEntryField(cairo_t *cr, GtkStyle *style, GtkStateType state,
     }
 }
 
-static void
-qtcSetProgressStripeClipping(cairo_t *cr, const QtcRect *area, int x, int y,
-                             int width, int height, int animShift, bool horiz)
-{
-    switch (opts.stripedProgress) {
-    default:
-    case STRIPE_PLAIN: {
-        QtcRect rect = {x, y, width - 2, height - 2};
-        Rect::constrain(&rect, area);
-        cairo_region_t *region = cairo_region_create_rectangle(&rect);
-        if (horiz) {
-            for (int stripeOffset = 0;
-                 stripeOffset < width + PROGRESS_CHUNK_WIDTH;
-                 stripeOffset += PROGRESS_CHUNK_WIDTH * 2) {
-                QtcRect innerRect = {x + stripeOffset + animShift, y + 1,
-                                     PROGRESS_CHUNK_WIDTH, height - 2};
-                Rect::constrain(&innerRect, area);
-                if (innerRect.width > 0 && innerRect.height > 0) {
-                    cairo_region_xor_rectangle(region, &innerRect);
-                }
-            }
-        } else {
-            for (int stripeOffset = 0;
-                 stripeOffset < height + PROGRESS_CHUNK_WIDTH;
-                 stripeOffset += PROGRESS_CHUNK_WIDTH * 2) {
-                QtcRect innerRect = {x + 1, y + stripeOffset + animShift,
-                                     width - 2, PROGRESS_CHUNK_WIDTH};
-                /* qtcRectConstrain(&innerRect, area); */
-                if (innerRect.width > 0 && innerRect.height > 0) {
-                    cairo_region_xor_rectangle(region, &innerRect);
-                }
+// The last few surfaces used to draw animated progress bars, most recently
+// used first.
+template<typename Key, int N=8>
+class ProgressSurfaceCache {
+public:
+    template<typename Create>
+    cairo_surface_t*
+    get(const Key &key, Create &&create)
+    {
+        int i = 0;
+        for (;i < N - 1;i++) {
+            if (m_entries[i].surface && m_entries[i].key == key) {
+                break;
             }
         }
-        Cairo::clipRegion(cr, region);
-        cairo_region_destroy(region);
-        break;
-    }
-    case STRIPE_DIAGONAL:
-        cairo_new_path(cr);
-        /* if (area) */
-        /*     cairo_rectangle(cr, area->x, area->y, */
-        /*                     area->width, area->height); */
-        if (horiz) {
-            for (int stripeOffset = 0;stripeOffset < width + height + 2;
-                 stripeOffset += PROGRESS_CHUNK_WIDTH * 2) {
-                const GdkPoint pts[4] = {
-                    {x + stripeOffset + animShift, y},
-                    {x + stripeOffset + animShift + PROGRESS_CHUNK_WIDTH, y},
-                    {x + stripeOffset + animShift +
-                     PROGRESS_CHUNK_WIDTH - height, y + height - 1},
-                    {x + stripeOffset + animShift - height, y + height - 1}};
-                Cairo::pathPoints(cr, pts, 4);
+        Entry found = m_entries[i];
+        if (!(found.surface && found.key == key)) {
+            if (found.surface) {
+                cairo_surface_destroy(found.surface);
             }
-        } else {
-            for (int stripeOffset = 0;stripeOffset < height + width + 2;
-                 stripeOffset += PROGRESS_CHUNK_WIDTH * 2) {
-                const GdkPoint pts[4] = {
-                    {x, y + stripeOffset + animShift},
-                    {x + width - 1, y + stripeOffset + animShift - width},
-                    {x + width - 1, y + stripeOffset + animShift +
-                     PROGRESS_CHUNK_WIDTH - width},
-                    {x, y + stripeOffset + animShift + PROGRESS_CHUNK_WIDTH}};
-                Cairo::pathPoints(cr, pts, 4);
+            found = {key, create()};
+        }
+        memmove(&m_entries[1], &m_entries[0], i * sizeof(Entry));
+        m_entries[0] = found;
+        return found.surface;
+    }
+private:
+    struct Entry {
+        Key key;
+        cairo_surface_t *surface;
+    };
+    Entry m_entries[N] = {};
+};
+
+// One period of the stripes as an alpha mask, in coordinates relative to
+// the outer rect of the bar with the animation offset taken out.
+static cairo_surface_t*
+progressStripeMask(cairo_t *cr, bool horiz, int thickness)
+{
+    struct Key {
+        EStripe stripe;
+        bool horiz;
+        int thickness;
+        bool
+        operator==(const Key &other) const
+        {
+            return (stripe == other.stripe && horiz == other.horiz &&
+                    thickness == other.thickness);
+        }
+    };
+    static ProgressSurfaceCache<Key> cache;
+    return cache.get({opts.stripedProgress, horiz, thickness}, [&] {
+            const int period = PROGRESS_CHUNK_WIDTH * 2;
+            cairo_surface_t *mask = cairo_surface_create_similar(
+                cairo_get_target(cr), CAIRO_CONTENT_ALPHA,
+                horiz ? period : thickness, horiz ? thickness : period);
+            cairo_t *maskCr = cairo_create(mask);
+            cairo_set_source_rgba(maskCr, 0, 0, 0, 1);
+            if (opts.stripedProgress == STRIPE_DIAGONAL) {
+                for (int offset = 0;offset < period + thickness;
+                     offset += period) {
+                    if (horiz) {
+                        const GdkPoint pts[4] = {
+                            {offset, 0},
+                            {offset + PROGRESS_CHUNK_WIDTH, 0},
+                            {offset + PROGRESS_CHUNK_WIDTH - thickness,
+                             thickness - 1},
+                            {offset - thickness, thickness - 1}};
+                        Cairo::pathPoints(maskCr, pts, 4);
+                    } else {
+                        const GdkPoint pts[4] = {
+                            {0, offset},
+                            {thickness - 1, offset - thickness},
+                            {thickness - 1,
+                             offset + PROGRESS_CHUNK_WIDTH - thickness},
+                            {0, offset + PROGRESS_CHUNK_WIDTH}};
+                        Cairo::pathPoints(maskCr, pts, 4);
+                    }
+                }
+            } else if (horiz) {
+                // Plain stripes stop two pixels short of the far edge, as
+                // they always did.
+                cairo_rectangle(maskCr, PROGRESS_CHUNK_WIDTH, 0,
+                                PROGRESS_CHUNK_WIDTH, qtcMax(thickness - 2, 0));
+            } else {
+                cairo_rectangle(maskCr, 0, PROGRESS_CHUNK_WIDTH,
+                                qtcMax(thickness - 2, 0), PROGRESS_CHUNK_WIDTH);
             }
+            cairo_fill(maskCr);
+            cairo_destroy(maskCr);
+            return mask;
+        });
+}
+
+// The bar drawn in the stripe color, shown through progressStripeMask.
+static cairo_surface_t*
+progressStripeLayer(cairo_t *cr, GtkStyle *style, GtkStateType state,
+                    GtkWidget *widget, int width, int height,
+                    const GdkColor *color, EWidget wid, int flags)
+{
+    struct Key {
+        GtkStateType state;
+        int width;
+        int height;
+        GdkColor color;
+        GdkColor highlight;
+        EWidget wid;
+        int flags;
+        bool
+        operator==(const Key &other) const
+        {
+            return (state == other.state && width == other.width &&
+                    height == other.height &&
+                    gdk_color_equal(&color, &other.color) &&
+                    gdk_color_equal(&highlight, &other.highlight) &&
+                    wid == other.wid && flags == other.flags);
         }
-        cairo_clip(cr);
-    }
+    };
+    static ProgressSurfaceCache<Key> cache;
+    const Key key = {state, width, height, *color,
+                     qtcPalette.highlight[ORIGINAL_SHADE], wid, flags};
+    return cache.get(key, [&] {
+            cairo_surface_t *layer = cairo_surface_create_similar(
+                cairo_get_target(cr), CAIRO_CONTENT_COLOR_ALPHA,
+                width, height);
+            cairo_t *layerCr = cairo_create(layer);
+            drawLightBevel(layerCr, style, state, nullptr, 0, 0, width,
+                           height, color, qtcPalette.highlight, ROUNDED_ALL,
+                           wid, BORDER_FLAT, flags, widget);
+            cairo_destroy(layerCr);
+            return layer;
+        });
 }
 
 void
@@ -1548,14 +1613,27 @@ drawProgress(cairo_t *cr, GtkStyle *style, GtkStateType state,
                        width + (horiz ? sizeMod : 0),
                        height + (horiz ? 0 : sizeMod), horiz);
         } else {
+            // Neither the stripes nor the bar drawn in the stripe color
+            // change between animation frames, only the offset of the
+            // stripes does.
+            cairo_surface_t *layer = progressStripeLayer(
+                cr, style, new_state, widget, width, height, &itemCols[1], wid,
+                (opts.fillProgress || !opts.borderProgress ? 0 :
+                 DF_DO_BORDER) | (horiz ? 0 : DF_VERT));
+            cairo_pattern_t *mask = cairo_pattern_create_for_surface(
+                progressStripeMask(cr, horiz, horiz ? ho : wo));
+            cairo_matrix_t matrix;
+            cairo_matrix_init_translate(&matrix,
+                                        -(xo + (horiz ? animShift : 0)),
+                                        -(yo + (horiz ? 0 : animShift)));
+            cairo_pattern_set_matrix(mask, &matrix);
+            cairo_pattern_set_extend(mask, CAIRO_EXTEND_REPEAT);
+
             Cairo::Saver saver(cr);
-            qtcSetProgressStripeClipping(cr, area, xo, yo, wo, ho,
-                                         animShift, horiz);
-            drawLightBevel(cr, style, new_state, nullptr, x, y,
-                           width, height, &itemCols[1], qtcPalette.highlight,
-                           ROUNDED_ALL, wid, BORDER_FLAT,
-                           (opts.fillProgress || !opts.borderProgress ? 0 :
-                            DF_DO_BORDER) | (horiz ? 0 : DF_VERT), widget);
+            Cairo::clipRect(cr, area);
+            cairo_set_source_surface(cr, layer, x, y);
+            cairo_mask(cr, mask);
+            cairo_pattern_destroy(mask);
         }
     }
     if (opts.glowProgress && (horiz ? width : height)>3) {
@@ -2246,6 +2324,57 @@ drawSelection(cairo_t *cr, GtkStyle *style, GtkStateType state,
     }
 }
 
+#if !GTK_CHECK_VERSION(2, 90, 0)
+// Popups and tooltips are mostly shown again with a size that was used
+// before, keep the masks of the last few sizes instead of drawing a new
+// bitmap every time. The returned mask is owned by the cache.
+static GdkBitmap*
+cachedRoundedMask(int width, int height, double radius)
+{
+    struct Entry {
+        int width;
+        int height;
+        double radius;
+        GdkBitmap *mask;
+    };
+    static const int cacheSize = 8;
+    static Entry cache[cacheSize] = {};
+
+    int i = 0;
+    for (;i < cacheSize - 1;i++) {
+        const Entry &entry = cache[i];
+        if (entry.mask && entry.width == width && entry.height == height &&
+            entry.radius == radius) {
+            break;
+        }
+    }
+    Entry found = cache[i];
+    if (!(found.mask && found.width == width && found.height == height &&
+          found.radius == radius)) {
+        if (found.mask) {
+            gdk_pixmap_unref(found.mask);
+        }
+        GdkBitmap *mask = gdk_pixmap_new(nullptr, width, height, 1);
+        cairo_t *crMask = gdk_cairo_create((GdkDrawable*)mask);
+
+        cairo_rectangle(crMask, 0, 0, width, height);
+        cairo_set_source_rgba(crMask, 1, 1, 1, 0);
+        cairo_set_operator(crMask, CAIRO_OPERATOR_SOURCE);
+        cairo_paint(crMask);
+        cairo_new_path(crMask);
+        Cairo::pathWhole(crMask, 0, 0, width, height, radius, ROUNDED_ALL);
+        cairo_set_source_rgba(crMask, 0, 0, 0, 1);
+        cairo_fill(crMask);
+        cairo_destroy(crMask);
+        found = {width, height, radius, mask};
+    }
+    // Most recently used first, the last entry is the one to replace.
+    memmove(&cache[1], &cache[0], i * sizeof(Entry));
+    cache[0] = found;
+    return found.mask;
+}
+#endif
+
 void
 createRoundedMask(GtkWidget *widget, int x, int y, int width,
                   int height, double radius, bool isToolTip)
@@ -2264,25 +2393,13 @@ createRoundedMask(GtkWidget *widget, int x, int y, int width,
             gtk_widget_shape_combine_region(widget, mask);
             gdk_region_destroy(mask);
 #else
-            GdkBitmap *mask = gdk_pixmap_new(nullptr, width, height, 1);
-            cairo_t *crMask = gdk_cairo_create((GdkDrawable*)mask);
-
-            cairo_rectangle(crMask, 0, 0, width, height);
-            cairo_set_source_rgba(crMask, 1, 1, 1, 0);
-            cairo_set_operator(crMask, CAIRO_OPERATOR_SOURCE);
-            cairo_paint(crMask);
-            cairo_new_path(crMask);
-            Cairo::pathWhole(crMask, 0, 0, width, height, radius, ROUNDED_ALL);
-            cairo_set_source_rgba(crMask, 0, 0, 0, 1);
-            cairo_fill(crMask);
+            GdkBitmap *mask = cachedRoundedMask(width, height, radius);
             if (isToolTip) {
                 gtk_widget_shape_combine_mask(widget, mask, x, y);
             } else {
                 gdk_window_shape_combine_mask(
                     gtk_widget_get_parent_window(widget), mask, 0, 0);
             }
-            cairo_destroy(crMask);
-            gdk_pixmap_unref(mask);
 #endif
             props->widgetMask = size;
             /* Setting the window type to 'popup menu' seems to
@@ -3357,15 +3474,8 @@ drawCheckBox(cairo_t *cr, GtkStateType state, GtkShadowType shadow,
     }
 
     if (on) {
-        GdkPixbuf *pix = getPixbuf(getCheckRadioCol(style, ind_state, mnu),
-                                   PIX_CHECK, 1.0);
-        int pw = gdk_pixbuf_get_width(pix);
-        int ph = gdk_pixbuf_get_height(pix);
-        int dx = x + opts.crSize / 2 - pw / 2;
-        int dy = y + opts.crSize / 2 - ph/2;
-
-        gdk_cairo_set_source_pixbuf(cr, pix, dx, dy);
-        cairo_paint(cr);
+        drawCheckMark(cr, getCheckRadioCol(style, ind_state, mnu),
+                      x + opts.crSize / 2, y + opts.crSize / 2);
     } else if (tri) {
         int ty = y + opts.crSize / 2;
         const GdkColor *col = getCheckRadioCol(style, ind_state, mnu);
@@ -98,13 +98,16 @@ shadeColors(const GdkColor *base, GdkColor *vals)
 {
     bool useCustom = USE_CUSTOM_SHADES(opts);
     double hl = TO_FACTOR(opts.highlightFactor);
+    // The standard shades followed by SHADE_ORIG_HIGHLIGHT, all of base
+    double k[QTC_NUM_STD_SHADES + 1];
 
     for (int i = 0;i < QTC_NUM_STD_SHADES;i++) {
-        qtcShade(base, &vals[i], useCustom ? opts.customShades[i] :
-                 qtcShadeGetIntern(opts.contrast, i, opts.darkerBorders,
-                                   opts.shading), opts.shading);
+        k[i] = (useCustom ? opts.customShades[i] :
+                qtcShadeGetIntern(opts.contrast, i, opts.darkerBorders,
+                                  opts.shading));
     }
-    qtcShade(base, &vals[SHADE_ORIG_HIGHLIGHT], hl, opts.shading);
+    k[SHADE_ORIG_HIGHLIGHT] = hl;
+    qtcShadeN(base, k, vals, QTC_NUM_STD_SHADES + 1, opts.shading);
     qtcShade(&vals[4], &vals[SHADE_4_HIGHLIGHT], hl, opts.shading);
     qtcShade(&vals[2], &vals[SHADE_2_HIGHLIGHT], hl, opts.shading);
     vals[ORIGINAL_SHADE] = *base;
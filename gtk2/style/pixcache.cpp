@@ -27,6 +27,8 @@
 #include "qt_settings.h"
 
 #include <qtcurve-utils/gtkutils.h>
+#include <qtcurve-utils/stats.h>
+#include <qtcurve-utils/sprite.h>
 
 #include <unordered_map>
 
@@ -93,10 +95,60 @@ getPixbuf(GdkColor *widgetColor, EPixmap p, double shade)
     }
     const PixKey key = {*widgetColor, shade};
     auto &pixbuf = pixbufMap[key];
+    Stats::countCache(pixbuf.get() != nullptr);
     if (pixbuf.get() == nullptr) {
         pixbuf = pixbufCacheValueNew(key);
+        Stats::add(Stats::Counter::PixmapBytes,
+                   gdk_pixbuf_get_rowstride(pixbuf.get()) *
+                   gdk_pixbuf_get_height(pixbuf.get()));
     }
     return pixbuf.get();
 }
 
+static int
+addGlyph(SpriteAtlas &atlas, const uint8_t *data)
+{
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    GObjPtr<GdkPixbuf> pix = gdk_pixbuf_new_from_inline(-1, data, false,
+                                                        nullptr);
+#pragma GCC diagnostic pop
+    return atlas.addGlyph(gdk_pixbuf_get_pixels(pix.get()),
+                          gdk_pixbuf_get_width(pix.get()),
+                          gdk_pixbuf_get_height(pix.get()),
+                          gdk_pixbuf_get_rowstride(pix.get()), QTC_PIXEL_GDK);
+}
+
+void
+drawCheckMark(cairo_t *cr, const GdkColor *col, int cx, int cy)
+{
+    static SpriteAtlas atlas;
+    static const int checkGlyph = addGlyph(atlas, check_on);
+    static const int checkXGlyph = addGlyph(atlas, check_x_on);
+    static cairo_surface_t *surface = nullptr;
+    static unsigned generation = 0;
+
+    const SpriteAtlas::Cell &cell =
+        atlas.get(opts.xCheck ? checkXGlyph : checkGlyph, col->red >> 8,
+                  col->green >> 8, col->blue >> 8);
+    if (!cell.width) {
+        return;
+    }
+    if (!surface || generation != atlas.generation()) {
+        // The surface shares the pixels of the atlas.
+        if (surface) {
+            cairo_surface_destroy(surface);
+        }
+        surface = cairo_image_surface_create_for_data(
+            (unsigned char*)atlas.data(), CAIRO_FORMAT_ARGB32, atlas.width(),
+            atlas.height(), atlas.stride());
+        generation = atlas.generation();
+    }
+    int dx = cx - cell.width / 2;
+    int dy = cy - cell.height / 2;
+    cairo_set_source_surface(cr, surface, dx - cell.x, dy - cell.y);
+    cairo_rectangle(cr, dx, dy, cell.width, cell.height);
+    cairo_fill(cr);
+}
+
 }
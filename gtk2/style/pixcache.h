@@ -29,6 +29,10 @@
 namespace QtCurve {
 
 GdkPixbuf *getPixbuf(GdkColor *widgetColor, EPixmap p, double shade);
+/**
+ * Draw the check mark in \param col centered at \param cx, \param cy.
+ */
+void drawCheckMark(cairo_t *cr, const GdkColor *col, int cx, int cy);
 
 }
 
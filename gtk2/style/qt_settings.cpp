@@ -1100,8 +1100,9 @@ qtSettingsInit()
         if (abs(now - lastRead) > 1) {
             char *locale = setlocale(LC_NUMERIC, nullptr);
             char *path = nullptr;
-            Str::Buff<4096> str_buff;
-            char *tmpStr = nullptr;
+            // Everything formatted in here is only needed until it is parsed.
+            Arena::Scope arenaScope;
+            Str::Buff<4096, ArenaAlloc> str_buff;
             GtkSettings *settings=nullptr;
 
             setlocale(LC_NUMERIC, "C");
@@ -1395,47 +1396,39 @@ qtSettingsInit()
                 /* '#' VERSION ' '<kde version> <..nums above..>\0 */
                 int versionLen = (1 + strlen(qtcVersion()) + 1 +
                                   strlen(iconTheme) + 1 + 2 + 6 * 2 + 1);
-                char *version = (char*)malloc(versionLen);
-
-                tmpStr = getConfFile("gtk-icons", tmpStr);
-                sprintf(version, "#%s %s %02X%02X%02X%02X%02X%02X%02X",
-                        qtcVersion(), iconTheme, 4,
-                        qtSettings.iconSizes.smlTbSize,
-                        qtSettings.iconSizes.tbSize,
-                        qtSettings.iconSizes.dndSize,
-                        qtSettings.iconSizes.btnSize,
-                        qtSettings.iconSizes.mnuSize,
-                        qtSettings.iconSizes.dlgSize);
-
-                if (!checkFileVersion(tmpStr, version, versionLen)) {
+                Str::Buff<256, ArenaAlloc> version;
+                uniqueStr iconsFile(getConfFile("gtk-icons"));
+
+                version.printf("#%s %s %02X%02X%02X%02X%02X%02X%02X",
+                               qtcVersion(), iconTheme, 4,
+                               qtSettings.iconSizes.smlTbSize,
+                               qtSettings.iconSizes.tbSize,
+                               qtSettings.iconSizes.dndSize,
+                               qtSettings.iconSizes.btnSize,
+                               qtSettings.iconSizes.mnuSize,
+                               qtSettings.iconSizes.dlgSize);
+
+                if (!checkFileVersion(iconsFile.get(), version, versionLen)) {
                     static const char *constCmdStrFmt = "perl " QTC_GTK2_THEME_DIR "/map_kde_icons.pl " QTC_GTK2_THEME_DIR "/icons%d %s %d %d %d %d %d %d %d %s %s > %s.%d && mv %s.%d %s";
 
                     const char *kdeprefix = kdeIconsPrefix();
-                    int fileNameLen = strlen(tmpStr);
-                    char *cmdStr = (char*)malloc(strlen(constCmdStrFmt) + 2 +
-                                                 4 * 6 + 2 + strlen(iconTheme) +
-                                                 (kdeprefix ?
-                                                  strlen(kdeprefix) :
-                                                  DEFAULT_ICON_PREFIX_LEN) +
-                                                 fileNameLen * 3 + 64 +
-                                                 strlen(qtcVersion()) + 1);
-
-                    sprintf(cmdStr, constCmdStrFmt, 4,
-                            kdeprefix ? kdeprefix : DEFAULT_ICON_PREFIX, 4,
-                            qtSettings.iconSizes.smlTbSize,
-                            qtSettings.iconSizes.tbSize,
-                            qtSettings.iconSizes.dndSize,
-                            qtSettings.iconSizes.btnSize,
-                            qtSettings.iconSizes.mnuSize,
-                            qtSettings.iconSizes.dlgSize,
-                            iconTheme, qtcVersion(), tmpStr, getpid(),
-                            tmpStr, getpid(), tmpStr);
+                    Str::Buff<1024, ArenaAlloc> cmdStr;
+
+                    cmdStr.printf(constCmdStrFmt, 4,
+                                  kdeprefix ? kdeprefix : DEFAULT_ICON_PREFIX,
+                                  4, qtSettings.iconSizes.smlTbSize,
+                                  qtSettings.iconSizes.tbSize,
+                                  qtSettings.iconSizes.dndSize,
+                                  qtSettings.iconSizes.btnSize,
+                                  qtSettings.iconSizes.mnuSize,
+                                  qtSettings.iconSizes.dlgSize,
+                                  iconTheme, qtcVersion(), iconsFile.get(),
+                                  getpid(), iconsFile.get(), getpid(),
+                                  iconsFile.get());
                     system(cmdStr);
-                    free(cmdStr);
                 }
-                free(version);
                 gtk_rc_parse_string(path);
-                gtk_rc_parse(tmpStr);
+                gtk_rc_parse(iconsFile.get());
             }
 
             if((settings=gtk_settings_get_default()))
@@ -1474,10 +1467,8 @@ qtSettingsInit()
             {
                 static const char *constFormat="style \"" RC_SETTING "Fnt\" {font_name=\"%s\"} "
                                                "widget_class \"*\" style \"" RC_SETTING "Fnt\" ";
-                tmpStr=(char *)realloc(tmpStr, strlen(constFormat)+strlen(qtSettings.fonts[FONT_GENERAL])+1);
-
-                sprintf(tmpStr, constFormat, qtSettings.fonts[FONT_GENERAL]);
-                gtk_rc_parse_string(tmpStr);
+                str_buff.printf(constFormat, qtSettings.fonts[FONT_GENERAL]);
+                gtk_rc_parse_string(str_buff);
             }
 
             if(qtSettings.fonts[FONT_BOLD] && qtSettings.fonts[FONT_GENERAL] && strcmp(qtSettings.fonts[FONT_BOLD], qtSettings.fonts[FONT_GENERAL]))
@@ -1492,43 +1483,33 @@ qtSettingsInit()
                     static const char *constStdSuffix="\"} ";
                     static const char *constGrpBoxBoldSuffix="widget_class \"*Frame.GtkLabel\" style \"" RC_SETTING "BFnt\" "
                                                              "widget_class \"*Statusbar.*Frame.GtkLabel\" style \"" RC_SETTING "Fnt\"";
-                    tmpStr=(char *)realloc(tmpStr, strlen(constStdPrefix)+strlen(qtSettings.fonts[FONT_GENERAL])+strlen(constStdSuffix)+
-                                                   strlen(constBoldPrefix)+strlen(qtSettings.fonts[FONT_BOLD])+
-                                                   (opts.boldProgress ? strlen(constBoldSuffix) : strlen(constStdSuffix))+
-                                                   strlen(constGrpBoxBoldSuffix)+1);
-
-                    sprintf(tmpStr, "%s%s%s%s%s%s%s",
+                    str_buff.printf("%s%s%s%s%s%s%s",
                                     constStdPrefix, qtSettings.fonts[FONT_GENERAL], constStdSuffix,
                                     constBoldPrefix, qtSettings.fonts[FONT_BOLD], opts.boldProgress ? constBoldSuffix : constStdSuffix,
                                     constGrpBoxBoldSuffix);
                 }
                 else if(opts.boldProgress)
                 {
-                    tmpStr=(char *)realloc(tmpStr, strlen(constBoldPrefix)+strlen(qtSettings.fonts[FONT_BOLD])+strlen(constBoldSuffix)+1);
-                    sprintf(tmpStr, "%s%s%s", constBoldPrefix, qtSettings.fonts[FONT_BOLD], constBoldSuffix);
+                    str_buff.printf("%s%s%s", constBoldPrefix, qtSettings.fonts[FONT_BOLD], constBoldSuffix);
                 }
 
-                gtk_rc_parse_string(tmpStr);
+                gtk_rc_parse_string(str_buff);
             }
 
             if(qtSettings.fonts[FONT_MENU] && qtSettings.fonts[FONT_GENERAL] && strcmp(qtSettings.fonts[FONT_MENU], qtSettings.fonts[FONT_GENERAL]))
             {
                 static const char *constFormat="style \"" RC_SETTING "MFnt\" {font_name=\"%s\"} "
                                                "widget_class \"*.*MenuItem.*\" style \"" RC_SETTING "MFnt\" ";
-                tmpStr=(char *)realloc(tmpStr, strlen(constFormat)+strlen(qtSettings.fonts[FONT_MENU])+1);
-
-                sprintf(tmpStr, constFormat, qtSettings.fonts[FONT_MENU]);
-                gtk_rc_parse_string(tmpStr);
+                str_buff.printf(constFormat, qtSettings.fonts[FONT_MENU]);
+                gtk_rc_parse_string(str_buff);
             }
 
             if(qtSettings.fonts[FONT_TOOLBAR] && qtSettings.fonts[FONT_GENERAL] && strcmp(qtSettings.fonts[FONT_TOOLBAR], qtSettings.fonts[FONT_GENERAL]))
             {
                 static const char *constFormat="style \"" RC_SETTING "TbFnt\" {font_name=\"%s\"} "
                                                "widget_class \"*.*Toolbar.*\" style \"" RC_SETTING "TbFnt\" ";
-                tmpStr=(char *)realloc(tmpStr, strlen(constFormat)+strlen(qtSettings.fonts[FONT_TOOLBAR])+1);
-
-                sprintf(tmpStr, constFormat, qtSettings.fonts[FONT_TOOLBAR]);
-                gtk_rc_parse_string(tmpStr);
+                str_buff.printf(constFormat, qtSettings.fonts[FONT_TOOLBAR]);
+                gtk_rc_parse_string(str_buff);
             }
 
             if((opts.thin&THIN_MENU_ITEMS))
@@ -1540,9 +1521,8 @@ qtSettingsInit()
             {
                 static const char *constPasswdStrFormat="style \"QtCPasswd\" { GtkEntry::invisible-char='$' } class \"*\" style \"QtCPasswd\"";
 
-                tmpStr=(char *)realloc(tmpStr, strlen(constPasswdStrFormat)+16);
-                sprintf(tmpStr, constPasswdStrFormat, opts.passwordChar);
-                gtk_rc_parse_string(tmpStr);
+                str_buff.printf(constPasswdStrFormat, opts.passwordChar);
+                gtk_rc_parse_string(str_buff);
             }
 */
             /* For some reason Firefox 3beta4 goes mad if GtkComboBoxEntry::appears-as-list = 1 !!!! */
@@ -1564,8 +1544,6 @@ qtSettingsInit()
                                                       "GtkScrollbar::has-secondary-backward-stepper=%d "
                                                       "GtkScrollbar::has-secondary-forward-stepper=%d } "
                                                     "class \"*\" style \"" RC_SETTING "SBt\"";
-                tmpStr=(char *)realloc(tmpStr, strlen(constSbStrFormat)+1);
-
                 if(GTK_APP_OPEN_OFFICE==qtSettings.app)
                 {
                     if(SCROLLBAR_NEXT==opts.scrollbarType)
@@ -1578,23 +1556,23 @@ qtSettingsInit()
                 {
                     default:
                     case SCROLLBAR_KDE:
-                        sprintf(tmpStr, constSbStrFormat, 1, 1, 1, 0);
+                        str_buff.printf(constSbStrFormat, 1, 1, 1, 0);
                         break;
                     case SCROLLBAR_WINDOWS:
-                        sprintf(tmpStr, constSbStrFormat, 1, 1, 0, 0);
+                        str_buff.printf(constSbStrFormat, 1, 1, 0, 0);
                         break;
                     case SCROLLBAR_PLATINUM:
-                        sprintf(tmpStr, constSbStrFormat, 0, 1, 1, 0);
+                        str_buff.printf(constSbStrFormat, 0, 1, 1, 0);
                         break;
                     case SCROLLBAR_NEXT:
-                        sprintf(tmpStr, constSbStrFormat, 1, 0, 0, 1);
+                        str_buff.printf(constSbStrFormat, 1, 0, 0, 1);
                         break;
                     case SCROLLBAR_NONE:
-                        sprintf(tmpStr, constSbStrFormat, 0, 0, 0, 0);
+                        str_buff.printf(constSbStrFormat, 0, 0, 0, 0);
                         break;
                 }
 
-                gtk_rc_parse_string(tmpStr);
+                gtk_rc_parse_string(str_buff);
             }
 
             /* Set cursor colours... */
@@ -1602,16 +1580,14 @@ qtSettingsInit()
                 "{ GtkWidget::cursor-color=\"#%02X%02X%02X\" "
                 "GtkWidget::secondary-cursor-color=\"#%02X%02X%02X\" } "
                 "class \"*\" style \"" RC_SETTING "Crsr\"";
-            tmpStr=(char *)realloc(tmpStr, strlen(constStrFormat)+1);
-
-            sprintf(tmpStr, constStrFormat,
+            str_buff.printf(constStrFormat,
                     qtSettings.colors[PAL_ACTIVE][COLOR_TEXT].red>>8,
                     qtSettings.colors[PAL_ACTIVE][COLOR_TEXT].green>>8,
                     qtSettings.colors[PAL_ACTIVE][COLOR_TEXT].blue>>8,
                     qtSettings.colors[PAL_ACTIVE][COLOR_TEXT].red>>8,
                     qtSettings.colors[PAL_ACTIVE][COLOR_TEXT].green>>8,
                     qtSettings.colors[PAL_ACTIVE][COLOR_TEXT].blue>>8);
-            gtk_rc_parse_string(tmpStr);
+            gtk_rc_parse_string(str_buff);
 
             if(!opts.gtkScrollViews && nullptr!=gtk_check_version(2, 12, 0))
                 opts.gtkScrollViews=true;
@@ -1625,10 +1601,9 @@ qtSettingsInit()
                 "class \"*Button\" style \"" RC_SETTING "Etch2\""
                 "class \"*GtkOptionMenu\" style \"" RC_SETTING "Etch2\"";
 
-            tmpStr = (char*)realloc(tmpStr, strlen(constStrFormat) + 2);
-            sprintf(tmpStr, constStrFormat, (opts.thin & THIN_BUTTONS) ||
+            str_buff.printf(constStrFormat, (opts.thin & THIN_BUTTONS) ||
                     !doEffect ? 1 : 2);
-            gtk_rc_parse_string(tmpStr);
+            gtk_rc_parse_string(str_buff);
 
             constStrFormat =
                 "style \"" RC_SETTING "EtchE\" { xthickness = %d "
@@ -1640,9 +1615,8 @@ qtSettingsInit()
                 "class \"*GtkSpinButton\" style \"" RC_SETTING "EtchS\" ";
 
             int thick = /*opts.etchEntry && doEffect ?*/ 4 /*: 3*/;
-            tmpStr = (char*)realloc(tmpStr, strlen(constStrFormat) + 8);
-            sprintf(tmpStr, constStrFormat, thick, thick, thick, thick);
-            gtk_rc_parse_string(tmpStr);
+            str_buff.printf(constStrFormat, thick, thick, thick, thick);
+            gtk_rc_parse_string(str_buff);
 
             if (isMozilla()) {
                 constStrFormat =
@@ -1653,9 +1627,8 @@ qtSettingsInit()
                     RC_SETTING "EtchEM\" ";
 
                 int thick = opts.etchEntry && doEffect ? 3 : 2;
-                tmpStr = (char*)realloc(tmpStr, strlen(constStrFormat) + 4);
-                sprintf(tmpStr, constStrFormat, thick, thick);
-                gtk_rc_parse_string(tmpStr);
+                str_buff.printf(constStrFormat, thick, thick);
+                gtk_rc_parse_string(str_buff);
             }
 
             if(!opts.gtkScrollViews)
@@ -1678,9 +1651,8 @@ qtSettingsInit()
                 "style \"" RC_SETTING "SVt\" { xthickness = %d "
                 "ythickness = %d } class \"*GtkScrolledWindow\" style \""
                 RC_SETTING "SVt\"";
-            tmpStr = (char*)realloc(tmpStr, strlen(constStrFormat) + 1);
-            sprintf(tmpStr, constStrFormat, thickness, thickness);
-            gtk_rc_parse_string(tmpStr);
+            str_buff.printf(constStrFormat, thickness, thickness);
+            gtk_rc_parse_string(str_buff);
 
             constStrFormat =
                 "style \"" RC_SETTING "Pbar\" { xthickness = %d "
@@ -1689,9 +1661,8 @@ qtSettingsInit()
             int pthickness = (opts.fillProgress ?
                               doEffect && opts.borderProgress ? 1 : 0 :
                               doEffect ? 2 : 1);
-            tmpStr = (char*)realloc(tmpStr, strlen(constStrFormat) + 1);
-            sprintf(tmpStr, constStrFormat, pthickness, pthickness);
-            gtk_rc_parse_string(tmpStr);
+            str_buff.printf(constStrFormat, pthickness, pthickness);
+            gtk_rc_parse_string(str_buff);
 
             constStrFormat =
                 "style \"" RC_SETTING "TT\" { xthickness = 4 "
@@ -1700,8 +1671,7 @@ qtSettingsInit()
                 "style \"" RC_SETTING "TT\" widget \"gtk-tooltip*\" style \""
                 RC_SETTING "TT\"";
 
-            tmpStr = (char*)realloc(tmpStr, strlen(constStrFormat) + 1);
-            sprintf(tmpStr, constStrFormat,
+            str_buff.printf(constStrFormat,
                     toQtColor(qtSettings.colors[PAL_ACTIVE][COLOR_TOOLTIP].red),
                     toQtColor(qtSettings.colors[PAL_ACTIVE][COLOR_TOOLTIP].green),
                     toQtColor(qtSettings.colors[PAL_ACTIVE][COLOR_TOOLTIP].blue),
@@ -1711,7 +1681,7 @@ qtSettingsInit()
                         qtSettings.colors[PAL_ACTIVE][COLOR_TOOLTIP_TEXT].green),
                     toQtColor(
                         qtSettings.colors[PAL_ACTIVE][COLOR_TOOLTIP_TEXT].blue));
-            gtk_rc_parse_string(tmpStr);
+            gtk_rc_parse_string(str_buff);
 
             if( EFFECT_NONE==opts.buttonEffect)
                 gtk_rc_parse_string("style \"" RC_SETTING "Cmb\" { xthickness = 4 ythickness = 2 }"
@@ -1744,8 +1714,7 @@ qtSettingsInit()
                 RC_SETTING "Tree\"";
             int alt = haveAlternateListViewCol() ? COLOR_LV : COLOR_BACKGROUND;
 
-            tmpStr = (char*)realloc(tmpStr, strlen(constStrFormat) + 1);
-            sprintf(tmpStr, constStrFormat,
+            str_buff.printf(constStrFormat,
                     toQtColor(qtSettings.colors[PAL_ACTIVE][alt].red),
                     toQtColor(qtSettings.colors[PAL_ACTIVE][alt].green),
                     toQtColor(qtSettings.colors[PAL_ACTIVE][alt].blue),
@@ -1755,7 +1724,7 @@ qtSettingsInit()
                         qtSettings.colors[PAL_ACTIVE][COLOR_BACKGROUND].green),
                     toQtColor(
                         qtSettings.colors[PAL_ACTIVE][COLOR_BACKGROUND].blue));
-            gtk_rc_parse_string(tmpStr);
+            gtk_rc_parse_string(str_buff);
 
             if (!opts.useHighlightForMenu) {
                 constStrFormat =
@@ -1770,15 +1739,14 @@ qtSettingsInit()
                     " widget_class \"*.GtkImageMenuItem\" style \"" RC_SETTING
                     "Mnu\"";
 
-                tmpStr = (char*)realloc(tmpStr, strlen(constStrFormat) + 1);
-                sprintf(tmpStr, constStrFormat,
+                str_buff.printf(constStrFormat,
                         toQtColor(qtSettings.colors[PAL_ACTIVE][COLOR_TEXT].red),
                         toQtColor(qtSettings.colors[PAL_ACTIVE][COLOR_TEXT].green),
                         toQtColor(qtSettings.colors[PAL_ACTIVE][COLOR_TEXT].blue),
                         toQtColor(qtSettings.colors[PAL_ACTIVE][COLOR_TEXT].red),
                         toQtColor(qtSettings.colors[PAL_ACTIVE][COLOR_TEXT].green),
                         toQtColor(qtSettings.colors[PAL_ACTIVE][COLOR_TEXT].blue));
-                gtk_rc_parse_string(tmpStr);
+                gtk_rc_parse_string(str_buff);
             }
 
             /* Mozilla seems to assume that all scrolledviews are square :-(
@@ -1801,12 +1769,11 @@ qtSettingsInit()
 
 
                 shadeColors(&qtSettings.colors[PAL_ACTIVE][COLOR_WINDOW], qtcPalette.background);
-                tmpStr = (char*)realloc(tmpStr, strlen(constStrFormat)+1);
-                sprintf(tmpStr, constStrFormat,
+                str_buff.printf(constStrFormat,
                         toQtColor(qtcPalette.background[4].red),
                         toQtColor(qtcPalette.background[4].green),
                         toQtColor(qtcPalette.background[4].blue));
-                gtk_rc_parse_string(tmpStr);
+                gtk_rc_parse_string(str_buff);
             }
 
             if (DEFAULT_SLIDER_WIDTH != opts.sliderWidth) {
@@ -1816,10 +1783,9 @@ qtSettingsInit()
                     "  GtkScrollbar::min_slider_length = %d } "
                     " class \"*\" style \"" RC_SETTING "SbarW\" ";
 
-                tmpStr = (char*)realloc(tmpStr, strlen(constStrFormat) + 16);
-                sprintf(tmpStr, constStrFormat, opts.sliderWidth,
+                str_buff.printf(constStrFormat, opts.sliderWidth,
                         opts.sliderWidth, opts.sliderWidth+1);
-                gtk_rc_parse_string(tmpStr);
+                gtk_rc_parse_string(str_buff);
             }
 
             bool customSliderW = opts.sliderWidth != DEFAULT_SLIDER_WIDTH;
@@ -1845,9 +1811,8 @@ qtSettingsInit()
                 "{GtkScale::slider_length = %d GtkScale::slider_width = %d} "
                 "class \"*\" style \"" RC_SETTING "Sldr\"";
 
-            tmpStr = (char*)realloc(tmpStr, strlen(constStrFormat) + 8);
-            sprintf(tmpStr, constStrFormat, length, width);
-            gtk_rc_parse_string(tmpStr);
+            str_buff.printf(constStrFormat, length, width);
+            gtk_rc_parse_string(str_buff);
 
             if(!opts.menuIcons)
                 gtk_rc_parse_string("gtk-menu-images=0");
@@ -1874,9 +1839,8 @@ qtSettingsInit()
                     "style \"" RC_SETTING "CRSize\" "
                     "{ GtkCheckButton::indicator_size = %d }"
                     " class \"*\" style \"" RC_SETTING "CRSize\" ";
-                tmpStr = (char*)realloc(tmpStr, strlen(constStrFormat) + 16);
-                sprintf(tmpStr, constStrFormat, opts.crSize);
-                gtk_rc_parse_string(tmpStr);
+                str_buff.printf(constStrFormat, opts.crSize);
+                gtk_rc_parse_string(str_buff);
             }
 
 #if 0
@@ -1890,7 +1854,6 @@ qtSettingsInit()
                 gtk_rc_parse_string("style \"" RC_SETTING "TbJ\" { GtkToolbar::button-relief = 1 } "
                                     "widget_class \"*<GtkToolbar>\"  style \"" RC_SETTING "TbJ\"");
 
-            free(tmpStr);
 
             if(opts.shadeMenubarOnlyWhenActive && SHADE_WINDOW_BORDER==opts.shadeMenubars &&
                EQUAL_COLOR(qtSettings.colors[PAL_ACTIVE][COLOR_WINDOW_BORDER], qtSettings.colors[PAL_INACTIVE][COLOR_WINDOW_BORDER]))
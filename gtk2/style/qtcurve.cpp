@@ -26,6 +26,8 @@
 #include <qtcurve-utils/strs.h>
 #include <qtcurve-utils/gtkprops.h>
 #include <qtcurve-utils/x11base.h>
+#include <qtcurve-utils/trace.h>
+#include <qtcurve-utils/stats.h>
 #include <qtcurve-cairo/draw.h>
 
 #include <gmodule.h>
@@ -140,6 +142,8 @@ gtkDrawFlatBox(GtkStyle *style, GdkWindow *window, GtkStateType state,
                GtkShadowType shadow, GdkRectangle *area, GtkWidget *widget,
                const char *_detail, int x, int y, int width, int height)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     const char *detail = _detail ? _detail : "";
@@ -439,6 +443,8 @@ gtkDrawHandle(GtkStyle *style, GdkWindow *window, GtkStateType state,
               const char *_detail, int x, int y, int width, int height,
               GtkOrientation)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_WINDOW(window));
     const char *detail = _detail ? _detail : "";
@@ -535,6 +541,8 @@ gtkDrawArrow(GtkStyle *style, GdkWindow *window, GtkStateType state,
              const char *_detail, GtkArrowType arrow_type, gboolean,
              int x, int y, int width, int height)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     const char *detail = _detail ? _detail : "";
     if (qtSettings.debug == DEBUG_ALL) {
@@ -1581,6 +1589,8 @@ gtkDrawBox(GtkStyle *style, GdkWindow *window, GtkStateType state,
            GtkShadowType shadow, GdkRectangle *area, GtkWidget *widget,
            const char *detail, int x, int y, int width, int height)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     sanitizeSize(window, &width, &height);
     drawBox(style, window, state, shadow, area, widget, detail, x, y,
             width, height,
@@ -1592,6 +1602,8 @@ gtkDrawShadow(GtkStyle *style, GdkWindow *window, GtkStateType state,
               GtkShadowType shadow, GdkRectangle *area, GtkWidget *widget,
               const char *_detail, int x, int y, int width, int height)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     const char *detail = _detail ? _detail : "";
@@ -1975,6 +1987,8 @@ gtkDrawCheck(GtkStyle *style, GdkWindow *window, GtkStateType state,
              GtkShadowType shadow, GdkRectangle *_area, GtkWidget *widget,
              const char *_detail, int x, int y, int width, int height)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     const char *detail = _detail ? _detail : "";
@@ -1990,6 +2004,8 @@ gtkDrawOption(GtkStyle *style, GdkWindow *window, GtkStateType state,
               GtkShadowType shadow, GdkRectangle *_area, GtkWidget *widget,
               const char *_detail, int x, int y, int width, int height)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     const char *detail = _detail ? _detail : "";
@@ -2017,6 +2033,8 @@ gtkDrawLayout(GtkStyle *style, GdkWindow *window, GtkStateType state,
               gboolean use_text, GdkRectangle *_area, GtkWidget *widget,
               const char *_detail, int x, int y, PangoLayout *layout)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     const char *detail = _detail ? _detail : "";
@@ -2213,6 +2231,8 @@ gtkDrawTab(GtkStyle*, GdkWindow *window, GtkStateType state,
            GtkShadowType shadow, GdkRectangle *_area, GtkWidget *widget,
            const char *_detail, int x, int y, int width, int height)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     if (qtSettings.debug == DEBUG_ALL) {
         printf(DEBUG_PREFIX "%s %d %d %s  ", __FUNCTION__, state, shadow,
@@ -2253,6 +2273,8 @@ gtkDrawBoxGap(GtkStyle *style, GdkWindow *window, GtkStateType state,
               const char *_detail, int x, int y, int width, int height,
               GtkPositionType gapSide, int gapX, int gapWidth)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     const char *detail = _detail ? _detail : "";
@@ -2284,6 +2306,8 @@ gtkDrawExtension(GtkStyle *style, GdkWindow *window, GtkStateType state,
                  const char *_detail, int x, int y, int width, int height,
                  GtkPositionType gapSide)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     const char *detail = _detail ? _detail : "";
@@ -2312,6 +2336,8 @@ gtkDrawSlider(GtkStyle *style, GdkWindow *window, GtkStateType state,
               const char *_detail, int x, int y, int width, int height,
               GtkOrientation orientation)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     const char *detail = _detail ? _detail : "";
@@ -2443,6 +2469,8 @@ gtkDrawShadowGap(GtkStyle *style, GdkWindow *window, GtkStateType state,
                  const char*, int x, int y, int width, int height,
                  GtkPositionType gapSide, int gapX, int gapWidth)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     QtcRect *area = (QtcRect*)_area;
@@ -2458,6 +2486,8 @@ gtkDrawHLine(GtkStyle *style, GdkWindow *window, GtkStateType state,
              GdkRectangle *area, GtkWidget *widget, const char *_detail,
              int x1, int x2, int y)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     const char *detail = _detail ? _detail : "";
@@ -2551,6 +2581,8 @@ gtkDrawVLine(GtkStyle *style, GdkWindow *window, GtkStateType state,
              GdkRectangle *area, GtkWidget *widget, const char *_detail,
              int y1, int y2, int x)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     const char *detail = _detail ? _detail : "";
@@ -2611,6 +2643,8 @@ gtkDrawFocus(GtkStyle *style, GdkWindow *window, GtkStateType state,
              GdkRectangle *area, GtkWidget *widget, const char *_detail,
              int x, int y, int width, int height)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     if (opts.focus == FOCUS_NONE) {
         return;
     }
@@ -2916,6 +2950,8 @@ gtkDrawResizeGrip(GtkStyle *style, GdkWindow *window, GtkStateType state,
                   GdkRectangle *_area, GtkWidget *widget, const char *_detail,
                   GdkWindowEdge edge, int x, int y, int width, int height)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GTK_IS_STYLE(style));
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     QtcRect *area = (QtcRect*)_area;
@@ -2969,6 +3005,8 @@ gtkDrawExpander(GtkStyle *style, GdkWindow *window, GtkStateType state,
                 GdkRectangle *_area, GtkWidget *widget, const char *_detail,
                 int x, int y, GtkExpanderStyle expander_style)
 {
+    QTC_TRACE_FUNC();
+    Stats::countDraw(__func__);
     QTC_RET_IF_FAIL(GDK_IS_DRAWABLE(window));
     if (qtSettings.debug == DEBUG_ALL) {
         printf(DEBUG_PREFIX "%s %d %s  ", __FUNCTION__, state, _detail);
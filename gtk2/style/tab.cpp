@@ -24,6 +24,7 @@
 
 #include <qtcurve-utils/gtkprops.h>
 
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 #include <tuple>
@@ -34,13 +35,25 @@ namespace Tab {
 struct Info {
     int id;
     std::vector<QtcRect> rects;
+    // bounding rect of all tabs drawn so far
+    QtcRect bounds;
+    // tab bar geometry, recomputed on the first query after the notebook
+    // is reallocated, its pages change or a tab label is (un)mapped.
+    bool geomValid;
+    bool arrows;
+    QtcRect tabbar;
+    std::vector<GtkWidget*> labels;
     Info(GtkWidget *notebook);
 };
 
 Info::Info(GtkWidget *notebook)
     : id(-1),
       rects(gtk_notebook_get_n_pages((GtkNotebook*)notebook),
-            qtcRect(0, 0, -1, -1))
+            qtcRect(0, 0, -1, -1)),
+      bounds(qtcRect(0, 0, -1, -1)),
+      geomValid(false),
+      arrows(false),
+      tabbar(qtcRect(0, 0, -1, -1))
 {
 }
 
@@ -85,6 +98,10 @@ cleanup(GtkWidget *widget)
         props->tabMotion.disconn();
         props->tabLeave.disconn();
         props->tabPageAdded.disconn();
+        props->tabPageRemoved.disconn();
+        props->tabPageReordered.disconn();
+        props->tabSwitchPage.disconn();
+        props->tabSizeAllocate.disconn();
         props->tabHacked = true;
         tabMap.erase(widget);
     }
@@ -118,6 +135,13 @@ setHovered(Info *tab, GtkWidget *widget, int index)
     }
 }
 
+static inline bool
+contains(const QtcRect &rect, int x, int y)
+{
+    return (rect.x <= x && rect.y <= y && rect.x + rect.width > x &&
+            rect.y + rect.height > y);
+}
+
 static gboolean
 motion(GtkWidget *widget, GdkEventMotion*, void*)
 {
@@ -127,12 +151,18 @@ motion(GtkWidget *widget, GdkEventMotion*, void*)
         int py;
         gdk_window_get_pointer(gtk_widget_get_window(widget), &px, &py, nullptr);
 
-        for (size_t i = 0;i < tab->rects.size();i++) {
-            auto &rect = tab->rects[i];
-            if (rect.x <= px && rect.y <= py && rect.x + rect.width > px &&
-                rect.y + rect.height > py) {
-                setHovered(tab, widget, i);
-                return false;
+        // Most motion events either stay on the hovered tab or are nowhere
+        // near the tab bar.
+        if (tab->id >= 0 && tab->id < (int)tab->rects.size() &&
+            contains(tab->rects[tab->id], px, py)) {
+            return false;
+        }
+        if (contains(tab->bounds, px, py)) {
+            for (size_t i = 0;i < tab->rects.size();i++) {
+                if (contains(tab->rects[i], px, py)) {
+                    setHovered(tab, widget, i);
+                    return false;
+                }
             }
         }
         setHovered(tab, widget, -1);
@@ -161,6 +191,8 @@ unregisterChild(GtkWidget *widget)
         props->tabChildStyleSet.disconn();
         props->tabChildEnter.disconn();
         props->tabChildLeave.disconn();
+        props->tabChildMap.disconn();
+        props->tabChildUnmap.disconn();
         if (GTK_IS_CONTAINER(widget)) {
             props->tabChildAdd.disconn();
         }
@@ -169,6 +201,7 @@ unregisterChild(GtkWidget *widget)
 }
 
 static void updateChildren(GtkWidget *widget);
+static void invalidateGeom(GtkWidget *widget);
 
 static gboolean
 childMotion(GtkWidget *widget, GdkEventMotion *event, void *user_data)
@@ -198,6 +231,12 @@ childAdd(GtkWidget*, GdkEventCrossing *, void *data)
     return false;
 }
 
+static void
+childMapChanged(GtkWidget*, void *data)
+{
+    invalidateGeom((GtkWidget*)data);
+}
+
 static void
 registerChild(GtkWidget *notebook, GtkWidget *widget)
 {
@@ -208,6 +247,12 @@ registerChild(GtkWidget *notebook, GtkWidget *widget)
         props->tabChildStyleSet.conn("style-set", childStyleSet, notebook);
         props->tabChildEnter.conn("enter-notify-event", childMotion, notebook);
         props->tabChildLeave.conn("leave-notify-event", childMotion, notebook);
+        // Scrolling the tabs maps and unmaps the labels (which changes
+        // whether the arrows are visible) without any notebook signal.
+        if (gtk_widget_get_parent(widget) == notebook) {
+            props->tabChildMap.conn("map", childMapChanged, notebook);
+            props->tabChildUnmap.conn("unmap", childMapChanged, notebook);
+        }
         if (GTK_IS_CONTAINER(widget)) {
             props->tabChildAdd.conn("add", childAdd, notebook);
             GList *children = gtk_container_get_children(GTK_CONTAINER(widget));
@@ -235,13 +280,41 @@ updateChildren(GtkWidget *widget)
     }
 }
 
+static void
+invalidateGeom(GtkWidget *widget)
+{
+    if (Info *tab = widgetFindTab(widget)) {
+        tab->geomValid = false;
+    }
+}
+
 static gboolean
 pageAdded(GtkWidget *widget, GdkEventCrossing*, void*)
 {
+    invalidateGeom(widget);
     updateChildren(widget);
     return false;
 }
 
+static void
+pageRemoved(GtkWidget *widget, GtkWidget*, unsigned, void*)
+{
+    if (Info *tab = widgetFindTab(widget)) {
+        // Forget the rects of the pages that no longer exist.
+        size_t numPages = gtk_notebook_get_n_pages(GTK_NOTEBOOK(widget));
+        if (tab->rects.size() > numPages) {
+            tab->rects.resize(numPages);
+        }
+        tab->geomValid = false;
+    }
+}
+
+static void
+geomChanged(GtkWidget *widget)
+{
+    invalidateGeom(widget);
+}
+
 int
 currentHoveredIndex(GtkWidget *widget)
 {
@@ -262,6 +335,10 @@ setup(GtkWidget *widget)
         props->tabMotion.conn("motion-notify-event", motion);
         props->tabLeave.conn("leave-notify-event", leave);
         props->tabPageAdded.conn("page-added", pageAdded);
+        props->tabPageRemoved.conn("page-removed", pageRemoved);
+        props->tabPageReordered.conn("page-reordered", geomChanged);
+        props->tabSwitchPage.conn("switch-page", geomChanged);
+        props->tabSizeAllocate.conn("size-allocate", geomChanged);
         updateChildren(widget);
     }
 }
@@ -275,15 +352,21 @@ updateRect(GtkWidget *widget, int tabIndex, int x, int y, int width, int height)
         if (tabIndex >= (int)tab->rects.size()) {
             tab->rects.resize(tabIndex + 8, qtcRect(0, 0, -1, -1));
         }
-        tab->rects[tabIndex].x = x;
-        tab->rects[tabIndex].y = y;
-        tab->rects[tabIndex].width = width;
-        tab->rects[tabIndex].height = height;
+        QtcRect &rect = tab->rects[tabIndex];
+        rect.x = x;
+        rect.y = y;
+        rect.width = width;
+        rect.height = height;
+        if (tab->bounds.width > 0 && tab->bounds.height > 0) {
+            Rect::union_(&tab->bounds, &rect, &tab->bounds);
+        } else {
+            tab->bounds = rect;
+        }
     }
 }
 
-bool
-isLabel(GtkNotebook *notebook, GtkWidget *widget)
+static bool
+computeIsLabel(GtkNotebook *notebook, GtkWidget *widget)
 {
     int numPages = gtk_notebook_get_n_pages(notebook);
     for (int i = 0;i < numPages;++i) {
@@ -295,8 +378,8 @@ isLabel(GtkNotebook *notebook, GtkWidget *widget)
     return false;
 }
 
-QtcRect
-getTabbarRect(GtkNotebook *notebook)
+static QtcRect
+computeTabbarRect(GtkNotebook *notebook)
 {
     QtcRect rect = {0, 0, -1, -1};
     QtcRect empty = rect;
@@ -304,13 +387,12 @@ getTabbarRect(GtkNotebook *notebook)
     unsigned int borderWidth;
     int pageIndex;
     GtkWidget *page;
-    GList *children = nullptr;
-    // check tab visibility
+    // check tab visibility, a notebook's only children are its pages
+    // and their tab labels.
     if (!(gtk_notebook_get_show_tabs(notebook) &&
-          (children = gtk_container_get_children(GTK_CONTAINER(notebook))))) {
+          gtk_notebook_get_n_pages(notebook) > 0)) {
         return empty;
     }
-    g_list_free(children);
     // get full rect
     rect = Widget::getAllocation(GTK_WIDGET(notebook));
 
@@ -354,8 +436,8 @@ getTabbarRect(GtkNotebook *notebook)
     return rect;
 }
 
-bool
-hasVisibleArrows(GtkNotebook *notebook)
+static bool
+computeVisibleArrows(GtkNotebook *notebook)
 {
     if (gtk_notebook_get_show_tabs(notebook)) {
         int numPages = gtk_notebook_get_n_pages(notebook);
@@ -376,5 +458,51 @@ hasVisibleArrows(GtkNotebook *notebook)
     return false;
 }
 
+static Info*
+geomInfo(GtkNotebook *notebook)
+{
+    Info *tab = tabMap.lookup((GtkWidget*)notebook);
+    if (tab && !tab->geomValid) {
+        tab->geomValid = true;
+        tab->tabbar = computeTabbarRect(notebook);
+        tab->arrows = computeVisibleArrows(notebook);
+        int numPages = gtk_notebook_get_n_pages(notebook);
+        tab->labels.resize(numPages);
+        for (int i = 0;i < numPages;i++) {
+            tab->labels[i] = gtk_notebook_get_tab_label(
+                notebook, gtk_notebook_get_nth_page(notebook, i));
+        }
+    }
+    return tab;
+}
+
+bool
+isLabel(GtkNotebook *notebook, GtkWidget *widget)
+{
+    if (Info *tab = geomInfo(notebook)) {
+        return std::find(tab->labels.begin(), tab->labels.end(),
+                         widget) != tab->labels.end();
+    }
+    return computeIsLabel(notebook, widget);
+}
+
+QtcRect
+getTabbarRect(GtkNotebook *notebook)
+{
+    if (Info *tab = geomInfo(notebook)) {
+        return tab->tabbar;
+    }
+    return computeTabbarRect(notebook);
+}
+
+bool
+hasVisibleArrows(GtkNotebook *notebook)
+{
+    if (Info *tab = geomInfo(notebook)) {
+        return tab->arrows;
+    }
+    return computeVisibleArrows(notebook);
+}
+
 }
 }
@@ -28,47 +28,58 @@
 namespace QtCurve {
 namespace TreeView {
 
-typedef struct {
-    GtkTreePath *path;
-    GtkTreeViewColumn *column;
-    bool fullWidth;
-} QtCTreeView;
-
-static GHashTable *table = nullptr;
-
-static QtCTreeView*
-lookupHash(void *hash, bool create)
+static void
+clearHovered(const GtkWidgetProps &props)
 {
-    QtCTreeView *rv = nullptr;
+    if (props->treeViewPath) {
+        gtk_tree_path_free(props->treeViewPath);
+    }
+    props->treeViewPath = nullptr;
+    props->treeViewColumn = nullptr;
+    props->treeViewCellValid = false;
+}
 
-    if (!table)
-        table=g_hash_table_new(g_direct_hash, g_direct_equal);
+// Rows have been scrolled, resized, expanded or changed. Changes to the
+// model reach the tree view as a resize.
+static void
+geomChanged(GtkWidget *widget)
+{
+    GtkWidgetProps props(widget);
+    props->treeViewCellValid = false;
+}
 
-    rv = (QtCTreeView*)g_hash_table_lookup(table, hash);
+static void
+vadjValueChanged(GtkAdjustment*, void *data)
+{
+    geomChanged((GtkWidget*)data);
+}
 
-    if (!rv && create) {
-        rv = qtcNew(QtCTreeView);
-        rv->path=nullptr;
-        rv->column=nullptr;
-        rv->fullWidth=false;
-        g_hash_table_insert(table, hash, rv);
-        rv = (QtCTreeView*)g_hash_table_lookup(table, hash);
+// The tree view keeps a reference to its adjustment, so the connection can
+// be dropped through it as long as it is done before the adjustment is
+// replaced.
+static void
+connectVAdj(GtkWidget *widget, GtkAdjustment *adj, bool conn)
+{
+    if (!adj) {
+        return;
+    }
+    if (conn) {
+        g_signal_connect(G_OBJECT(adj), "value-changed",
+                         G_CALLBACK(vadjValueChanged), widget);
+    } else {
+        g_signal_handlers_disconnect_by_func(
+            G_OBJECT(adj), (void*)vadjValueChanged, widget);
     }
-
-    return rv;
 }
 
 static void
-removeFromHash(void *hash)
+setAdjustments(GtkWidget *widget, GtkAdjustment*, GtkAdjustment *vadj, void*)
 {
-    if (table) {
-        QtCTreeView *tv = lookupHash(hash, false);
-        if (tv) {
-            if(tv->path)
-                gtk_tree_path_free(tv->path);
-            g_hash_table_remove(table, hash);
-        }
-    }
+    // Runs before the tree view replaces the adjustments.
+    connectVAdj(widget, gtk_tree_view_get_vadjustment(GTK_TREE_VIEW(widget)),
+                false);
+    connectVAdj(widget, vadj, true);
+    geomChanged(widget);
 }
 
 static void
@@ -76,12 +87,20 @@ cleanup(GtkWidget *widget)
 {
     GtkWidgetProps props(widget);
     if (widget && props->treeViewHacked) {
-        removeFromHash(widget);
+        clearHovered(props);
+        connectVAdj(widget,
+                    gtk_tree_view_get_vadjustment(GTK_TREE_VIEW(widget)),
+                    false);
         props->treeViewDestroy.disconn();
         props->treeViewUnrealize.disconn();
         props->treeViewStyleSet.disconn();
         props->treeViewMotion.disconn();
         props->treeViewLeave.disconn();
+        props->treeViewSizeAllocate.disconn();
+        props->treeViewRowExpanded.disconn();
+        props->treeViewRowCollapsed.disconn();
+        props->treeViewColumnsChanged.disconn();
+        props->treeViewSetAdjustments.disconn();
         props->treeViewHacked = false;
     }
 }
@@ -106,78 +125,118 @@ samePath(GtkTreePath *a, GtkTreePath *b)
     return a ? (b && !gtk_tree_path_compare(a, b)) : !b;
 }
 
+/**
+ * Background area of the hovered cell, in bin window coordinates.
+ * Uses the cached area if it is still valid.
+ */
+static QtcRect
+hoveredRect(GtkTreeView *treeView, const GtkWidgetProps &props)
+{
+    QtcRect rect = {0, 0, -1, -1};
+    if (props->treeViewPath && props->treeViewColumn) {
+        if (props->treeViewCellValid) {
+            rect = props->treeViewCell;
+        } else {
+            gtk_tree_view_get_background_area(
+                treeView, props->treeViewPath, props->treeViewColumn,
+                (GdkRectangle*)&rect);
+        }
+    }
+    return rect;
+}
+
 static void
 updatePosition(GtkWidget *widget, int x, int y)
 {
-    if (GTK_IS_TREE_VIEW(widget)) {
-        QtCTreeView *tv = lookupHash(widget, false);
-        if (tv) {
-            GtkTreeView *treeView = GTK_TREE_VIEW(widget);
-            GtkTreePath *path = nullptr;
-            GtkTreeViewColumn *column = nullptr;
-
-            gtk_tree_view_get_path_at_pos(treeView, x, y, &path,
-                                          &column, nullptr, nullptr);
-
-            if (!samePath(tv->path, path)) {
-                // prepare update area
-                // get old rectangle
-                QtcRect oldRect = {0, 0, -1, -1 };
-                QtcRect newRect = {0, 0, -1, -1 };
-                QtcRect updateRect;
-                QtcRect alloc = Widget::getAllocation(widget);
-
-                if (tv->path && tv->column) {
-                    gtk_tree_view_get_background_area(
-                        treeView, tv->path, tv->column,
-                        (GdkRectangle*)&oldRect);
-                }
-                if (tv->fullWidth) {
-                    oldRect.x = 0;
-                    oldRect.width = alloc.width;
-                }
+    if (!GTK_IS_TREE_VIEW(widget)) {
+        return;
+    }
+    GtkWidgetProps props(widget);
+    if (!props->treeViewHacked) {
+        return;
+    }
+    // The hovered path only changes when the pointer leaves the row it is
+    // in, (the cached area is dropped when the rows move).
+    if (props->treeViewCellValid && props->treeViewCell.y <= y &&
+        props->treeViewCell.y + props->treeViewCell.height > y) {
+        return;
+    }
 
-                // get new rectangle and update position
-                if (path && column) {
-                    gtk_tree_view_get_background_area(
-                        treeView, path, column, (GdkRectangle*)&newRect);
-                }
-                if (path && column && tv->fullWidth) {
-                    newRect.x = 0;
-                    newRect.width = alloc.width;
-                }
+    GtkTreeView *treeView = GTK_TREE_VIEW(widget);
+    GtkTreePath *path = nullptr;
+    GtkTreeViewColumn *column = nullptr;
+    gtk_tree_view_get_path_at_pos(treeView, x, y, &path,
+                                  &column, nullptr, nullptr);
 
-                // take the union of both rectangles
-                if (oldRect.width > 0 && oldRect.height > 0) {
-                    if (newRect.width > 0 && newRect.height > 0) {
-                        Rect::union_(&oldRect, &newRect, &updateRect);
-                    } else {
-                        updateRect = oldRect;
-                    }
-                } else {
-                    updateRect = newRect;
-                }
+    if (samePath(props->treeViewPath, path)) {
+        if (path) {
+            gtk_tree_path_free(path);
+        }
+        if (props->treeViewPath && props->treeViewColumn) {
+            gtk_tree_view_get_background_area(
+                treeView, props->treeViewPath, props->treeViewColumn,
+                &props->treeViewCell);
+            props->treeViewCellValid = true;
+        }
+        return;
+    }
 
-                // store new cell info
-                if (tv->path)
-                    gtk_tree_path_free(tv->path);
-                tv->path = path ? gtk_tree_path_copy(path) : nullptr;
-                tv->column = column;
-
-                // convert to widget coordinates and schedule redraw
-                gtk_tree_view_convert_bin_window_to_widget_coords(
-                    treeView, updateRect.x, updateRect.y,
-                    &updateRect.x, &updateRect.y);
-                gtk_widget_queue_draw_area(
-                    widget, updateRect.x, updateRect.y,
-                    updateRect.width, updateRect.height);
-            }
+    // prepare update area
+    // get old rectangle
+    QtcRect oldRect = hoveredRect(treeView, props);
+    QtcRect newRect = {0, 0, -1, -1};
+    QtcRect updateRect;
+    QtcRect alloc = Widget::getAllocation(widget);
+
+    // get new rectangle, with uniform rows it can be derived from the old one
+    if (path && column) {
+        if (column == props->treeViewColumn && oldRect.height > 0 &&
+            gtk_tree_view_get_fixed_height_mode(treeView)) {
+            int dy = y - oldRect.y;
+            int rows = (dy >= 0 ? dy / oldRect.height :
+                        -((oldRect.height - 1 - dy) / oldRect.height));
+            newRect = oldRect;
+            newRect.y += rows * oldRect.height;
+        } else {
+            gtk_tree_view_get_background_area(treeView, path, column,
+                                              (GdkRectangle*)&newRect);
+        }
+    }
 
-            if (path) {
-                gtk_tree_path_free(path);
-            }
+    // store new cell info, the path is owned by the props from now on
+    clearHovered(props);
+    props->treeViewPath = path;
+    props->treeViewColumn = column;
+    if (path && column) {
+        props->treeViewCell = newRect;
+        props->treeViewCellValid = true;
+    }
+
+    if (props->treeViewFullWidth) {
+        oldRect.x = 0;
+        oldRect.width = alloc.width;
+        if (path && column) {
+            newRect.x = 0;
+            newRect.width = alloc.width;
         }
     }
+
+    // take the union of both rectangles
+    if (oldRect.width > 0 && oldRect.height > 0) {
+        if (newRect.width > 0 && newRect.height > 0) {
+            Rect::union_(&oldRect, &newRect, &updateRect);
+        } else {
+            updateRect = oldRect;
+        }
+    } else {
+        updateRect = newRect;
+    }
+
+    // convert to widget coordinates and schedule redraw
+    gtk_tree_view_convert_bin_window_to_widget_coords(
+        treeView, updateRect.x, updateRect.y, &updateRect.x, &updateRect.y);
+    gtk_widget_queue_draw_area(widget, updateRect.x, updateRect.y,
+                               updateRect.width, updateRect.height);
 }
 
 static gboolean
@@ -194,25 +253,17 @@ static gboolean
 leave(GtkWidget *widget, GdkEventMotion*, void*)
 {
     if (GTK_IS_TREE_VIEW(widget)) {
-        QtCTreeView *tv = lookupHash(widget, false);
-        if (tv) {
+        GtkWidgetProps props(widget);
+        if (props->treeViewHacked) {
             GtkTreeView *treeView = GTK_TREE_VIEW(widget);
-            QtcRect rect = {0, 0, -1, -1 };
+            QtcRect rect = hoveredRect(treeView, props);
             QtcRect alloc = Widget::getAllocation(widget);
 
-            if (tv->path && tv->column) {
-                gtk_tree_view_get_background_area(
-                    treeView, tv->path, tv->column, (GdkRectangle*)&rect);
-            }
-            if (tv->fullWidth) {
+            if (props->treeViewFullWidth) {
                 rect.x = 0;
                 rect.width = alloc.width;
             }
-            if (tv->path) {
-                gtk_tree_path_free(tv->path);
-            }
-            tv->path = nullptr;
-            tv->column = nullptr;
+            clearHovered(props);
 
             gtk_tree_view_convert_bin_window_to_widget_coords(
                 treeView, rect.x, rect.y, &rect.x, &rect.y);
@@ -241,30 +292,36 @@ setup(GtkWidget *widget)
 {
     GtkWidgetProps props(widget);
     if (widget && !props->treeViewHacked) {
-        QtCTreeView *tv = lookupHash(widget, true);
         GtkTreeView *treeView = GTK_TREE_VIEW(widget);
         GtkWidget *parent = gtk_widget_get_parent(widget);
 
-        if (tv) {
-            props->treeViewHacked = true;
-            int x, y;
+        props->treeViewHacked = true;
+        int x, y;
 #if GTK_CHECK_VERSION(2, 90, 0) /* Gtk3:TODO !!! */
-            tv->fullWidth = true;
+        props->treeViewFullWidth = true;
 #else
-            gtk_widget_style_get(widget, "row_ending_details",
-                                 &tv->fullWidth, nullptr);
+        gboolean fullWidth = false;
+        gtk_widget_style_get(widget, "row_ending_details",
+                             &fullWidth, nullptr);
+        props->treeViewFullWidth = fullWidth;
 #endif
-            gdk_window_get_pointer(gtk_widget_get_window(widget),
-                                   &x, &y, nullptr);
-            gtk_tree_view_convert_widget_to_bin_window_coords(treeView, x, y,
-                                                              &x, &y);
-            updatePosition(widget, x, y);
-            props->treeViewDestroy.conn("destroy-event", destroy);
-            props->treeViewUnrealize.conn("unrealize", destroy);
-            props->treeViewStyleSet.conn("style-set", styleSet);
-            props->treeViewMotion.conn("motion-notify-event", motion);
-            props->treeViewLeave.conn("leave-notify-event", leave);
-        }
+        gdk_window_get_pointer(gtk_widget_get_window(widget),
+                               &x, &y, nullptr);
+        gtk_tree_view_convert_widget_to_bin_window_coords(treeView, x, y,
+                                                          &x, &y);
+        updatePosition(widget, x, y);
+        props->treeViewDestroy.conn("destroy-event", destroy);
+        props->treeViewUnrealize.conn("unrealize", destroy);
+        props->treeViewStyleSet.conn("style-set", styleSet);
+        props->treeViewMotion.conn("motion-notify-event", motion);
+        props->treeViewLeave.conn("leave-notify-event", leave);
+        props->treeViewSizeAllocate.conn("size-allocate", geomChanged);
+        props->treeViewRowExpanded.conn("row-expanded", geomChanged);
+        props->treeViewRowCollapsed.conn("row-collapsed", geomChanged);
+        props->treeViewColumnsChanged.conn("columns-changed", geomChanged);
+        props->treeViewSetAdjustments.conn("set-scroll-adjustments",
+                                           setAdjustments);
+        connectVAdj(widget, gtk_tree_view_get_vadjustment(treeView), true);
 
         if (!gtk_tree_view_get_show_expanders(treeView))
             gtk_tree_view_set_show_expanders(treeView, true);
@@ -283,9 +340,10 @@ setup(GtkWidget *widget)
 bool
 isCellHovered(GtkWidget *widget, GtkTreePath *path, GtkTreeViewColumn *column)
 {
-    QtCTreeView *tv = lookupHash(widget, false);
-    return (tv && (tv->fullWidth || tv->column == column) &&
-            samePath(path, tv->path));
+    GtkWidgetProps props(widget);
+    return (props->treeViewHacked &&
+            (props->treeViewFullWidth || props->treeViewColumn == column) &&
+            samePath(path, props->treeViewPath));
 }
 
 bool
@@ -42,11 +42,14 @@ namespace Window {
 static GtkWidget *currentActiveWindow = nullptr;
 
 typedef struct {
+    // last configured size
     int width;
     int height;
-    int timer;
+    // size the background was last invalidated for
+    int bgndWidth;
+    int bgndHeight;
+    unsigned idle;
     GtkWidget *widget;
-    bool locked;
 } QtCWindow;
 
 static GHashTable *table = nullptr;
@@ -63,9 +66,10 @@ lookupHash(void *hash, bool create)
 
     if (!rv && create) {
         rv = qtcNew(QtCWindow);
-        rv->width = rv->height = rv->timer = 0;
+        rv->width = rv->height = 0;
+        rv->bgndWidth = rv->bgndHeight = 0;
+        rv->idle = 0;
         rv->widget = nullptr;
-        rv->locked = false;
         g_hash_table_insert(table, hash, rv);
         rv = (QtCWindow*)g_hash_table_lookup(table, hash);
     }
@@ -78,8 +82,8 @@ removeFromHash(void *hash)
     if (table) {
         QtCWindow *tv = lookupHash(hash, false);
         if (tv) {
-            if (tv->timer) {
-                g_source_remove(tv->timer);
+            if (tv->idle) {
+                g_source_remove(tv->idle);
                 g_object_unref(G_OBJECT(tv->widget));
             }
             g_hash_table_remove(table, hash);
@@ -163,58 +167,98 @@ destroy(GtkWidget *widget, GdkEvent*, void*)
     return false;
 }
 
-static bool
-sizeRequest(GtkWidget *widget)
+static void
+invalidate(GdkWindow *window, int x, int y, int width, int height)
+{
+    if (width > 0 && height > 0) {
+        QtcRect rect = {x, y, width, height};
+        gdk_window_invalidate_rect(window, (GdkRectangle*)&rect, false);
+    }
+}
+
+static void
+invalidateBgnd(GdkWindow *window, int width, int height,
+               int oldWidth, int oldHeight)
 {
-    if (widget && (!(qtcIsFlatBgnd(opts.bgndAppearance)) ||
-                   IMG_NONE != opts.bgndImage.type)) {
+    // Whether the background along each axis is independent of the window
+    // size, i.e. whether only the newly exposed strip needs a repaint.
+    bool fixedX = true;
+    bool fixedY = true;
+    if (opts.bgndAppearance == APPEARANCE_STRIPED ||
+        opts.bgndAppearance == APPEARANCE_FILE) {
+        // anchored at the top left corner
+    } else if (opts.bgndGrad == GT_HORIZ) {
+        // the shine is centred horizontally
+        fixedX = (qtcGetGradient(opts.bgndAppearance, &opts)->border !=
+                  GB_SHINE);
+        fixedY = false;
+    } else {
+        fixedX = false;
+    }
+    if ((!fixedX && width != oldWidth) || (!fixedY && height != oldHeight)) {
+        invalidate(window, 0, 0, width, height);
+    } else {
+        invalidate(window, oldWidth, 0, width - oldWidth, height);
+        invalidate(window, 0, oldHeight, qtcMin(width, oldWidth),
+                   height - oldHeight);
+    }
+}
+
+static void
+invalidateImage(GdkWindow *window, const QtcRect &alloc)
+{
+    QtcRect rect = {0, 0, 0, 0};
+    EPixPos pos = (IMG_FILE == opts.bgndImage.type ?
+                   opts.bgndImage.pos : PP_TR);
+    if (opts.bgndImage.type == IMG_FILE) {
+        qtcLoadBgndImage(&opts.bgndImage);
+    }
+    switch (pos) {
+    case PP_TL:
+        rect.width  = opts.bgndImage.width + 1;
+        rect.height = opts.bgndImage.height + 1;
+        break;
+    case PP_TM:
+    case PP_TR:
+        rect.width = alloc.width;
+        rect.height = (opts.bgndImage.type == IMG_FILE ?
+                       opts.bgndImage.height :
+                       RINGS_HEIGHT(opts.bgndImage.type)) + 1;
+        break;
+    case PP_LM:
+    case PP_BL:
+        rect.width = opts.bgndImage.width + 1;
+        rect.height = alloc.height;
+        break;
+    case PP_CENTRED:
+    case PP_BR:
+    case PP_BM:
+    case PP_RM:
+        rect.width = alloc.width;
+        rect.height = alloc.height;
+        break;
+    }
+    invalidate(window, 0, 0, qtcMin(rect.width, alloc.width),
+               qtcMin(rect.height, alloc.height));
+}
+
+static void
+sizeRequest(QtCWindow *window)
+{
+    GtkWidget *widget = window->widget;
+    GdkWindow *gdkWindow = gtk_widget_get_window(widget);
+    if (gdkWindow) {
         QtcRect alloc = Widget::getAllocation(widget);
-        QtcRect rect = {0, 0, 0, 0};
-        if (qtcIsFlat(opts.bgndAppearance) &&
-            IMG_NONE != opts.bgndImage.type) {
-            EPixPos pos = (IMG_FILE == opts.bgndImage.type ?
-                           opts.bgndImage.pos : PP_TR);
-            if (opts.bgndImage.type == IMG_FILE) {
-                qtcLoadBgndImage(&opts.bgndImage);
-            }
-            switch (pos) {
-            case PP_TL:
-                rect.width  = opts.bgndImage.width + 1;
-                rect.height = opts.bgndImage.height + 1;
-                break;
-            case PP_TM:
-            case PP_TR:
-                rect.width = alloc.width;
-                rect.height = (opts.bgndImage.type == IMG_FILE ?
-                               opts.bgndImage.height :
-                               RINGS_HEIGHT(opts.bgndImage.type)) + 1;
-                break;
-            case PP_LM:
-            case PP_BL:
-                rect.width = opts.bgndImage.width + 1;
-                rect.height = alloc.height;
-                break;
-            case PP_CENTRED:
-            case PP_BR:
-            case PP_BM:
-            case PP_RM:
-                rect.width = alloc.width;
-                rect.height = alloc.height;
-                break;
-            }
-            if (alloc.width < rect.width) {
-                rect.width = alloc.width;
-            }
-            if (alloc.height < rect.height) {
-                rect.height = alloc.height;
-            }
-        } else {
-            rect.width = alloc.width, rect.height = alloc.height;
+        if (!qtcIsFlatBgnd(opts.bgndAppearance)) {
+            invalidateBgnd(gdkWindow, window->width, window->height,
+                           window->bgndWidth, window->bgndHeight);
+        }
+        if (opts.bgndImage.type != IMG_NONE) {
+            invalidateImage(gdkWindow, alloc);
         }
-        gdk_window_invalidate_rect(gtk_widget_get_window(widget),
-                                   (GdkRectangle*)&rect, false);
     }
-    return false;
+    window->bgndWidth = window->width;
+    window->bgndHeight = window->height;
 }
 
 static gboolean
@@ -223,19 +267,11 @@ delayedUpdate(void *user_data)
     QtCWindow *window = (QtCWindow*)user_data;
 
     if (window) {
-        if (window->locked) {
-            window->locked = false;
-            return true;
-        } else {
-            g_source_remove(window->timer);
-            window->timer = 0;
-            // otherwise, trigger update
-            gdk_threads_enter();
-            sizeRequest(window->widget);
-            gdk_threads_leave();
-            g_object_unref(G_OBJECT(window->widget));
-            return false;
-        }
+        window->idle = 0;
+        gdk_threads_enter();
+        sizeRequest(window);
+        gdk_threads_leave();
+        g_object_unref(G_OBJECT(window->widget));
     }
     return false;
 }
@@ -250,14 +286,13 @@ configure(GtkWidget*, GdkEventConfigure *event, void *data)
         window->width = event->width;
         window->height = event->height;
 
-        // schedule delayed timeOut
-        if (!window->timer) {
+        // All configure events queued for this frame are dispatched before
+        // any idle source runs, so this only fires once per frame, right
+        // before Gdk processes the window updates.
+        if (!window->idle) {
             g_object_ref(G_OBJECT(window->widget));
-            window->timer =
-                g_timeout_add(50, delayedUpdate, window);
-            window->locked = false;
-        } else {
-            window->locked = true;
+            window->idle = g_idle_add_full(GDK_PRIORITY_REDRAW - 1,
+                                           delayedUpdate, window, nullptr);
         }
     }
     return false;
@@ -408,8 +443,8 @@ setup(GtkWidget *widget, int opacity)
                 QtcRect alloc = Widget::getAllocation(widget);
                 props->windowConfigure.conn("configure-event",
                                             configure, window);
-                window->width = alloc.width;
-                window->height = alloc.height;
+                window->width = window->bgndWidth = alloc.width;
+                window->height = window->bgndHeight = alloc.height;
                 window->widget = widget;
             }
         }
@@ -30,6 +30,9 @@
 #include "qt_settings.h"
 #include "tab.h"
 
+#include <vector>
+#include <unordered_map>
+
 namespace QtCurve {
 namespace WMMove {
 
@@ -105,6 +108,40 @@ trigger(GtkWidget *w, int x, int y)
     dragEnd();
 }
 
+static bool
+contains(const QtcRect &rect, int x, int y)
+{
+    return (rect.x <= x && rect.y <= y && rect.x + rect.width > x &&
+            rect.y + rect.height > y);
+}
+
+/**
+ * The area of \param widget in the coordinates of \param topLevel.
+ * For notebooks, only the tabbar rect is considered.
+ */
+static QtcRect
+widgetRect(GtkWidget *widget, GtkWidget *topLevel)
+{
+    QtcRect allocation;
+    int wx = 0;
+    int wy = 0;
+
+    // translate widget position to topLevel
+    gtk_widget_translate_coordinates(widget, topLevel, wx, wy, &wx, &wy);
+
+    if (GTK_IS_NOTEBOOK(widget)) {
+        QtcRect widgetAlloc = Widget::getAllocation(widget);
+        allocation = Tab::getTabbarRect(GTK_NOTEBOOK(widget));
+        allocation.x += wx - widgetAlloc.x;
+        allocation.y += wy - widgetAlloc.y;
+    } else {
+        allocation = Widget::getAllocation(widget);
+        allocation.x = wx;
+        allocation.y = wy;
+    }
+    return allocation;
+}
+
 static bool
 withinWidget(GtkWidget *widget, GdkEventButton *event)
 {
@@ -113,32 +150,12 @@ withinWidget(GtkWidget *widget, GdkEventButton *event)
     GdkWindow *window = topLevel ? gtk_widget_get_window(topLevel) : nullptr;
 
     if (window) {
-        QtcRect allocation;
-        int           wx=0, wy=0, nx=0, ny=0;
-
-        // translate widget position to topLevel
-        gtk_widget_translate_coordinates(widget, topLevel, wx, wy, &wx, &wy);
-
+        int nx = 0;
+        int ny = 0;
         // translate to absolute coordinates
         gdk_window_get_origin(window, &nx, &ny);
-        wx += nx;
-        wy += ny;
-
-        // get widget size.
-        // for notebooks, only consider the tabbar rect
-        if (GTK_IS_NOTEBOOK(widget)) {
-            QtcRect widgetAlloc = Widget::getAllocation(widget);
-            allocation = Tab::getTabbarRect(GTK_NOTEBOOK(widget));
-            allocation.x += wx - widgetAlloc.x;
-            allocation.y += wy - widgetAlloc.y;
-        } else {
-            allocation = Widget::getAllocation(widget);
-            allocation.x = wx;
-            allocation.y = wy;
-        }
-
-        return allocation.x<=event->x_root && allocation.y<=event->y_root &&
-            (allocation.x+allocation.width)>event->x_root && (allocation.y+allocation.height)>event->y_root;
+        return contains(widgetRect(widget, topLevel),
+                        event->x_root - nx, event->y_root - ny);
     }
     return true;
 }
@@ -218,6 +235,168 @@ childrenUseEvent(GtkWidget *widget, GdkEventButton *event, bool inNoteBook)
     return usable;
 }
 
+/**
+ * The descendants of a drag widget, flattened in the order childrenUseEvent()
+ * visits them. Positions and types only change with a size-allocate or a
+ * hierarchy change of the drag widget, so they are cached until then and a
+ * button press only has to check the state of the widgets under the pointer.
+ * Scrolled windows, viewports and layouts can move their children without a
+ * size-allocate, so their content is still checked with childrenUseEvent().
+ */
+struct HitEntry {
+    enum Kind {
+        Plain,
+        Block,
+        Button,
+        Scrolled,
+        Scrollable
+    };
+    GtkWidget *widget;
+    // in the coordinates of the toplevel
+    QtcRect rect;
+    // the first entry after the subtree of this one
+    size_t next;
+    Kind kind;
+    bool inNoteBook;
+};
+
+class HitIndex: public std::vector<HitEntry> {
+    HitIndex(const HitIndex&) = delete;
+public:
+    HitIndex() = default;
+    HitIndex(HitIndex&&) = default;
+    ~HitIndex()
+    {
+        for (auto &entry: *this) {
+            g_object_unref(entry.widget);
+        }
+    }
+};
+
+static std::unordered_map<GtkWidget*, HitIndex> hitIndices;
+
+static HitEntry::Kind
+hitKind(GtkWidget *parent, GtkWidget *widget)
+{
+    if (isBlackListed(G_OBJECT(widget)) ||
+        (GTK_IS_NOTEBOOK(parent) && Tab::isLabel(GTK_NOTEBOOK(parent),
+                                                 widget)) ||
+        (gtk_widget_get_events(widget) &
+         (GDK_BUTTON_PRESS_MASK | GDK_BUTTON_RELEASE_MASK)) ||
+        GTK_IS_MENU_ITEM(widget)) {
+        return HitEntry::Block;
+    } else if (GTK_IS_BUTTON(widget)) {
+        return HitEntry::Button;
+    } else if (GTK_IS_SCROLLED_WINDOW(widget)) {
+        return HitEntry::Scrolled;
+    } else if (GTK_IS_VIEWPORT(widget) || GTK_IS_LAYOUT(widget)) {
+        return HitEntry::Scrollable;
+    }
+    return HitEntry::Plain;
+}
+
+static void
+buildHitIndex(HitIndex &index, GtkWidget *widget, GtkWidget *topLevel,
+              bool inNoteBook)
+{
+    GList *children = gtk_container_get_children(GTK_CONTAINER(widget));
+    for (GList *child = children;child;child = g_list_next(child)) {
+        if (!GTK_IS_WIDGET(child->data)) {
+            continue;
+        }
+        GtkWidget *childWidget = GTK_WIDGET(child->data);
+        GdkWindow *window = gtk_widget_get_window(childWidget);
+        if (GTK_IS_NOTEBOOK(childWidget) && window &&
+            gdk_window_is_visible(window)) {
+            inNoteBook = true;
+        }
+        HitEntry::Kind kind = hitKind(widget, childWidget);
+        size_t pos = index.size();
+        g_object_ref(childWidget);
+        index.push_back(HitEntry{childWidget, widgetRect(childWidget, topLevel),
+                                 0, kind, inNoteBook});
+        if ((kind == HitEntry::Plain || kind == HitEntry::Button) &&
+            GTK_IS_CONTAINER(childWidget)) {
+            buildHitIndex(index, childWidget, topLevel, inNoteBook);
+        }
+        index[pos].next = index.size();
+    }
+    if (children) {
+        g_list_free(children);
+    }
+}
+
+static const HitIndex&
+getHitIndex(GtkWidget *widget, GtkWidget *topLevel)
+{
+    auto it = hitIndices.find(widget);
+    if (it == hitIndices.end()) {
+        it = hitIndices.emplace(widget, HitIndex()).first;
+        buildHitIndex(it->second, widget, topLevel, false);
+    }
+    return it->second;
+}
+
+static void
+invalidateHitIndex(GtkWidget *widget)
+{
+    hitIndices.erase(widget);
+}
+
+static bool
+indexUseEvent(GtkWidget *widget, GdkEventButton *event)
+{
+    GtkWidget *topLevel = gtk_widget_get_toplevel(widget);
+    GdkWindow *topWindow = topLevel ? gtk_widget_get_window(topLevel) : nullptr;
+    if (!topWindow) {
+        return childrenUseEvent(widget, event, false);
+    }
+    int x = 0;
+    int y = 0;
+    gdk_window_get_origin(topWindow, &x, &y);
+    x = event->x_root - x;
+    y = event->y_root - y;
+
+    const HitIndex &index = getHitIndex(widget, topLevel);
+    for (size_t i = 0;i < index.size();) {
+        const HitEntry &entry = index[i];
+        GtkWidget *childWidget = entry.widget;
+        // any prelight widget indicate we can't do a move
+        if (gtk_widget_get_state(childWidget) == GTK_STATE_PRELIGHT) {
+            return false;
+        }
+        GdkWindow *window = gtk_widget_get_window(childWidget);
+        if (!(window && gdk_window_is_visible(window)) ||
+            !contains(entry.rect, x, y)) {
+            i = entry.next;
+            continue;
+        }
+        switch (entry.kind) {
+        case HitEntry::Block:
+            return false;
+        case HitEntry::Button:
+            if (gtk_widget_get_state(childWidget) != GTK_STATE_INSENSITIVE) {
+                return false;
+            }
+            break;
+        case HitEntry::Scrolled:
+            if (!entry.inNoteBook || gtk_widget_is_focus(childWidget)) {
+                return false;
+            }
+            QTC_FALLTHROUGH();
+        case HitEntry::Scrollable:
+            if (!childrenUseEvent(childWidget, event, entry.inNoteBook)) {
+                return false;
+            }
+            break;
+        default:
+            break;
+        }
+        i++;
+    }
+    return true;
+}
+
 static bool
 useEvent(GtkWidget *widget, GdkEventButton *event)
 {
@@ -231,9 +410,9 @@ useEvent(GtkWidget *widget, GdkEventButton *event)
     if (GTK_IS_NOTEBOOK(widget)) {
         return (!Tab::hasVisibleArrows(GTK_NOTEBOOK(widget)) &&
                 Tab::currentHoveredIndex(widget) == -1 &&
-                childrenUseEvent(widget, event, false));
+                indexUseEvent(widget, event));
     } else {
-        return childrenUseEvent(widget, event, false);
+        return indexUseEvent(widget, event);
     }
 }
 
@@ -299,7 +478,10 @@ static void cleanup(GtkWidget *widget)
         props->wmMoveMotion.disconn();
         props->wmMoveLeave.disconn();
         props->wmMoveButtonPress.disconn();
+        props->wmMoveSizeAllocate.disconn();
+        props->wmMoveHierarchyChanged.disconn();
         props->wmMoveHacked = false;
+        invalidateHitIndex(widget);
     }
 }
 
@@ -317,6 +499,18 @@ destroy(GtkWidget *widget, GdkEvent*, void*)
     return false;
 }
 
+static void
+sizeAllocate(GtkWidget *widget, GdkRectangle*, void*)
+{
+    invalidateHitIndex(widget);
+}
+
+static void
+hierarchyChanged(GtkWidget *widget, GtkWidget*, void*)
+{
+    invalidateHitIndex(widget);
+}
+
 static gboolean
 motion(GtkWidget *widget, GdkEventMotion *event, void*)
 {
@@ -387,6 +581,9 @@ setup(GtkWidget *widget)
         props->wmMoveMotion.conn("motion-notify-event", motion);
         props->wmMoveLeave.conn("leave-notify-event", leave);
         props->wmMoveButtonPress.conn("button-press-event", buttonPress);
+        props->wmMoveSizeAllocate.conn("size-allocate", sizeAllocate);
+        props->wmMoveHierarchyChanged.conn("hierarchy-changed",
+                                           hierarchyChanged);
     }
 }
 
@@ -22,6 +22,20 @@
 
 #include "color.h"
 
+QTC_EXPORT double qtc_hcy_gamma[QTC_HCY_LUT_SIZE + 1];
+QTC_EXPORT double qtc_hcy_igamma[QTC_HCY_LUT_SIZE + 1];
+
+static struct HCYTables {
+    HCYTables()
+    {
+        for (int i = 0;i <= QTC_HCY_LUT_SIZE;i++) {
+            double x = double(i) / QTC_HCY_LUT_SIZE;
+            qtc_hcy_gamma[i] = pow(x, 2.2);
+            qtc_hcy_igamma[i] = pow(x, 1.0 / 2.2);
+        }
+    }
+} hcyTables;
+
 static void
 qtcColorHCYFromColor(const QtcColor *color, QtcColorHCY *hcy)
 {
@@ -127,14 +141,26 @@ qtcColorContrastRatio(const QtcColor *c1, const QtcColor *c2)
     }
 }
 
+static inline void
+qtcColorHCYLighten(QtcColorHCY *hcy, double ky, double kc)
+{
+    hcy->y = 1.0 - qtcBound(0, (1.0 - hcy->y) * (1.0 - ky), 1);
+    hcy->c = 1.0 - qtcBound(0, (1.0 - hcy->c) * kc, 1);
+}
+
+static inline void
+qtcColorHCYDarken(QtcColorHCY *hcy, double ky, double kc)
+{
+    hcy->y = qtcBound(0, hcy->y * (1.0 - ky), 1);
+    hcy->c = qtcBound(0, hcy->c * kc, 1);
+}
+
 QTC_EXPORT void
 _qtcColorLighten(QtcColor *color, double ky, double kc)
 {
     QtcColorHCY hcy;
     qtcColorHCYFromColor(color, &hcy);
-
-    hcy.y = 1.0 - qtcBound(0, (1.0 - hcy.y) * (1.0 - ky), 1);
-    hcy.c = 1.0 - qtcBound(0, (1.0 - hcy.c) * kc, 1);
+    qtcColorHCYLighten(&hcy, ky, kc);
     qtcColorHCYToColor(&hcy, color);
 }
 
@@ -143,9 +169,7 @@ _qtcColorDarken(QtcColor *color, double ky, double kc)
 {
     QtcColorHCY hcy;
     qtcColorHCYFromColor(color, &hcy);
-
-    hcy.y = qtcBound(0, hcy.y * (1.0 - ky), 1);
-    hcy.c = qtcBound(0, hcy.c * kc, 1);
+    qtcColorHCYDarken(&hcy, ky, kc);
     qtcColorHCYToColor(&hcy, color);
 }
 
@@ -293,62 +317,88 @@ hslToRgb(double h, double s, double l, double *r, double *g, double *b)
 QTC_EXPORT void
 _qtcShade(const QtcColor *ca, QtcColor *cb, double k, Shading shading)
 {
-    // Should be handled already by the wrapper inline functions.
-    if (qtcUnlikely(qtcEqual(k, 1.0))) {
-        *cb = *ca;
-        return;
+    _qtcShadeN(ca, &k, cb, 1, shading);
+}
+
+// The color is converted to the color space of the shading only once, the
+// result for each factor is the same as that of _qtcShade. \param cb may
+// overlap \param ca.
+QTC_EXPORT void
+_qtcShadeN(const QtcColor *ca, const double *k, QtcColor *cb, int n,
+           Shading shading)
+{
+#define HCY_FACTOR 0.15
+    const QtcColor orig = *ca;
+    ca = &orig;
+#define SKIP_ORIG(i)                            \
+    if (qtcUnlikely(qtcEqual(k[i], 1.0))) {     \
+        cb[i] = orig;                           \
+        continue;                               \
     }
     switch (shading) {
-    case Shading::Simple: {
-        double v = k - 1;
-        qtcColorFill(cb, qtcLimit(ca->red + v, 1.0),
-                     qtcLimit(ca->green + v, 1.0),
-                     qtcLimit(ca->blue + v, 1.0));
+    case Shading::Simple:
+        for (int i = 0;i < n;i++) {
+            SKIP_ORIG(i);
+            double v = k[i] - 1;
+            qtcColorFill(&cb[i], qtcLimit(ca->red + v, 1.0),
+                         qtcLimit(ca->green + v, 1.0),
+                         qtcLimit(ca->blue + v, 1.0));
+        }
         break;
-    }
     case Shading::HSL: {
-        double r = ca->red;
-        double g = ca->green;
-        double b = ca->blue;
         double h, s, l;
-
-        rgbToHsl(r, g, b, &h, &s, &l);
-        l = qtcBound(0, l * k, 1);
-        s = qtcBound(0, s * k, 1);
-        hslToRgb(h, s, l, &r, &g, &b);
-        qtcColorFill(cb, qtcLimit(r, 1.0), qtcLimit(g, 1.0),
-                     qtcLimit(b, 1.0));
+        rgbToHsl(ca->red, ca->green, ca->blue, &h, &s, &l);
+        for (int i = 0;i < n;i++) {
+            SKIP_ORIG(i);
+            double r, g, b;
+            hslToRgb(h, qtcBound(0, s * k[i], 1), qtcBound(0, l * k[i], 1),
+                     &r, &g, &b);
+            qtcColorFill(&cb[i], qtcLimit(r, 1.0), qtcLimit(g, 1.0),
+                         qtcLimit(b, 1.0));
+        }
         break;
     }
     case Shading::HSV: {
-        double r = ca->red;
-        double g = ca->green;
-        double b = ca->blue;
         double h, s, v;
-
-        qtcRgbToHsv(r, g, b, &h, &s, &v);
-        v *= k;
-        if (v > 1.0) {
-            s -= v - 1.0;
-            if (s < 0) {
-                s = 0;
+        qtcRgbToHsv(ca->red, ca->green, ca->blue, &h, &s, &v);
+        for (int i = 0;i < n;i++) {
+            SKIP_ORIG(i);
+            double si = s;
+            double vi = v * k[i];
+            if (vi > 1.0) {
+                si -= vi - 1.0;
+                if (si < 0) {
+                    si = 0;
+                }
+                vi = 1.0;
             }
-            v = 1.0;
+            double r, g, b;
+            qtcHsvToRgb(&r, &g, &b, h, si, vi);
+            qtcColorFill(&cb[i], qtcLimit(r, 1.0), qtcLimit(g, 1.0),
+                         qtcLimit(b, 1.0));
         }
-        qtcHsvToRgb(&r, &g, &b, h, s, v);
-        qtcColorFill(cb, qtcLimit(r, 1.0), qtcLimit(g, 1.0),
-                     qtcLimit(b, 1.0));
         break;
     }
-    case Shading::HCY:
-#define HCY_FACTOR 0.15
-        *cb = *ca;
-        if (k > 1) {
-            _qtcColorLighten(cb, (k * (1 + HCY_FACTOR)) - 1.0, 1.0);
-        } else {
-            _qtcColorDarken(cb, 1.0 - (k * (1 - HCY_FACTOR)), 1.0);
+    case Shading::HCY: {
+        QtcColorHCY hcy;
+        qtcColorHCYFromColor(ca, &hcy);
+        for (int i = 0;i < n;i++) {
+            SKIP_ORIG(i);
+            QtcColorHCY shaded = hcy;
+            if (k[i] > 1) {
+                qtcColorHCYLighten(&shaded, (k[i] * (1 + HCY_FACTOR)) - 1.0,
+                                   1.0);
+            } else {
+                qtcColorHCYDarken(&shaded, 1.0 - (k[i] * (1 - HCY_FACTOR)),
+                                  1.0);
+            }
+            qtcColorHCYToColor(&shaded, &cb[i]);
         }
+        break;
+    }
     }
+#undef SKIP_ORIG
+#undef HCY_FACTOR
 }
 
 QTC_EXPORT double
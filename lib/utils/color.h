@@ -67,16 +67,40 @@ qtcColorMixF(double a, double b, double bias)
     return a + (b - a) * bias;
 }
 
+/**
+ * Tables of x^2.2 and x^(1 / 2.2) at x = i / QTC_HCY_LUT_SIZE, filled when
+ * the library is loaded. Values in between are interpolated linearly.
+ */
+#define QTC_HCY_LUT_SIZE (1024)
+extern double qtc_hcy_gamma[QTC_HCY_LUT_SIZE + 1];
+extern double qtc_hcy_igamma[QTC_HCY_LUT_SIZE + 1];
+
+QTC_ALWAYS_INLINE static inline double
+_qtcColorHCYLookup(const double *lut, double n)
+{
+    double f = qtcBound(0, n, 1) * QTC_HCY_LUT_SIZE;
+    // Also catches NaN
+    if (qtcUnlikely(!(f < QTC_HCY_LUT_SIZE))) {
+        return lut[QTC_HCY_LUT_SIZE];
+    }
+    int i = (int)f;
+    return lut[i] + (lut[i + 1] - lut[i]) * (f - i);
+}
+
 QTC_ALWAYS_INLINE static inline double
 qtcColorHCYGamma(double n)
 {
-    return pow(qtcBound(0, n, 1), 2.2);
+    return _qtcColorHCYLookup(qtc_hcy_gamma, n);
 }
 
 QTC_ALWAYS_INLINE static inline double
 qtcColorHCYIGamma(double n)
 {
-    return pow(qtcBound(0, n, 1), 1.0 / 2.2);
+    // Too steep close to 0 for the interpolation to be accurate.
+    if (n < 1.0 / 32) {
+        return pow(qtcMax(n, 0), 1.0 / 2.2);
+    }
+    return _qtcColorHCYLookup(qtc_hcy_igamma, n);
 }
 
 QTC_ALWAYS_INLINE static inline double
@@ -190,6 +214,12 @@ void _qtcColorTint(const QtcColor *base, const QtcColor *col,
 void _qtcColorMix(const QtcColor *c1, const QtcColor *c2,
                   double bias, QtcColor *out);
 void _qtcShade(const QtcColor *ca, QtcColor *cb, double k, Shading shading);
+/**
+ * Shade \param ca by each of the \param n factors in \param k into
+ * \param cb, this is faster than calling _qtcShade() \param n times.
+ */
+void _qtcShadeN(const QtcColor *ca, const double *k, QtcColor *cb, int n,
+                Shading shading);
 double _qtcShineAlpha(const QtcColor *bgnd);
 void _qtcCalcRingAlphas(const QtcColor *bgnd);
 void qtcColorFromStr(QtcColor *color, const char *str);
@@ -295,6 +325,26 @@ qtcShade(const QColor *ca, QColor *cb, double k, Shading shading)
     cb->setRgbF(qtc_cb.red, qtc_cb.green, qtc_cb.blue, ca->alphaF());
 }
 
+QTC_ALWAYS_INLINE static inline void
+qtcShadeN(const QColor *ca, const double *k, QColor *cb, int n,
+          Shading shading)
+{
+    const QtcColor qtc_ca = {ca->redF(), ca->greenF(), ca->blueF()};
+    QtcColor qtc_cb[16];
+    for (int i = 0;i < n;i += 16) {
+        int m = qtcMin(n - i, 16);
+        _qtcShadeN(&qtc_ca, k + i, qtc_cb, m, shading);
+        for (int j = 0;j < m;j++) {
+            if (qtcEqual(k[i + j], 1.0)) {
+                cb[i + j] = *ca;
+            } else {
+                cb[i + j].setRgbF(qtc_cb[j].red, qtc_cb[j].green,
+                                  qtc_cb[j].blue, ca->alphaF());
+            }
+        }
+    }
+}
+
 QTC_ALWAYS_INLINE static inline double
 qtcShineAlpha(const QColor *bgnd)
 {
@@ -411,6 +461,22 @@ qtcShade(const GdkColor *ca, GdkColor *cb, double k, Shading shading)
     *cb = _qtcColorToGdk(&qtc_cb);
 }
 
+QTC_ALWAYS_INLINE static inline void
+qtcShadeN(const GdkColor *ca, const double *k, GdkColor *cb, int n,
+          Shading shading)
+{
+    QtcColor qtc_ca = _qtc_color_from_gdk(ca);
+    QtcColor qtc_cb[16];
+    for (int i = 0;i < n;i += 16) {
+        int m = qtcMin(n - i, 16);
+        _qtcShadeN(&qtc_ca, k + i, qtc_cb, m, shading);
+        for (int j = 0;j < m;j++) {
+            cb[i + j] = (qtcEqual(k[i + j], 1.0) ? *ca :
+                         _qtcColorToGdk(&qtc_cb[j]));
+        }
+    }
+}
+
 QTC_ALWAYS_INLINE static inline double
 qtcShineAlpha(const GdkColor *bgnd)
 {
@@ -92,6 +92,8 @@ class GtkWidgetProps {
         bool comboBoxHacked: 1;
         bool tabChildHacked: 1;
         bool treeViewHacked: 1;
+        bool treeViewFullWidth: 1;
+        bool treeViewCellValid: 1;
         bool menuShellHacked: 1;
         bool scrollBarHacked: 1;
         bool buttonOrderHacked: 1;
@@ -101,6 +103,11 @@ class GtkWidgetProps {
 
         unsigned short windowOpacity;
 
+        // hovered cell and its background area in bin window coordinates
+        GtkTreePath *treeViewPath;
+        GtkTreeViewColumn *treeViewColumn;
+        GdkRectangle treeViewCell;
+
         int widgetMask;
         DEF_WIDGET_SIG_CONN_PROPS(shadowDestroy);
 
@@ -144,24 +151,37 @@ class GtkWidgetProps {
         DEF_WIDGET_SIG_CONN_PROPS(tabMotion);
         DEF_WIDGET_SIG_CONN_PROPS(tabLeave);
         DEF_WIDGET_SIG_CONN_PROPS(tabPageAdded);
+        DEF_WIDGET_SIG_CONN_PROPS(tabPageRemoved);
+        DEF_WIDGET_SIG_CONN_PROPS(tabPageReordered);
+        DEF_WIDGET_SIG_CONN_PROPS(tabSwitchPage);
+        DEF_WIDGET_SIG_CONN_PROPS(tabSizeAllocate);
 
         DEF_WIDGET_SIG_CONN_PROPS(tabChildDestroy);
         DEF_WIDGET_SIG_CONN_PROPS(tabChildStyleSet);
         DEF_WIDGET_SIG_CONN_PROPS(tabChildEnter);
         DEF_WIDGET_SIG_CONN_PROPS(tabChildLeave);
         DEF_WIDGET_SIG_CONN_PROPS(tabChildAdd);
+        DEF_WIDGET_SIG_CONN_PROPS(tabChildMap);
+        DEF_WIDGET_SIG_CONN_PROPS(tabChildUnmap);
 
         DEF_WIDGET_SIG_CONN_PROPS(wmMoveDestroy);
         DEF_WIDGET_SIG_CONN_PROPS(wmMoveStyleSet);
         DEF_WIDGET_SIG_CONN_PROPS(wmMoveMotion);
         DEF_WIDGET_SIG_CONN_PROPS(wmMoveLeave);
         DEF_WIDGET_SIG_CONN_PROPS(wmMoveButtonPress);
+        DEF_WIDGET_SIG_CONN_PROPS(wmMoveSizeAllocate);
+        DEF_WIDGET_SIG_CONN_PROPS(wmMoveHierarchyChanged);
 
         DEF_WIDGET_SIG_CONN_PROPS(treeViewDestroy);
         DEF_WIDGET_SIG_CONN_PROPS(treeViewUnrealize);
         DEF_WIDGET_SIG_CONN_PROPS(treeViewStyleSet);
         DEF_WIDGET_SIG_CONN_PROPS(treeViewMotion);
         DEF_WIDGET_SIG_CONN_PROPS(treeViewLeave);
+        DEF_WIDGET_SIG_CONN_PROPS(treeViewSizeAllocate);
+        DEF_WIDGET_SIG_CONN_PROPS(treeViewRowExpanded);
+        DEF_WIDGET_SIG_CONN_PROPS(treeViewRowCollapsed);
+        DEF_WIDGET_SIG_CONN_PROPS(treeViewColumnsChanged);
+        DEF_WIDGET_SIG_CONN_PROPS(treeViewSetAdjustments);
 
         DEF_WIDGET_SIG_CONN_PROPS(widgetMapDestroy);
         DEF_WIDGET_SIG_CONN_PROPS(widgetMapUnrealize);
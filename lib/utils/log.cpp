@@ -23,8 +23,18 @@
 #include "log.h"
 #include "strs.h"
 #include "map.h"
+#include "number.h"
 #include <unistd.h>
 #include <stdarg.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #ifdef QTC_ENABLE_BACKTRACE
 #include <execinfo.h>
@@ -52,13 +62,13 @@ level()
         if (Str::convert(env_debug, false)) {
             return LogLevel::Debug;
         }
-        static const StrMap<LogLevel, false> level_map{
+        static constexpr auto level_map = makeStaticStrMap<LogLevel, false>({
             {"debug", LogLevel::Debug},
             {"info", LogLevel::Info},
             {"warning", LogLevel::Warn},
             {"warn", LogLevel::Warn},
             {"error", LogLevel::Error}
-        };
+        });
         LogLevel res = level_map.search(getenv("QTCURVE_LEVEL"),
                                         LogLevel::Error);
         if (Str::convert(env_debug, true) && res <= LogLevel::Debug) {
@@ -69,30 +79,286 @@ level()
     return _level;
 }
 
-static bool
-useColor()
+namespace {
+
+struct Output {
+    int fd;
+    bool color;
+    bool async;
+    // messages per second allowed from each call site, 0 for no limit.
+    unsigned long rate;
+};
+
+static const Output&
+output()
 {
-    static bool color = [] () -> bool {
+    static const Output out = [] {
+        Output out;
+        out.fd = STDERR_FILENO;
+        const char *file = getenv("QTCURVE_LOG_FILE");
+        if (file && *file) {
+            int fd = open(file, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+                          0644);
+            if (fd >= 0) {
+                out.fd = fd;
+            }
+        }
         const char *env_color = getenv("QTCURVE_LOG_COLOR");
         if (Str::convert(env_color, false)) {
-            return true;
+            out.color = true;
         } else if (!Str::convert(env_color, true)) {
-            return false;
-        } else if (isatty(2)) {
-            return true;
+            out.color = false;
         } else {
+            out.color = isatty(out.fd);
+        }
+        out.async = Str::convert(getenv("QTCURVE_LOG_ASYNC"), false);
+        long rate = Str::convert(getenv("QTCURVE_LOG_RATE"), 0l);
+        out.rate = rate > 0 ? rate : 0;
+        return out;
+    }();
+    return out;
+}
+
+static void
+writeAll(int fd, const char *buff, size_t len)
+{
+    while (len > 0) {
+        ssize_t res = write(fd, buff, len);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        buff += res;
+        len -= res;
+    }
+}
+
+static uint32_t
+monotonicSeconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)ts.tv_sec;
+}
+
+/**
+ * Per call site message budget. Sites are identified by file and line and
+ * hashed into a fixed table, a collision only makes two sites share (and
+ * reset) one budget so no locking is needed.
+ */
+class RateLimit {
+    struct Site {
+        std::atomic<uintptr_t> key;
+        std::atomic<uint32_t> second;
+        std::atomic<uint32_t> count;
+        std::atomic<uint32_t> dropped;
+    };
+    static constexpr size_t NSites = 256;
+    Site m_sites[NSites];
+public:
+    // Whether a message from this site may go through now, if so, dropped
+    // is the number of messages suppressed since the last one that did.
+    bool
+    allow(const char *fname, int line, unsigned long rate, uint32_t *dropped)
+    {
+        const uintptr_t key = (uintptr_t)fname * 31 + line;
+        Site &site = m_sites[(key ^ (key >> 12)) % NSites];
+        const uint32_t now = monotonicSeconds();
+        if (site.key.load(std::memory_order_relaxed) != key) {
+            site.key.store(key, std::memory_order_relaxed);
+            site.second.store(now, std::memory_order_relaxed);
+            site.count.store(0, std::memory_order_relaxed);
+            site.dropped.store(0, std::memory_order_relaxed);
+        } else if (site.second.load(std::memory_order_relaxed) != now) {
+            site.second.store(now, std::memory_order_relaxed);
+            site.count.store(0, std::memory_order_relaxed);
+        }
+        if (site.count.fetch_add(1, std::memory_order_relaxed) >= rate) {
+            site.dropped.fetch_add(1, std::memory_order_relaxed);
             return false;
         }
+        *dropped = site.dropped.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+};
+
+/**
+ * Bounded lock-free queue of formatted messages (the sequence number scheme
+ * of Dmitry Vyukov's bounded MPMC queue) drained by a background thread.
+ * Producers never block, messages are dropped and counted when the queue
+ * is full.
+ */
+class AsyncWriter {
+public:
+    static constexpr size_t RecordSize = 496;
+private:
+    struct Record {
+        std::atomic<size_t> seq;
+        size_t len;
+        char data[RecordSize];
+    };
+    static constexpr size_t NRecords = 1024;
+    Record m_records[NRecords];
+    std::atomic<size_t> m_head;
+    // only touched by the writer thread
+    size_t m_tail;
+    std::atomic<size_t> m_dropped;
+    std::atomic<bool> m_sleeping;
+    std::atomic<bool> m_quit;
+    std::mutex m_lock;
+    std::condition_variable m_cond;
+    const int m_fd;
+    const pid_t m_pid;
+    std::thread m_thread;
+
+    void
+    run()
+    {
+        char buff[16384];
+        // Keep room for the dropped messages notice after a full batch.
+        static constexpr size_t NoticeSize = 64;
+        while (true) {
+            size_t len = 0;
+            while (len + RecordSize + NoticeSize <= sizeof(buff)) {
+                Record &rec = m_records[m_tail % NRecords];
+                if (rec.seq.load(std::memory_order_acquire) != m_tail + 1) {
+                    break;
+                }
+                memcpy(buff + len, rec.data, rec.len);
+                len += rec.len;
+                rec.seq.store(m_tail + NRecords, std::memory_order_release);
+                m_tail++;
+            }
+            if (size_t dropped = m_dropped.exchange(0)) {
+                int res = snprintf(buff + len, sizeof(buff) - len,
+                                   "qtcLog-%d %zu messages dropped\n",
+                                   (int)m_pid, dropped);
+                if (res > 0) {
+                    len += qtcMin((size_t)res, sizeof(buff) - len - 1);
+                }
+            }
+            if (len) {
+                writeAll(m_fd, buff, len);
+                continue;
+            }
+            if (m_quit.load()) {
+                break;
+            }
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_sleeping.store(true);
+            // A message published right before m_sleeping is set does not
+            // wake us up, the timeout bounds the delay in that case.
+            m_cond.wait_for(lock, std::chrono::milliseconds(100));
+            m_sleeping.store(false);
+        }
+    }
+public:
+    AsyncWriter(int fd)
+        : m_head(0),
+          m_tail(0),
+          m_dropped(0),
+          m_sleeping(false),
+          m_quit(false),
+          m_fd(fd),
+          m_pid(getpid())
+    {
+        for (size_t i = 0;i < NRecords;i++) {
+            m_records[i].seq.store(i, std::memory_order_relaxed);
+        }
+        m_thread = std::thread([this] {run();});
+    }
+    // The thread does not survive fork(), the child has to write directly,
+    // same for anything logged after the exit handler has run.
+    bool
+    usable() const
+    {
+        return !m_quit.load(std::memory_order_relaxed) && getpid() == m_pid;
+    }
+    // Returns a record to fill and publish() or nullptr if the queue is full.
+    char*
+    claim(size_t *pos)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        while (true) {
+            Record &rec = m_records[head % NRecords];
+            size_t seq = rec.seq.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)head;
+            if (diff == 0) {
+                if (m_head.compare_exchange_weak(head, head + 1,
+                                                 std::memory_order_relaxed)) {
+                    *pos = head;
+                    return rec.data;
+                }
+            } else if (diff < 0) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            } else {
+                head = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    void
+    publish(size_t pos, size_t len)
+    {
+        Record &rec = m_records[pos % NRecords];
+        rec.len = len;
+        rec.seq.store(pos + 1, std::memory_order_release);
+        if (m_sleeping.load()) {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_cond.notify_one();
+        }
+    }
+    void
+    stop()
+    {
+        m_quit.store(true);
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_cond.notify_one();
+        }
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+};
+
+static AsyncWriter *async_writer = nullptr;
+
+static AsyncWriter*
+asyncWriter()
+{
+    static bool inited = [] {
+        if (output().async) {
+            async_writer = new AsyncWriter(output().fd);
+            // flush whatever is still queued on exit.
+            atexit([] {
+                    if (async_writer->usable()) {
+                        async_writer->stop();
+                    }
+                });
+        }
+        return true;
     }();
-    return color;
+    QTC_UNUSED(inited);
+    if (async_writer && async_writer->usable()) {
+        return async_writer;
+    }
+    return nullptr;
 }
 
-QTC_EXPORT void
-logv(LogLevel _level, const char *fname, int line, const char *func,
-     const char *fmt, va_list ap)
+/**
+ * Formats a complete message into buff and returns its full length, which
+ * may be larger than size in which case the output is truncated to a
+ * complete line.
+ */
+__attribute__((format(printf, 8, 0)))
+static size_t
+formatMessage(char *buff, size_t size, LogLevel _level, uint32_t dropped,
+              const char *fname, int line, const char *func,
+              const char *fmt, va_list ap)
 {
-    QTC_RET_IF_FAIL(_level >= level() && ((int)_level) >= 0 &&
-                    _level <= LogLevel::Force);
     static const char *color_codes[] = {
         [(int)LogLevel::Debug] = "\e[01;32m",
         [(int)LogLevel::Info] = "\e[01;34m",
@@ -109,15 +375,81 @@ logv(LogLevel _level, const char *fname, int line, const char *func,
         [(int)LogLevel::Force] = "qtcLog-",
     };
 
-    const char *color_prefix = (useColor() ? color_codes[(int)_level] : "");
+    const bool color = output().color;
+    const char *color_prefix = (color ? color_codes[(int)_level] : "");
+    const char *color_suffix = (color ? "\e[0m" : "");
     const char *log_prefix = log_prefixes[(int)_level];
+    // Room kept at the end of a truncated message for the color reset and
+    // the newline, so that it does not change the color of what follows.
+    const size_t tail = strlen(color_suffix) + 1;
+
+    size_t len = 0;
+    auto append = [&] (int res) {
+        if (res > 0) {
+            len += res;
+        }
+    };
+    auto remain = [&] {
+        return size - qtcMin(len, size);
+    };
+    append(snprintf(buff, size, "%s%s%d (%s:%d) %s ", color_prefix,
+                    log_prefix, getpid(), fname, line, func));
+    if (dropped) {
+        append(snprintf(buff + size - remain(), remain(),
+                        "(%u similar messages suppressed) ", dropped));
+    }
+    append(vsnprintf(buff + size - remain(), remain(), fmt, ap));
+    append(snprintf(buff + size - remain(), remain(), "%s", color_suffix));
+    if (len >= size && size > tail) {
+        snprintf(buff + size - tail - 1, tail + 1, "%s\n", color_suffix);
+    }
+    return len;
+}
+
+}
 
-    fprintf(stderr, "%s%s%d (%s:%d) %s ", color_prefix, log_prefix, getpid(),
-            fname, line, func);
-    vfprintf(stderr, fmt, ap);
-    if (useColor()) {
-        fwrite("\e[0m", strlen("\e[0m"), 1, stderr);
+QTC_EXPORT void
+logv(LogLevel _level, const char *fname, int line, const char *func,
+     const char *fmt, va_list ap)
+{
+    QTC_RET_IF_FAIL(_level >= level() && ((int)_level) >= 0 &&
+                    _level <= LogLevel::Force);
+    const Output &out = output();
+    uint32_t dropped = 0;
+    if (out.rate) {
+        static RateLimit limit;
+        if (!limit.allow(fname, line, out.rate, &dropped)) {
+            return;
+        }
+    }
+    if (AsyncWriter *writer = asyncWriter()) {
+        size_t pos;
+        char *buff = writer->claim(&pos);
+        if (!buff) {
+            return;
+        }
+        size_t len = formatMessage(buff, AsyncWriter::RecordSize, _level,
+                                   dropped, fname, line, func, fmt, ap);
+        if (len >= AsyncWriter::RecordSize) {
+            len = AsyncWriter::RecordSize - 1;
+        }
+        writer->publish(pos, len);
+        return;
+    }
+    // A single write() keeps messages from different threads and processes
+    // from being interleaved.
+    Str::Buff<1024> buff;
+    va_list ap2;
+    va_copy(ap2, ap);
+    size_t len = formatMessage(buff.get(), buff.size(), _level, dropped,
+                               fname, line, func, fmt, ap);
+    if (len >= buff.size()) {
+        buff.resize(len + 1);
+        formatMessage(buff.get(), buff.size(), _level, dropped,
+                      fname, line, func, fmt, ap2);
     }
+    va_end(ap2);
+    writeAll(out.fd, buff.get(), len);
 }
 
 QTC_EXPORT void
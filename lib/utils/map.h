@@ -26,6 +26,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <utility>
 
 namespace QtCurve {
 
@@ -96,6 +97,215 @@ public:
     }
 };
 
+namespace _StaticStrMap {
+
+static constexpr inline char
+lower(char c)
+{
+    return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c;
+}
+
+template<bool case_sens>
+static constexpr inline uint32_t
+hash(const char *str, uint32_t seed)
+{
+    // FNV-1a followed by the murmur3 finalizer, since the table index only
+    // uses the low bits.
+    uint32_t h = 2166136261u ^ (seed * 0x9e3779b9u);
+    for (;*str;str++) {
+        h = (h ^ uint8_t(case_sens ? *str : lower(*str))) * 16777619u;
+    }
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+template<bool case_sens>
+static constexpr inline bool
+equal(const char *a, const char *b)
+{
+    for (;*a && *b;a++, b++) {
+        if (case_sens ? *a != *b : lower(*a) != lower(*b)) {
+            return false;
+        }
+    }
+    return *a == *b;
+}
+
+static constexpr inline size_t
+tableSize(size_t n)
+{
+    // Keep the load factor below 2/3 so that the displacement search
+    // stays short.
+    size_t size = 1;
+    while (size < n + n / 2) {
+        size *= 2;
+    }
+    return size;
+}
+
+}
+
+/**
+ * Same lookup as StrMap, but the table is a perfect hash (hash and displace)
+ * built by the compiler, so there is nothing to do at load time and a lookup
+ * costs two hashes of the key and a single string compare.
+ * Create one with makeStaticStrMap().
+ * Duplicated keys are allowed, the first one wins.
+ */
+template<typename Val, bool case_sens, size_t N>
+class StaticStrMap {
+    static constexpr size_t Size = _StaticStrMap::tableSize(N);
+    const char *m_keys[Size];
+    Val m_vals[Size];
+    // For each first level bucket, 0 if it is empty, -(slot + 1) if its only
+    // key is stored in slot, the seed of the second level hash otherwise.
+    int32_t m_disp[Size];
+
+    static constexpr size_t
+    bucket(const char *key)
+    {
+        return _StaticStrMap::hash<case_sens>(key, 0) % Size;
+    }
+    static constexpr size_t
+    slot(const char *key, int32_t disp)
+    {
+        return (disp < 0 ? size_t(-disp - 1) :
+                _StaticStrMap::hash<case_sens>(key, disp) % Size);
+    }
+    constexpr void
+    build(const char *const (&keys)[N], const Val (&vals)[N])
+    {
+        // Drop duplicates, they would never hash to different slots.
+        size_t idx[N] = {};
+        size_t nkeys = 0;
+        for (size_t i = 0;i < N;i++) {
+            bool dup = false;
+            for (size_t j = 0;j < nkeys && !dup;j++) {
+                dup = _StaticStrMap::equal<case_sens>(keys[idx[j]], keys[i]);
+            }
+            if (!dup) {
+                idx[nkeys++] = i;
+            }
+        }
+        size_t count[Size] = {};
+        size_t order[Size] = {};
+        for (size_t i = 0;i < nkeys;i++) {
+            count[bucket(keys[idx[i]])]++;
+        }
+        // Place the largest buckets first while the table is still empty.
+        for (size_t b = 0;b < Size;b++) {
+            size_t j = b;
+            for (;j > 0 && count[order[j - 1]] < count[b];j--) {
+                order[j] = order[j - 1];
+            }
+            order[j] = b;
+        }
+        bool used[Size] = {};
+        size_t free_slot = 0;
+        for (size_t o = 0;o < Size && count[order[o]];o++) {
+            const size_t b = order[o];
+            size_t members[N] = {};
+            size_t nmembers = 0;
+            for (size_t i = 0;i < nkeys;i++) {
+                if (bucket(keys[idx[i]]) == b) {
+                    members[nmembers++] = idx[i];
+                }
+            }
+            if (nmembers == 1) {
+                while (used[free_slot]) {
+                    free_slot++;
+                }
+                m_disp[b] = -int32_t(free_slot + 1);
+            } else {
+                for (int32_t disp = 1;;disp++) {
+                    size_t slots[N] = {};
+                    bool ok = true;
+                    for (size_t m = 0;m < nmembers && ok;m++) {
+                        slots[m] = slot(keys[members[m]], disp);
+                        ok = !used[slots[m]];
+                        for (size_t k = 0;k < m && ok;k++) {
+                            ok = slots[k] != slots[m];
+                        }
+                    }
+                    if (ok) {
+                        m_disp[b] = disp;
+                        break;
+                    }
+                }
+            }
+            for (size_t m = 0;m < nmembers;m++) {
+                size_t s = slot(keys[members[m]], m_disp[b]);
+                used[s] = true;
+                m_keys[s] = keys[members[m]];
+                m_vals[s] = vals[members[m]];
+            }
+        }
+    }
+public:
+    template<size_t... S>
+    constexpr
+    StaticStrMap(const std::pair<const char*, Val> (&items)[N],
+                 std::index_sequence<S...>)
+        : m_keys{},
+          m_vals{},
+          m_disp{}
+    {
+        const char *const keys[N] = {items[S].first...};
+        const Val vals[N] = {items[S].second...};
+        build(keys, vals);
+    }
+    template<size_t... S>
+    constexpr
+    StaticStrMap(const char *const (&keys)[N], std::index_sequence<S...>)
+        : m_keys{},
+          m_vals{},
+          m_disp{}
+    {
+        const Val vals[N] = {Val(S)...};
+        build(keys, vals);
+    }
+    Val
+    search(const char *key, Val def=Val(-1), bool *is_def=nullptr) const
+    {
+        QTC_RET_IF_FAIL(key, def);
+        int32_t disp = m_disp[bucket(key)];
+        if (disp) {
+            size_t s = slot(key, disp);
+            if (m_keys[s] &&
+                (case_sens ? strcmp(m_keys[s], key) :
+                 strcasecmp(m_keys[s], key)) == 0) {
+                qtcAssign(is_def, false);
+                return m_vals[s];
+            }
+        }
+        qtcAssign(is_def, true);
+        return def;
+    }
+};
+
+template<typename Val=int, bool case_sens=true, size_t N>
+static constexpr inline StaticStrMap<Val, case_sens, N>
+makeStaticStrMap(const std::pair<const char*, Val> (&items)[N])
+{
+    return StaticStrMap<Val, case_sens, N>(items,
+                                           std::make_index_sequence<N>());
+}
+
+/**
+ * Maps each key to its index in the list.
+ */
+template<typename Val=int, bool case_sens=true, size_t N>
+static constexpr inline StaticStrMap<Val, case_sens, N>
+makeStaticStrMap(const char *const (&keys)[N])
+{
+    return StaticStrMap<Val, case_sens, N>(keys,
+                                           std::make_index_sequence<N>());
+}
+
 }
 
 #endif
@@ -0,0 +1,538 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#ifndef QTC_UTILS_OPTIONFIELDS_H
+#define QTC_UTILS_OPTIONFIELDS_H
+
+#include "rcfile.h"
+
+#include <string.h>
+
+/**
+ * \file optionfields.h
+ * \brief The style options shared by the Qt and Gtk2 styles.
+ *
+ * Every option is listed once in QTC_OPTION_FIELDS, in the order it is read,
+ * together with its default and what has to be updated when it changes.
+ * readOptions() and defaultOptions() are instantiated by the toolkits for
+ * their Options struct with an adapter for the types that differ between
+ * them,
+ * \code
+ * struct Adapter {
+ *     static void setColor(Color *col, const char *str);
+ *     // Remember the file of a `file:` background and load it if \param
+ *     // load is true, returns false if that failed.
+ *     static bool loadPixmap(const char *file, Pixmap *pix, bool load);
+ * };
+ * \endcode
+ * Lists, custom gradients, background images and whatever else only one
+ * toolkit has are still read by the toolkit.
+ *
+ * The defaults use the constants of the toolkit common.h so this header has
+ * to be included after it. The QT() entries are only used if it is a Qt one.
+ */
+
+/* What has to be updated when switching between two Options. */
+enum {
+    QTC_CFG_REPAINT     = 0x0001, // Only needs painting again
+    QTC_CFG_COLORS      = 0x0002, // Color sets calculated in Style::init
+    QTC_CFG_PIXMAPS     = 0x0004, // Pixmap caches are stale
+    QTC_CFG_BGND_IMAGES = 0x0008, // Background image files
+    QTC_CFG_OPACITY     = 0x0010, // Windows need to be polished again
+    QTC_CFG_MENUS       = 0x0020, // Menus need to be polished again
+    QTC_CFG_WINDOW_DRAG = 0x0040,
+    QTC_CFG_BAR_HIDING  = 0x0080,
+    QTC_CFG_POLISH      = 0x0100  // Every widget needs to be polished again
+};
+
+/**
+ * The entries are
+ *   VALUE(name, default, changes)  not read by readOptions()
+ *   BOOL(name, default, changes)
+ *   INT(name, default, changes)
+ *   INT_BOOL(name, value, default, changes)  `true` is read as \param value
+ *   ENUM(name, type, default, changes)  read with loadValue<type>
+ *   APPEARANCE(name, EAppAllow, default, changes)
+ *   PIXMAP(name, pixmap, default, changes)  may be a `file:` appearance
+ *   SHADE(name, allowMenu, menuShade, color, default, changes)
+ *   COLOR(name, changes)  the default is up to the toolkit
+ *   QT(entry)  only in the Qt styles
+ * INT_BOOL values may refer to the options read before them as `opts->`.
+ */
+#define QTC_OPTION_FIELDS(VALUE, BOOL, INT, INT_BOOL, ENUM, APPEARANCE,    \
+                          PIXMAP, SHADE, COLOR, QT)                        \
+    VALUE(contrast, 7, QTC_CFG_COLORS)                                    \
+    ENUM(groupBox, EFrame, FRAME_FADED, QTC_CFG_PIXMAPS | QTC_CFG_POLISH) \
+    INT(gbLabel, GB_LBL_BOLD | GB_LBL_OUTSIDE, QTC_CFG_POLISH)            \
+    INT(windowBorder,                                                     \
+        WINDOW_BORDER_ADD_LIGHT_BORDER | WINDOW_BORDER_FILL_TITLEBAR,     \
+        QTC_CFG_POLISH)                                                   \
+    INT(square, SQUARE_POPUP_MENUS | SQUARE_TOOLTIPS,                     \
+        QTC_CFG_PIXMAPS | QTC_CFG_POLISH)                                 \
+    INT(thin, THIN_BUTTONS, QTC_CFG_POLISH)                               \
+    INT(gbFactor, DEF_GB_FACTOR, QTC_CFG_POLISH)                          \
+    INT(passwordChar, 0x25CF, QTC_CFG_POLISH)                             \
+    ENUM(round, ERound, ROUND_EXTRA, QTC_CFG_PIXMAPS | QTC_CFG_POLISH)    \
+    INT(highlightFactor, DEFAULT_HIGHLIGHT_FACTOR,                        \
+        QTC_CFG_COLORS | QTC_CFG_PIXMAPS | QTC_CFG_POLISH)                \
+    INT(menuDelay, DEFAULT_MENU_DELAY, QTC_CFG_REPAINT)                   \
+    INT(menuCloseDelay, DEFAULT_MENU_CLOSE_DELAY, QTC_CFG_REPAINT)        \
+    INT(sliderWidth, DEFAULT_SLIDER_WIDTH, QTC_CFG_POLISH)                \
+    INT(tabBgnd, DEF_TAB_BGND, QTC_CFG_REPAINT)                           \
+    ENUM(toolbarBorders, ETBarBorder, TB_NONE, QTC_CFG_POLISH)            \
+    APPEARANCE(appearance, APP_ALLOW_BASIC, APPEARANCE_SOFT_GRADIENT,     \
+               QTC_CFG_COLORS | QTC_CFG_PIXMAPS)                          \
+    APPEARANCE(tbarBtnAppearance, APP_ALLOW_NONE, APPEARANCE_NONE,        \
+               QTC_CFG_PIXMAPS)                                           \
+    ENUM(tbarBtnEffect, EEffect, EFFECT_NONE, QTC_CFG_PIXMAPS)            \
+    PIXMAP(bgndAppearance, bgndPixmap, APPEARANCE_FLAT, QTC_CFG_POLISH)   \
+    ENUM(bgndGrad, EGradType, GT_HORIZ, QTC_CFG_REPAINT)                  \
+    ENUM(menuBgndGrad, EGradType, GT_HORIZ, QTC_CFG_REPAINT)              \
+    INT_BOOL(lighterPopupMenuBgnd, def->lighterPopupMenuBgnd,             \
+             DEF_POPUPMENU_LIGHT_FACTOR, QTC_CFG_COLORS | QTC_CFG_MENUS)  \
+    PIXMAP(menuBgndAppearance, menuBgndPixmap, APPEARANCE_FLAT,           \
+           QTC_CFG_MENUS)                                                 \
+    ENUM(stripedProgress, EStripe, STRIPE_NONE, QTC_CFG_PIXMAPS)          \
+    ENUM(sliderStyle, ESliderStyle, SLIDER_PLAIN,                         \
+         QTC_CFG_PIXMAPS | QTC_CFG_POLISH)                                \
+    BOOL(animatedProgress, false, QTC_CFG_REPAINT)                        \
+    BOOL(embolden, false, QTC_CFG_REPAINT)                                \
+    ENUM(defBtnIndicator, EDefBtnIndicator, IND_GLOW,                     \
+         QTC_CFG_COLORS | QTC_CFG_PIXMAPS)                                \
+    ENUM(sliderThumbs, ELine, LINE_FLAT, QTC_CFG_REPAINT)                 \
+    ENUM(handles, ELine, LINE_1DOT, QTC_CFG_POLISH)                       \
+    BOOL(highlightTab, false, QTC_CFG_POLISH)                             \
+    INT_BOOL(colorSelTab, DEF_COLOR_SEL_TAB_FACTOR, 0, QTC_CFG_REPAINT)   \
+    BOOL(roundAllTabs, true, QTC_CFG_PIXMAPS)                             \
+    ENUM(tabMouseOver, ETabMo, TAB_MO_GLOW, QTC_CFG_POLISH)               \
+    SHADE(shadeSliders, true, false, customSlidersColor, SHADE_NONE,      \
+          QTC_CFG_COLORS | QTC_CFG_PIXMAPS)                               \
+    SHADE(shadeMenubars, true, false, customMenubarsColor, SHADE_NONE,    \
+          QTC_CFG_COLORS | QTC_CFG_MENUS)                                 \
+    SHADE(shadeCheckRadio, false, false, customCheckRadioColor,           \
+          SHADE_NONE, QTC_CFG_COLORS)                                     \
+    SHADE(sortedLv, true, false, customSortedLvColor, SHADE_NONE,         \
+          QTC_CFG_COLORS)                                                 \
+    SHADE(crColor, true, false, customCrBgndColor, SHADE_NONE,            \
+          QTC_CFG_COLORS)                                                 \
+    SHADE(progressColor, false, false, customProgressColor,               \
+          SHADE_SELECTED, QTC_CFG_COLORS)                                 \
+    APPEARANCE(menubarAppearance, APP_ALLOW_BASIC, APPEARANCE_FLAT,       \
+               QTC_CFG_PIXMAPS)                                           \
+    APPEARANCE(menuitemAppearance, APP_ALLOW_FADE, APPEARANCE_FADE,       \
+               QTC_CFG_PIXMAPS)                                           \
+    APPEARANCE(toolbarAppearance, APP_ALLOW_BASIC, APPEARANCE_FLAT,       \
+               QTC_CFG_PIXMAPS | QTC_CFG_POLISH)                          \
+    APPEARANCE(selectionAppearance, APP_ALLOW_BASIC,                      \
+               APPEARANCE_HARSH_GRADIENT, QTC_CFG_PIXMAPS)                \
+    QT(APPEARANCE(dwtAppearance, APP_ALLOW_BASIC, APPEARANCE_CUSTOM1,     \
+                  QTC_CFG_PIXMAPS))                                       \
+    ENUM(toolbarSeparators, ELine, LINE_SUNKEN, QTC_CFG_REPAINT)          \
+    ENUM(splitters, ELine, LINE_1DOT, QTC_CFG_POLISH)                     \
+    BOOL(customMenuTextColor, false, QTC_CFG_MENUS)                       \
+    ENUM(coloredMouseOver, EMouseOver, MO_GLOW,                           \
+         QTC_CFG_PIXMAPS | QTC_CFG_POLISH)                                \
+    BOOL(menubarMouseOver, true, QTC_CFG_POLISH)                          \
+    BOOL(useHighlightForMenu, false, QTC_CFG_COLORS | QTC_CFG_MENUS)      \
+    BOOL(shadeMenubarOnlyWhenActive, false, QTC_CFG_POLISH)               \
+    ENUM(tbarBtns, ETBarBtn, TBTN_STANDARD, QTC_CFG_POLISH)               \
+    COLOR(customMenuSelTextColor, QTC_CFG_MENUS)                          \
+    COLOR(customMenuNormTextColor, QTC_CFG_MENUS)                         \
+    ENUM(scrollbarType, EScrollbar, SCROLLBAR_KDE, QTC_CFG_POLISH)        \
+    ENUM(buttonEffect, EEffect, EFFECT_SHADOW,                            \
+         QTC_CFG_PIXMAPS | QTC_CFG_POLISH)                                \
+    APPEARANCE(lvAppearance, APP_ALLOW_BASIC, APPEARANCE_BEVELLED,        \
+               QTC_CFG_PIXMAPS)                                           \
+    APPEARANCE(tabAppearance, APP_ALLOW_BASIC, APPEARANCE_SOFT_GRADIENT,  \
+               QTC_CFG_PIXMAPS)                                           \
+    APPEARANCE(activeTabAppearance, APP_ALLOW_BASIC,                      \
+               APPEARANCE_SOFT_GRADIENT, QTC_CFG_PIXMAPS)                 \
+    APPEARANCE(sliderAppearance, APP_ALLOW_BASIC,                         \
+               APPEARANCE_SOFT_GRADIENT, QTC_CFG_PIXMAPS)                 \
+    APPEARANCE(progressAppearance, APP_ALLOW_BASIC,                       \
+               APPEARANCE_DULL_GLASS, QTC_CFG_PIXMAPS)                    \
+    APPEARANCE(progressGrooveAppearance, APP_ALLOW_BASIC,                 \
+               APPEARANCE_INVERTED, QTC_CFG_PIXMAPS)                      \
+    APPEARANCE(grooveAppearance, APP_ALLOW_BASIC, APPEARANCE_INVERTED,    \
+               QTC_CFG_PIXMAPS)                                           \
+    APPEARANCE(sunkenAppearance, APP_ALLOW_BASIC,                         \
+               APPEARANCE_SOFT_GRADIENT, QTC_CFG_PIXMAPS)                 \
+    APPEARANCE(sbarBgndAppearance, APP_ALLOW_BASIC, APPEARANCE_FLAT,      \
+               QTC_CFG_PIXMAPS)                                           \
+    APPEARANCE(tooltipAppearance, APP_ALLOW_BASIC, APPEARANCE_GRADIENT,   \
+               QTC_CFG_PIXMAPS | QTC_CFG_POLISH)                          \
+    APPEARANCE(sliderFill, APP_ALLOW_BASIC, APPEARANCE_GRADIENT,          \
+               QTC_CFG_PIXMAPS)                                           \
+    ENUM(progressGrooveColor, EColor, ECOLOR_DARK, QTC_CFG_PIXMAPS)       \
+    ENUM(focus, EFocus, FOCUS_GLOW, QTC_CFG_PIXMAPS | QTC_CFG_POLISH)     \
+    BOOL(lvButton, false, QTC_CFG_COLORS | QTC_CFG_PIXMAPS)               \
+    VALUE(lvLines, false, QTC_CFG_REPAINT)                                \
+    BOOL(drawStatusBarFrames, false, QTC_CFG_REPAINT)                     \
+    BOOL(fillSlider, true, QTC_CFG_PIXMAPS)                               \
+    BOOL(roundMbTopOnly, true, QTC_CFG_REPAINT)                           \
+    BOOL(borderMenuitems, false, QTC_CFG_PIXMAPS | QTC_CFG_POLISH)        \
+    BOOL(darkerBorders, false, QTC_CFG_PIXMAPS)                           \
+    BOOL(vArrows, true, QTC_CFG_REPAINT)                                  \
+    BOOL(xCheck, false, QTC_CFG_PIXMAPS)                                  \
+    BOOL(fadeLines, true, QTC_CFG_REPAINT)                                \
+    ENUM(glowProgress, EGlow, GLOW_NONE, QTC_CFG_PIXMAPS)                 \
+    BOOL(colorMenubarMouseOver, true, QTC_CFG_REPAINT)                    \
+    INT_BOOL(crHighlight, opts->highlightFactor,                          \
+             DEFAULT_CR_HIGHLIGHT_FACTOR, QTC_CFG_POLISH)                 \
+    BOOL(crButton, true, QTC_CFG_COLORS | QTC_CFG_PIXMAPS)                \
+    BOOL(smallRadio, true, QTC_CFG_POLISH)                                \
+    BOOL(fillProgress, true, QTC_CFG_PIXMAPS | QTC_CFG_POLISH)            \
+    BOOL(comboSplitter, false, QTC_CFG_REPAINT)                           \
+    BOOL(highlightScrollViews, false, QTC_CFG_POLISH)                     \
+    BOOL(etchEntry, false, QTC_CFG_PIXMAPS | QTC_CFG_POLISH)              \
+    INT_BOOL(splitterHighlight, opts->highlightFactor,                    \
+             DEFAULT_SPLITTER_HIGHLIGHT_FACTOR, QTC_CFG_REPAINT)          \
+    INT(crSize, CR_LARGE_SIZE, QTC_CFG_POLISH)                            \
+    BOOL(flatSbarButtons, true, QTC_CFG_PIXMAPS | QTC_CFG_POLISH)         \
+    BOOL(borderSbarGroove, true, QTC_CFG_POLISH)                          \
+    BOOL(borderProgress, true, QTC_CFG_PIXMAPS | QTC_CFG_POLISH)          \
+    BOOL(popupBorder, true, QTC_CFG_MENUS)                                \
+    BOOL(unifySpinBtns, false, QTC_CFG_PIXMAPS)                           \
+    BOOL(unifySpin, true, QTC_CFG_POLISH)                                 \
+    BOOL(unifyCombo, true, QTC_CFG_POLISH)                                \
+    BOOL(borderTab, true, QTC_CFG_PIXMAPS)                                \
+    BOOL(borderInactiveTab, false, QTC_CFG_PIXMAPS)                       \
+    BOOL(thinSbarGroove, true, QTC_CFG_POLISH)                            \
+    BOOL(colorSliderMouseOver, false, QTC_CFG_PIXMAPS)                    \
+    BOOL(menuIcons, true, QTC_CFG_POLISH)                                 \
+    BOOL(onlyTicksInMenu, QtCurve::Config::onMac, QTC_CFG_MENUS)          \
+    BOOL(buttonStyleMenuSections, !QtCurve::Config::onMac, QTC_CFG_MENUS) \
+    BOOL(forceAlternateLvCols, false, QTC_CFG_POLISH)                     \
+    BOOL(invertBotTab, true, QTC_CFG_PIXMAPS)                             \
+    INT_BOOL(menubarHiding, HIDE_KEYBOARD, HIDE_NONE,                     \
+             QTC_CFG_BAR_HIDING | QTC_CFG_POLISH)                         \
+    INT_BOOL(statusbarHiding, HIDE_KEYBOARD, HIDE_NONE,                   \
+             QTC_CFG_BAR_HIDING | QTC_CFG_POLISH)                         \
+    BOOL(boldProgress, true, QTC_CFG_POLISH)                              \
+    BOOL(coloredTbarMo, false, QTC_CFG_PIXMAPS)                           \
+    BOOL(borderSelection, false, QTC_CFG_PIXMAPS)                         \
+    BOOL(stripedSbar, false, QTC_CFG_PIXMAPS)                             \
+    INT_BOOL(windowDrag, WM_DRAG_MENUBAR, WM_DRAG_NONE,                   \
+             QTC_CFG_WINDOW_DRAG)                                         \
+    BOOL(shadePopupMenu, false, QTC_CFG_COLORS | QTC_CFG_MENUS)           \
+    BOOL(hideShortcutUnderline, false, QTC_CFG_POLISH)                    \
+    QT(BOOL(stdBtnSizes, false, QTC_CFG_POLISH))                          \
+    QT(INT(titlebarButtons,                                               \
+           TITLEBAR_BUTTON_ROUND | TITLEBAR_BUTTON_HOVER_SYMBOL,          \
+           QTC_CFG_COLORS | QTC_CFG_POLISH))                              \
+    QT(ENUM(titlebarIcon, ETitleBarIcon, TITLEBAR_ICON_NEXT_TO_TITLE,     \
+            QTC_CFG_POLISH))                                              \
+    QT(INT(dwtSettings, DWT_BUTTONS_AS_PER_TITLEBAR | DWT_ROUND_TOP_ONLY, \
+           QTC_CFG_POLISH))                                               \
+    INT(bgndOpacity, 100, QTC_CFG_OPACITY)                                \
+    INT(menuBgndOpacity, 100, QTC_CFG_OPACITY | QTC_CFG_MENUS)            \
+    INT(dlgOpacity, 100, QTC_CFG_OPACITY)                                 \
+    INT(shadowSize, qtcX11ShadowSize(), QTC_CFG_POLISH)                   \
+    SHADE(menuStripe, true, true, customMenuStripeColor, SHADE_NONE,      \
+          QTC_CFG_REPAINT)                                                \
+    APPEARANCE(menuStripeAppearance, APP_ALLOW_BASIC,                     \
+               APPEARANCE_DARK_INVERTED, QTC_CFG_PIXMAPS)                 \
+    SHADE(comboBtn, true, false, customComboBtnColor, SHADE_NONE,         \
+          QTC_CFG_COLORS)                                                 \
+    BOOL(gtkScrollViews, true, QTC_CFG_POLISH)                            \
+    BOOL(doubleGtkComboArrow, true, QTC_CFG_REPAINT)                      \
+    BOOL(stdSidebarButtons, false, QTC_CFG_POLISH)                        \
+    BOOL(toolbarTabs, false, QTC_CFG_PIXMAPS)                             \
+    BOOL(gtkComboMenus, false, QTC_CFG_POLISH)                            \
+    QT(ENUM(titlebarAlignment, EAlign, ALIGN_FULL_CENTER, QTC_CFG_POLISH)) \
+    QT(ENUM(titlebarEffect, EEffect, EFFECT_SHADOW, QTC_CFG_POLISH))      \
+    QT(BOOL(centerTabText, false, QTC_CFG_POLISH))                        \
+    INT(expanderHighlight, DEFAULT_EXPANDER_HIGHLIGHT_FACTOR,             \
+        QTC_CFG_REPAINT)                                                  \
+    BOOL(mapKdeIcons, true, QTC_CFG_POLISH)                               \
+    BOOL(gtkButtonOrder, false, QTC_CFG_POLISH)                           \
+    BOOL(reorderGtkButtons, false, QTC_CFG_REPAINT)                       \
+    APPEARANCE(titlebarAppearance, APP_ALLOW_NONE, APPEARANCE_CUSTOM1,    \
+               QTC_CFG_PIXMAPS | QTC_CFG_POLISH)                          \
+    APPEARANCE(inactiveTitlebarAppearance, APP_ALLOW_NONE,                \
+               APPEARANCE_CUSTOM1, QTC_CFG_PIXMAPS | QTC_CFG_POLISH)      \
+    QT(APPEARANCE(titlebarButtonAppearance, APP_ALLOW_BASIC,              \
+                  APPEARANCE_GRADIENT, QTC_CFG_PIXMAPS))                  \
+    ENUM(shading, Shading, Shading::HSL, QTC_CFG_COLORS | QTC_CFG_PIXMAPS)
+
+namespace QtCurve {
+namespace Config {
+
+#ifdef __APPLE__
+static constexpr bool onMac = true;
+#else
+static constexpr bool onMac = false;
+#endif
+
+#define _QTC_OPT_SKIP(...)
+#ifdef QT_VERSION
+#define _QTC_OPT_QT(...) __VA_ARGS__
+#else
+#define _QTC_OPT_QT(...)
+#endif
+
+/**
+ * Set the defaults of the options in the table, the background images and
+ * the custom shades.
+ */
+template<typename Adapter, typename Opts>
+static inline void
+defaultOptions(Opts *opts)
+{
+#define _QTC_OPT_DEF3(name, dflt, changes) opts->name = dflt;
+#define _QTC_OPT_DEF4(name, arg, dflt, changes) opts->name = dflt;
+#define _QTC_OPT_DEF6(name, arg1, arg2, arg3, dflt, changes)            \
+    opts->name = dflt;
+    QTC_OPTION_FIELDS(_QTC_OPT_DEF3, _QTC_OPT_DEF3, _QTC_OPT_DEF3,
+                      _QTC_OPT_DEF4, _QTC_OPT_DEF4, _QTC_OPT_DEF4,
+                      _QTC_OPT_DEF4, _QTC_OPT_DEF6, _QTC_OPT_SKIP,
+                      _QTC_OPT_QT)
+#undef _QTC_OPT_DEF3
+#undef _QTC_OPT_DEF4
+#undef _QTC_OPT_DEF6
+    for (auto *img: {&opts->bgndImage, &opts->menuBgndImage}) {
+        img->type = IMG_NONE;
+        img->width = img->height = 0;
+        img->onBorder = false;
+        img->pos = PP_TR;
+    }
+    opts->customShades[0] = 1.16;
+    opts->customShades[1] = 1.07;
+    opts->customShades[2] = 0.9;
+    opts->customShades[3] = 0.78;
+    opts->customShades[4] = 0.84;
+    opts->customShades[5] = 0.75;
+    opts->customAlphas[0] = 0;
+}
+
+/**
+ * Read the options in the table from \param cfg, falling back to
+ * \param def, which may be modified to the defaults of old config files.
+ * opts->version has to be set already. With \param checkImages a `file:`
+ * background is loaded and ignored if that fails, otherwise only its name
+ * is remembered.
+ */
+template<typename Adapter, typename Opts>
+static inline void
+readOptions(const RcFile &cfg, Opts *opts, Opts *def, bool checkImages)
+{
+    const int version = opts->version;
+
+    /* Check if the config file expects old default values... */
+    if (version < qtcMakeVersion(1, 6)) {
+        def->focus = FOCUS_LINE;
+        def->crHighlight = 3;
+    }
+    if (version < qtcMakeVersion(1, 7)) {
+        def->square = SQUARE_POPUP_MENUS;
+        def->tbarBtns = TBTN_STANDARD;
+    }
+    if (version < qtcMakeVersion(1, 2)) {
+        def->crSize = CR_SMALL_SIZE;
+    }
+    if (opts != def) {
+        opts->customShades[0] = 0;
+        opts->customAlphas[0] = 0;
+        if (USE_CUSTOM_SHADES(*def)) {
+            memcpy(opts->customShades, def->customShades,
+                   sizeof(double) * QTC_NUM_STD_SHADES);
+        }
+    }
+
+#define _QTC_OPT_READ_BOOL(name, dflt, changes)                         \
+    opts->name = cfg.boolValue(#name, def->name);
+#define _QTC_OPT_READ_INT(name, dflt, changes)                          \
+    opts->name = cfg.intValue(#name, def->name);
+#define _QTC_OPT_READ_INT_BOOL(name, trueValue, dflt, changes)          \
+    if (cfg.boolValue(#name, false)) {                                  \
+        opts->name = trueValue;                                         \
+    } else {                                                            \
+        opts->name = cfg.intValue(#name, def->name);                    \
+    }
+#define _QTC_OPT_READ_ENUM(name, type, dflt, changes)                   \
+    opts->name = cfg.value<type>(#name, def->name);
+#define _QTC_OPT_READ_APPEARANCE(name, allow, dflt, changes)            \
+    opts->name = loadAppearance(cfg.value(#name), def->name, allow);
+#define _QTC_OPT_READ_PIXMAP(name, pixmap, dflt, changes) {             \
+        const char *file = nullptr;                                     \
+        opts->name = loadAppearance(cfg.value(#name), def->name,        \
+                                    APP_ALLOW_STRIPED, &file);          \
+        if (file && !Adapter::loadPixmap(file, &opts->pixmap,           \
+                                         checkImages)) {                \
+            opts->name = def->name;                                     \
+        }                                                               \
+    }
+#define _QTC_OPT_READ_SHADE(name, allowMenu, menuShade, color, dflt,    \
+                            changes) {                                  \
+        const char *str = cfg.value(#name);                             \
+        opts->name = loadShade(str, allowMenu, def->name, menuShade);   \
+        if (str && str[0] == '#') {                                     \
+            Adapter::setColor(&opts->color, str);                       \
+        }                                                               \
+    }
+#define _QTC_OPT_READ_COLOR(name, changes) {                            \
+        const char *str = cfg.value(#name);                             \
+        if (str && str[0]) {                                            \
+            Adapter::setColor(&opts->name, str);                        \
+        } else {                                                        \
+            opts->name = def->name;                                     \
+        }                                                               \
+    }
+    QTC_OPTION_FIELDS(_QTC_OPT_SKIP, _QTC_OPT_READ_BOOL, _QTC_OPT_READ_INT,
+                      _QTC_OPT_READ_INT_BOOL, _QTC_OPT_READ_ENUM,
+                      _QTC_OPT_READ_APPEARANCE, _QTC_OPT_READ_PIXMAP,
+                      _QTC_OPT_READ_SHADE, _QTC_OPT_READ_COLOR, _QTC_OPT_QT)
+#undef _QTC_OPT_READ_BOOL
+#undef _QTC_OPT_READ_INT
+#undef _QTC_OPT_READ_INT_BOOL
+#undef _QTC_OPT_READ_ENUM
+#undef _QTC_OPT_READ_APPEARANCE
+#undef _QTC_OPT_READ_PIXMAP
+#undef _QTC_OPT_READ_SHADE
+#undef _QTC_OPT_READ_COLOR
+    opts->lvLines = loadLvLines(cfg.value("lvLines"), def->lvLines);
+    qtcX11SetShadowSize(opts->shadowSize);
+
+    /* ... and convert the options that changed their meaning. */
+    if (version < qtcMakeVersion(1, 6)) {
+        bool framelessGroupBoxes = cfg.boolValue("framelessGroupBoxes", true);
+        bool groupBoxLine = cfg.boolValue("groupBoxLine", true);
+        opts->groupBox = (framelessGroupBoxes ?
+                          (groupBoxLine ? FRAME_LINE : FRAME_NONE) :
+                          FRAME_PLAIN);
+        opts->gbLabel = framelessGroupBoxes ? GB_LBL_BOLD : 0;
+        opts->tooltipAppearance = APPEARANCE_FLAT;
+    }
+    if (version < qtcMakeVersion(1, 5)) {
+        opts->windowBorder =
+            ((cfg.boolValue("colorTitlebarOnly", def->windowBorder &
+                            WINDOW_BORDER_COLOR_TITLEBAR_ONLY) ?
+              WINDOW_BORDER_COLOR_TITLEBAR_ONLY : 0) +
+             (cfg.boolValue("titlebarBorder", def->windowBorder &
+                            WINDOW_BORDER_ADD_LIGHT_BORDER) ?
+              WINDOW_BORDER_ADD_LIGHT_BORDER : 0) +
+             (cfg.boolValue("titlebarBlend", def->windowBorder &
+                            WINDOW_BORDER_BLEND_TITLEBAR) ?
+              WINDOW_BORDER_BLEND_TITLEBAR : 0));
+    }
+    if (version < qtcMakeVersion(1, 7)) {
+        opts->windowBorder |= WINDOW_BORDER_FILL_TITLEBAR;
+    }
+    if (version < qtcMakeVersion(1, 4)) {
+        opts->square =
+            ((cfg.boolValue("squareLvSelection", def->square &
+                            SQUARE_LISTVIEW_SELECTION) ?
+              SQUARE_LISTVIEW_SELECTION : SQUARE_NONE) +
+             (cfg.boolValue("squareScrollViews", def->square &
+                            SQUARE_SCROLLVIEW) ?
+              SQUARE_SCROLLVIEW : SQUARE_NONE) +
+             (cfg.boolValue("squareProgress", def->square &
+                            SQUARE_PROGRESS) ?
+              SQUARE_PROGRESS : SQUARE_NONE) +
+             (cfg.boolValue("squareEntry", def->square & SQUARE_ENTRY) ?
+              SQUARE_ENTRY : SQUARE_NONE));
+    }
+    if (version < qtcMakeVersion(1, 7)) {
+        opts->thin = ((cfg.boolValue("thinnerMenuItems",
+                                     def->thin & THIN_MENU_ITEMS) ?
+                       THIN_MENU_ITEMS : 0) +
+                      (cfg.boolValue("thinnerBtns", def->thin & THIN_BUTTONS) ?
+                       THIN_BUTTONS : 0));
+    }
+    if (version < qtcMakeVersion(1, 6)) {
+        opts->square |= SQUARE_TOOLTIPS;
+    }
+    if (version < qtcMakeVersion(1, 6, 1)) {
+        opts->square |= SQUARE_POPUP_MENUS;
+    }
+    if (version < qtcMakeVersion(1, 8)) {
+        opts->tbarBtnAppearance = APPEARANCE_NONE;
+        opts->tbarBtnEffect = EFFECT_NONE;
+    }
+    if (opts->menuBgndAppearance == APPEARANCE_FLAT &&
+        opts->lighterPopupMenuBgnd == 0 && version < qtcMakeVersion(1, 7)) {
+        opts->menuBgndAppearance = APPEARANCE_RAISED;
+    }
+
+    if (opts->titlebarAppearance == APPEARANCE_BEVELLED) {
+        opts->titlebarAppearance = APPEARANCE_GRADIENT;
+    } else if (opts->titlebarAppearance == APPEARANCE_RAISED) {
+        opts->titlebarAppearance = APPEARANCE_FLAT;
+    }
+    if (opts->inactiveTitlebarAppearance == APPEARANCE_BEVELLED) {
+        opts->inactiveTitlebarAppearance = APPEARANCE_GRADIENT;
+    } else if (opts->inactiveTitlebarAppearance == APPEARANCE_RAISED) {
+        opts->inactiveTitlebarAppearance = APPEARANCE_FLAT;
+    }
+    if ((opts->windowBorder & WINDOW_BORDER_BLEND_TITLEBAR) &&
+        !(opts->windowBorder & WINDOW_BORDER_COLOR_TITLEBAR_ONLY)) {
+        opts->windowBorder -= WINDOW_BORDER_BLEND_TITLEBAR;
+    }
+}
+
+/**
+ * What has to be updated (QTC_CFG_*) when switching from \param from to
+ * \param to, as far as the options in the table and the custom shades and
+ * alphas are concerned.
+ */
+template<typename Opts>
+static inline int
+optionChanges(const Opts *from, const Opts *to)
+{
+    int changes = 0;
+#define _QTC_OPT_DIFF(name, changes_)                                   \
+    if (!(from->name == to->name)) {                                    \
+        changes |= changes_;                                            \
+    }
+#define _QTC_OPT_DIFF3(name, arg, changes_) _QTC_OPT_DIFF(name, changes_)
+#define _QTC_OPT_DIFF4(name, arg1, arg2, changes_)                      \
+    _QTC_OPT_DIFF(name, changes_)
+#define _QTC_OPT_DIFF6(name, arg1, arg2, color, arg3, changes_)         \
+    _QTC_OPT_DIFF(name, changes_)                                       \
+    _QTC_OPT_DIFF(color, changes_)
+    QTC_OPTION_FIELDS(_QTC_OPT_DIFF3, _QTC_OPT_DIFF3, _QTC_OPT_DIFF3,
+                      _QTC_OPT_DIFF4, _QTC_OPT_DIFF4, _QTC_OPT_DIFF4,
+                      _QTC_OPT_DIFF4, _QTC_OPT_DIFF6, _QTC_OPT_DIFF,
+                      _QTC_OPT_QT)
+#undef _QTC_OPT_DIFF
+#undef _QTC_OPT_DIFF3
+#undef _QTC_OPT_DIFF4
+#undef _QTC_OPT_DIFF6
+    for (int i = 0;i < QTC_NUM_STD_SHADES;i++) {
+        if (!qtcEqual(from->customShades[i], to->customShades[i])) {
+            changes |= QTC_CFG_COLORS | QTC_CFG_PIXMAPS;
+        }
+    }
+    for (int i = 0;i < NUM_STD_ALPHAS;i++) {
+        if (!qtcEqual(from->customAlphas[i], to->customAlphas[i])) {
+            changes |= QTC_CFG_PIXMAPS | QTC_CFG_POLISH;
+        }
+    }
+    return changes;
+}
+
+#undef _QTC_OPT_SKIP
+#undef _QTC_OPT_QT
+
+}
+}
+
+#endif
@@ -25,17 +25,20 @@
 #include "options.h"
 #include "map.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 namespace QtCurve {
 namespace Config {
 
-#define DEF_LOAD_VALUE(type, body...)           \
-    template<>                                  \
-    QTC_EXPORT                                  \
-    _QTC_CONFIG_DEF_LOAD_VALUE(type, str, def)  \
-    {                                           \
-        static const StrMap<type> map{body};    \
-        return map.search(str, def);            \
-    }                                           \
+#define DEF_LOAD_VALUE(type, body...)                                   \
+    template<>                                                          \
+    QTC_EXPORT                                                          \
+    _QTC_CONFIG_DEF_LOAD_VALUE(type, str, def)                          \
+    {                                                                   \
+        static constexpr auto map = makeStaticStrMap<type>({body});     \
+        return map.search(str, def);                                    \
+    }                                                                   \
     QTC_CONFIG_DEF_LOAD_VALUE(type)
 
 DEF_LOAD_VALUE(Shading,
@@ -55,6 +58,211 @@ DEF_LOAD_VALUE(EFrame,
                {"line", FRAME_LINE},
                {"shaded", FRAME_SHADED},
                {"faded", FRAME_FADED});
+DEF_LOAD_VALUE(EDefBtnIndicator,
+               {"fontcolor", IND_FONT_COLOR},
+               {"border", IND_FONT_COLOR},
+               {"none", IND_NONE},
+               {"corner", IND_CORNER},
+               {"colored", IND_COLORED},
+               {"tint", IND_TINT},
+               {"glow", IND_GLOW},
+               {"darken", IND_DARKEN},
+               {"origselected", IND_SELECTED});
+DEF_LOAD_VALUE(ELine,
+               {"dashes", LINE_DASHES},
+               {"none", LINE_NONE},
+               {"sunken", LINE_SUNKEN},
+               {"dots", LINE_DOTS},
+               {"flat", LINE_FLAT},
+               {"1dot", LINE_1DOT});
+DEF_LOAD_VALUE(ETBarBorder,
+               {"dark", TB_DARK},
+               {"dark-all", TB_DARK_ALL},
+               {"none", TB_NONE},
+               {"light", TB_LIGHT},
+               {"light-all", TB_LIGHT_ALL});
+DEF_LOAD_VALUE(EMouseOver,
+               {"true", MO_COLORED},
+               {"colored", MO_COLORED},
+               {"thickcolored", MO_COLORED_THICK},
+               {"plastik", MO_PLASTIK},
+               {"glow", MO_GLOW},
+               {"false", MO_NONE},
+               {"none", MO_NONE});
+// Prior to 0.42 round was a bool - so need to read 'false' as 'none'
+DEF_LOAD_VALUE(ERound,
+               {"none", ROUND_NONE},
+               {"false", ROUND_NONE},
+               {"slight", ROUND_SLIGHT},
+               {"full", ROUND_FULL},
+               {"extra", ROUND_EXTRA},
+               {"max", ROUND_MAX});
+DEF_LOAD_VALUE(EEffect,
+               {"none", EFFECT_NONE},
+               {"shadow", EFFECT_SHADOW},
+               {"etch", EFFECT_ETCH});
+DEF_LOAD_VALUE(EStripe,
+               {"plain", STRIPE_PLAIN},
+               {"true", STRIPE_PLAIN},
+               {"none", STRIPE_NONE},
+               {"false", STRIPE_NONE},
+               {"diagonal", STRIPE_DIAGONAL},
+               {"fade", STRIPE_FADE});
+DEF_LOAD_VALUE(ESliderStyle,
+               {"round", SLIDER_ROUND},
+               {"plain", SLIDER_PLAIN},
+               {"r-round", SLIDER_ROUND_ROTATED},
+               {"r-plain", SLIDER_PLAIN_ROTATED},
+               {"triangular", SLIDER_TRIANGULAR},
+               {"circular", SLIDER_CIRCULAR});
+DEF_LOAD_VALUE(EColor,
+               {"base", ECOLOR_BASE},
+               {"dark", ECOLOR_DARK},
+               {"background", ECOLOR_BACKGROUND});
+DEF_LOAD_VALUE(EFocus,
+               {"standard", FOCUS_STANDARD},
+               {"rect", FOCUS_RECTANGLE},
+               {"highlight", FOCUS_RECTANGLE},
+               {"filled", FOCUS_FILLED},
+               {"full", FOCUS_FULL},
+               {"line", FOCUS_LINE},
+               {"glow", FOCUS_GLOW},
+               {"none", FOCUS_NONE});
+DEF_LOAD_VALUE(ETabMo,
+               {"top", TAB_MO_TOP},
+               {"bot", TAB_MO_BOTTOM},
+               {"bottom", TAB_MO_BOTTOM},
+               {"glow", TAB_MO_GLOW});
+DEF_LOAD_VALUE(EGradType,
+               {"horiz", GT_HORIZ},
+               {"vert", GT_VERT});
+DEF_LOAD_VALUE(EAlign,
+               {"left", ALIGN_LEFT},
+               {"center-full", ALIGN_FULL_CENTER},
+               {"center", ALIGN_CENTER},
+               {"right", ALIGN_RIGHT});
+DEF_LOAD_VALUE(ETitleBarIcon,
+               {"none", TITLEBAR_ICON_NONE},
+               {"menu", TITLEBAR_ICON_MENU_BUTTON},
+               {"title", TITLEBAR_ICON_NEXT_TO_TITLE});
+DEF_LOAD_VALUE(EImageType,
+               {"none", IMG_NONE},
+               {"plainrings", IMG_PLAIN_RINGS},
+               {"rings", IMG_BORDERED_RINGS},
+               {"squarerings", IMG_SQUARE_RINGS},
+               {"file", IMG_FILE});
+DEF_LOAD_VALUE(EGlow,
+               {"none", GLOW_NONE},
+               {"start", GLOW_START},
+               {"middle", GLOW_MIDDLE},
+               {"end", GLOW_END});
+DEF_LOAD_VALUE(ETBarBtn,
+               {"standard", TBTN_STANDARD},
+               {"raised", TBTN_RAISED},
+               {"joined", TBTN_JOINED});
+
+QTC_EXPORT EAppearance
+loadAppearance(const char *str, EAppearance def, EAppAllow allow,
+               const char **file)
+{
+    if (str && str[0]) {
+        if (strncmp(str, "flat", 4) == 0)
+            return APPEARANCE_FLAT;
+        if (strncmp(str, "raised", 6) == 0)
+            return APPEARANCE_RAISED;
+        if (strncmp(str, "dullglass", 9) == 0)
+            return APPEARANCE_DULL_GLASS;
+        if (strncmp(str, "glass", 5) == 0 ||
+            strncmp(str, "shinyglass", 10) == 0)
+            return APPEARANCE_SHINY_GLASS;
+        if (strncmp(str, "agua", 4) == 0)
+            return APPEARANCE_AGUA;
+        if (strncmp(str, "soft", 4) == 0)
+            return APPEARANCE_SOFT_GRADIENT;
+        if (strncmp(str, "gradient", 8) == 0 ||
+            strncmp(str, "lightgradient", 13) == 0)
+            return APPEARANCE_GRADIENT;
+        if (strncmp(str, "harsh", 5) == 0)
+            return APPEARANCE_HARSH_GRADIENT;
+        if (strncmp(str, "inverted", 8) == 0)
+            return APPEARANCE_INVERTED;
+        if (strncmp(str, "darkinverted", 12) == 0)
+            return APPEARANCE_DARK_INVERTED;
+        if (strncmp(str, "splitgradient", 13) == 0)
+            return APPEARANCE_SPLIT_GRADIENT;
+        if (strncmp(str, "bevelled", 8) == 0)
+            return APPEARANCE_BEVELLED;
+        if (allow == APP_ALLOW_FADE && strncmp(str, "fade", 4) == 0)
+            return APPEARANCE_FADE;
+        if (allow == APP_ALLOW_STRIPED && strncmp(str, "striped", 7) == 0)
+            return APPEARANCE_STRIPED;
+        if (allow == APP_ALLOW_NONE && strncmp(str, "none", 4) == 0)
+            return APPEARANCE_NONE;
+        if (file && allow == APP_ALLOW_STRIPED &&
+            strncmp(str, "file", 4) == 0 && strlen(str) > 9) {
+            *file = &str[5];
+            return APPEARANCE_FILE;
+        }
+        if (strncmp(str, "customgradient", 14) == 0 && strlen(str) > 14) {
+            int i = atoi(&str[14]) - 1;
+            if (i >= 0 && i < NUM_CUSTOM_GRAD) {
+                return (EAppearance)(APPEARANCE_CUSTOM1 + i);
+            }
+        }
+    }
+    return def;
+}
+
+QTC_EXPORT EShade
+loadShade(const char *str, bool allowMenu, EShade def, bool menuShade)
+{
+    if (str && str[0]) {
+        /* true/false is from 0.25... */
+        if ((!menuShade && strncmp(str, "true", 4) == 0) ||
+            strncmp(str, "selected", 8) == 0)
+            return SHADE_BLEND_SELECTED;
+        if (strncmp(str, "origselected", 12) == 0)
+            return SHADE_SELECTED;
+        if (allowMenu && (strncmp(str, "darken", 6) == 0 ||
+                          (menuShade && strncmp(str, "true", 4) == 0)))
+            return SHADE_DARKEN;
+        if (allowMenu && strncmp(str, "wborder", 7) == 0)
+            return SHADE_WINDOW_BORDER;
+        if (strncmp(str, "custom", 6) == 0 || str[0] == '#')
+            return SHADE_CUSTOM;
+        if (strncmp(str, "none", 4) == 0)
+            return SHADE_NONE;
+    }
+    return def;
+}
+
+QTC_EXPORT bool
+loadLvLines(const char *str, bool def)
+{
+    if (str && str[0]) {
+        return strncmp(str, "false", 5) != 0;
+    }
+    return def;
+}
+
+QTC_EXPORT EGradientBorder
+loadGradientBorder(const char *str, bool *haveAlpha)
+{
+    if (str && str[0]) {
+        *haveAlpha = strstr(str, "-alpha") ? true : false;
+        if (strncmp(str, "light", 5) == 0 || strncmp(str, "true", 4) == 0)
+            return GB_LIGHT;
+        if (strncmp(str, "none", 4) == 0)
+            return GB_NONE;
+        if (strncmp(str, "3dfull", 6) == 0)
+            return GB_3D_FULL;
+        if (strncmp(str, "3d", 2) == 0 || strncmp(str, "false", 5) == 0)
+            return GB_3D;
+        if (strncmp(str, "shine", 5) == 0)
+            return GB_SHINE;
+    }
+    return GB_3D;
+}
 
 }
 }
@@ -105,6 +105,154 @@ enum EGradientBorder {
     GB_SHINE
 };
 
+enum EImageType {
+    IMG_NONE,
+    IMG_BORDERED_RINGS,
+    IMG_PLAIN_RINGS,
+    IMG_SQUARE_RINGS,
+    IMG_FILE
+};
+
+enum EEffect {
+    EFFECT_NONE,
+    EFFECT_ETCH,
+    EFFECT_SHADOW
+};
+
+enum EDefBtnIndicator {
+    IND_CORNER,
+    IND_FONT_COLOR,
+    IND_COLORED,
+    IND_TINT,
+    IND_GLOW,
+    IND_DARKEN,
+    IND_SELECTED,
+    IND_NONE
+};
+
+enum ELine {
+    LINE_NONE,
+    LINE_SUNKEN,
+    LINE_FLAT,
+    LINE_DOTS,
+    LINE_1DOT,
+    LINE_DASHES,
+};
+
+enum ETBarBorder {
+    TB_NONE,
+    TB_LIGHT,
+    TB_DARK,
+    TB_LIGHT_ALL,
+    TB_DARK_ALL
+};
+
+enum ETBarBtn {
+    TBTN_STANDARD,
+    TBTN_RAISED,
+    TBTN_JOINED
+};
+
+enum EColor {
+    ECOLOR_BASE,
+    ECOLOR_BACKGROUND,
+    ECOLOR_DARK,
+};
+
+enum ERound {
+    ROUND_NONE,
+    ROUND_SLIGHT,
+    ROUND_FULL,
+    ROUND_EXTRA,
+    ROUND_MAX
+};
+
+enum EMouseOver {
+    MO_NONE,
+    MO_COLORED,
+    MO_COLORED_THICK,
+    MO_PLASTIK,
+    MO_GLOW
+};
+
+enum EStripe {
+    STRIPE_NONE,
+    STRIPE_PLAIN,
+    STRIPE_DIAGONAL,
+    STRIPE_FADE
+};
+
+enum ESliderStyle {
+    SLIDER_PLAIN,
+    SLIDER_ROUND,
+    SLIDER_PLAIN_ROTATED,
+    SLIDER_ROUND_ROTATED,
+    SLIDER_TRIANGULAR,
+    SLIDER_CIRCULAR
+};
+
+enum EFocus {
+    FOCUS_STANDARD,
+    FOCUS_RECTANGLE,
+    FOCUS_FULL,
+    FOCUS_FILLED,
+    FOCUS_LINE,
+    FOCUS_GLOW,
+    FOCUS_NONE
+};
+
+enum ETabMo {
+    TAB_MO_TOP,
+    TAB_MO_BOTTOM,
+    TAB_MO_GLOW
+};
+
+enum EGradType {
+    GT_HORIZ,
+    GT_VERT
+};
+
+enum EGlow {
+    GLOW_NONE,
+    GLOW_START,
+    GLOW_MIDDLE,
+    GLOW_END
+};
+
+enum EAlign {
+    ALIGN_LEFT,
+    ALIGN_CENTER,
+    ALIGN_FULL_CENTER,
+    ALIGN_RIGHT
+};
+
+enum ETitleBarIcon {
+    TITLEBAR_ICON_NONE,
+    TITLEBAR_ICON_MENU_BUTTON,
+    TITLEBAR_ICON_NEXT_TO_TITLE
+};
+
+enum EAppAllow {
+    APP_ALLOW_BASIC,
+    APP_ALLOW_FADE,
+    APP_ALLOW_STRIPED,
+    APP_ALLOW_NONE
+};
+
+/*
+    This whole EShade enum is a complete mess!
+    For menubars, we dont blend - so blend is selected, and selected is darken
+    For check/radios - we dont blend, so blend is selected, and we dont allow darken
+*/
+enum EShade {
+    SHADE_NONE,
+    SHADE_CUSTOM,
+    SHADE_SELECTED,
+    SHADE_BLEND_SELECTED,
+    SHADE_DARKEN,
+    SHADE_WINDOW_BORDER
+};
+
 enum ECornerBits {
     CORNER_TL = 1 << 0,
     CORNER_TR = 1 << 1,
@@ -204,10 +352,42 @@ template<typename T> T loadValue(const char *str, T def);
 extern QTC_CONFIG_DEF_LOAD_VALUE(Shading);
 extern QTC_CONFIG_DEF_LOAD_VALUE(EScrollbar);
 extern QTC_CONFIG_DEF_LOAD_VALUE(EFrame);
+extern QTC_CONFIG_DEF_LOAD_VALUE(EDefBtnIndicator);
+extern QTC_CONFIG_DEF_LOAD_VALUE(ELine);
+extern QTC_CONFIG_DEF_LOAD_VALUE(ETBarBorder);
+extern QTC_CONFIG_DEF_LOAD_VALUE(EMouseOver);
+extern QTC_CONFIG_DEF_LOAD_VALUE(ERound);
+extern QTC_CONFIG_DEF_LOAD_VALUE(EEffect);
+extern QTC_CONFIG_DEF_LOAD_VALUE(EStripe);
+extern QTC_CONFIG_DEF_LOAD_VALUE(ESliderStyle);
+extern QTC_CONFIG_DEF_LOAD_VALUE(EColor);
+extern QTC_CONFIG_DEF_LOAD_VALUE(EFocus);
+extern QTC_CONFIG_DEF_LOAD_VALUE(ETabMo);
+extern QTC_CONFIG_DEF_LOAD_VALUE(EGradType);
+extern QTC_CONFIG_DEF_LOAD_VALUE(EAlign);
+extern QTC_CONFIG_DEF_LOAD_VALUE(ETitleBarIcon);
+extern QTC_CONFIG_DEF_LOAD_VALUE(EImageType);
+extern QTC_CONFIG_DEF_LOAD_VALUE(EGlow);
+extern QTC_CONFIG_DEF_LOAD_VALUE(ETBarBtn);
 #undef _QTC_CONFIG_DEF_LOAD_VALUE
 #undef QTC_CONFIG_DEF_LOAD_VALUE
 #endif
 
+/**
+ * Parse an appearance entry. `file:<name>` is only accepted if \param file
+ * is not nullptr and \param allow is APP_ALLOW_STRIPED. The name is then
+ * returned in \param file, loading it is up to the caller.
+ */
+EAppearance loadAppearance(const char *str, EAppearance def, EAppAllow allow,
+                           const char **file=nullptr);
+/**
+ * Parse a shade entry. A `#rrggbb` value is SHADE_CUSTOM, the color itself
+ * has to be parsed by the caller.
+ */
+EShade loadShade(const char *str, bool allowMenu, EShade def, bool menuShade);
+bool loadLvLines(const char *str, bool def);
+EGradientBorder loadGradientBorder(const char *str, bool *haveAlpha);
+
 }
 
 }
@@ -26,6 +26,7 @@
 #include <QSharedPointer>
 #include <QVariant>
 #include <QMdiSubWindow>
+#include <QRegion>
 
 namespace QtCurve {
 
@@ -39,7 +40,9 @@ struct _QtcQWidgetProps {
         prePolishStarted(false),
 #endif
         shadowRegistered(false),
-        noEtch(false)
+        noEtch(false),
+        blurOpaqueValid(false),
+        blurRegionSent(false)
     {
     }
     int opacity;
@@ -53,6 +56,11 @@ struct _QtcQWidgetProps {
     // OK, Etching looks cr*p on plasma widgets, and khtml...
     // CPD:TODO WebKit?
     bool noEtch: 1;
+    // Cached by the blur helper, see BlurHelper::opaqueRegion
+    bool blurOpaqueValid: 1;
+    bool blurRegionSent: 1;
+    QRegion blurOpaqueRegion;
+    QRegion blurRegion;
 };
 
 #define QTC_PROP_NAME "_q__QTCURVE_WIDGET_PROPERTIES__"
@@ -0,0 +1,166 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include "rcfile.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace QtCurve {
+namespace Config {
+
+QTC_EXPORT
+RcFile::RcFile(const char *path)
+    : m_buff(0),
+      m_entries(0),
+      m_count(0)
+{
+    if (path) {
+        load(path);
+    }
+}
+
+QTC_EXPORT bool
+RcFile::load(const char *path)
+{
+    m_count = 0;
+    QTC_RET_IF_FAIL(path && path[0], false);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    QTC_RET_IF_FAIL(fd >= 0, false);
+    struct stat st;
+    size_t len = 0;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        m_buff.resize(st.st_size + 1);
+        while (len < m_buff.size() - 1) {
+            ssize_t res = read(fd, m_buff.get() + len,
+                               m_buff.size() - 1 - len);
+            if (res > 0) {
+                len += res;
+            } else if (res == 0 || errno != EINTR) {
+                break;
+            }
+        }
+    }
+    close(fd);
+    split(len);
+    return true;
+}
+
+QTC_EXPORT void
+RcFile::parse(const char *str, size_t len)
+{
+    m_buff.resize(len + 1);
+    memcpy(m_buff.get(), str, len);
+    split(len);
+}
+
+// Tokenize the first len bytes of m_buff.
+void
+RcFile::split(size_t len)
+{
+    char *p = m_buff.get();
+    char *const end = p + len;
+    *end = '\0';
+    size_t lines = 1;
+    for (const char *nl = p;(nl = (const char*)memchr(nl, '\n', end - nl));
+         nl++) {
+        lines++;
+    }
+    m_entries.resize(lines);
+    Entry *entries = m_entries.get();
+    m_count = 0;
+    while (p < end) {
+        char *line = p;
+        char *eol = (char*)memchr(p, '\n', end - p);
+        if (eol) {
+            *eol = '\0';
+            p = eol + 1;
+        } else {
+            eol = end;
+            p = end;
+        }
+        if (eol > line && eol[-1] == '\r') {
+            eol[-1] = '\0';
+        }
+        char *eq = strchr(line, '=');
+        if (eq && eq > line) {
+            *eq = '\0';
+            entries[m_count++] = Entry(line, eq + 1);
+        }
+    }
+    // The keys point into the buffer, so between equal keys the one with
+    // the larger address comes later in the file and wins.
+    std::sort(entries, entries + m_count,
+              [] (const Entry &a, const Entry &b) {
+                  int res = strcmp(a.first, b.first);
+                  return res < 0 || (res == 0 && a.first > b.first);
+              });
+    m_count = std::unique(entries, entries + m_count,
+                          [] (const Entry &a, const Entry &b) {
+                              return strcmp(a.first, b.first) == 0;
+                          }) - entries;
+}
+
+QTC_EXPORT const char*
+RcFile::value(const char *key) const
+{
+    QTC_RET_IF_FAIL(key, nullptr);
+    const Entry *begin = m_entries.get();
+    const Entry *end = begin + m_count;
+    const Entry *it = std::lower_bound(begin, end, key,
+                                       [] (const Entry &a, const char *key) {
+                                           return strcmp(a.first, key) < 0;
+                                       });
+    if (it == end || strcmp(it->first, key) != 0) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+QTC_EXPORT int
+RcFile::intValue(const char *key, int def) const
+{
+    const char *str = value(key);
+    return str && str[0] ? atoi(str) : def;
+}
+
+QTC_EXPORT bool
+RcFile::boolValue(const char *key, bool def) const
+{
+    const char *str = value(key);
+    return str && str[0] ? strcmp(str, "true") == 0 : def;
+}
+
+QTC_EXPORT int
+RcFile::versionValue(const char *key) const
+{
+    const char *str = value(key);
+    int major, minor, patch;
+    return (str && sscanf(str, "%d.%d.%d", &major, &minor, &patch) == 3 ?
+            qtcMakeVersion(major, minor, patch) : 0);
+}
+
+}
+}
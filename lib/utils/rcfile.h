@@ -0,0 +1,104 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#ifndef QTC_UTILS_RCFILE_H
+#define QTC_UTILS_RCFILE_H
+
+#include "options.h"
+#include "utils.h"
+
+#include <utility>
+
+namespace QtCurve {
+namespace Config {
+
+/**
+ * A QtCurve style config file (`stylerc`), tokenized once into a flat table.
+ *
+ * The whole file is read into a single buffer and every `key=value` line is
+ * split in place, so a lookup is a binary search over the sorted keys with no
+ * further allocation. Like the toolkit specific parsers this replaces, group
+ * headers are ignored. If a key is repeated, the last value wins.
+ *
+ * The buffers come from the thread's Arena, in a scope that ends with the
+ * RcFile, so it has to be a local variable (or otherwise be destroyed in
+ * the reverse order of the other scopes of the thread).
+ */
+class RcFile {
+public:
+    RcFile(const char *path=nullptr);
+    RcFile(const RcFile&) = delete;
+    RcFile &operator=(const RcFile&) = delete;
+
+    bool load(const char *path);
+    /**
+     * Parse \param len bytes of \param str as the content of a config file.
+     */
+    void parse(const char *str, size_t len);
+
+    bool
+    ok() const
+    {
+        return m_count;
+    }
+    size_t
+    size() const
+    {
+        return m_count;
+    }
+    /**
+     * The raw value of \param key or `nullptr` if it is not set.
+     */
+    const char *value(const char *key) const;
+    bool
+    hasKey(const char *key) const
+    {
+        return value(key);
+    }
+    /**
+     * Look up an enum value with the `loadValue` table of its type.
+     */
+    template<typename T>
+    T
+    value(const char *key, T def) const
+    {
+        return loadValue<T>(value(key), def);
+    }
+    int intValue(const char *key, int def) const;
+    bool boolValue(const char *key, bool def) const;
+    /**
+     * Parse a `major.minor.patch` entry, returns 0 if it is not valid.
+     */
+    int versionValue(const char *key) const;
+private:
+    typedef std::pair<const char*, const char*> Entry;
+    void split(size_t len);
+    // Has to be constructed before and destroyed after the buffers.
+    Arena::Scope m_scope;
+    LocalBuff<char, 1, ArenaAlloc> m_buff;
+    LocalBuff<Entry, 1, ArenaAlloc> m_entries;
+    size_t m_count;
+};
+
+}
+}
+
+#endif
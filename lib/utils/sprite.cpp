@@ -0,0 +1,221 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include "sprite.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <math.h>
+
+namespace QtCurve {
+
+static inline uint32_t
+argb(int a, int r, int g, int b)
+{
+    return (uint32_t)a << 24 | (uint32_t)r << 16 | (uint32_t)g << 8 | b;
+}
+
+static inline int
+channel(uint32_t pixel, int shift)
+{
+    return (pixel >> shift) & 0xff;
+}
+
+static inline int
+premultiply(int c, int a)
+{
+    // Exact rounding of c * a / 255
+    int t = c * a + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+size_t
+SpriteAtlas::KeyHash::operator()(const Key &key) const
+{
+    return (std::hash<int>()(key.glyph) ^
+            (std::hash<uint32_t>()(key.rgb) << 1) ^
+            (std::hash<double>()(key.shade) << 2) ^
+            (std::hash<double>()(key.scale) << 3));
+}
+
+QTC_EXPORT
+SpriteAtlas::SpriteAtlas(int width, int maxHeight)
+    : m_width(width),
+      m_maxHeight(maxHeight),
+      m_height(0),
+      m_rowX(0),
+      m_rowY(0),
+      m_rowHeight(0),
+      m_generation(0)
+{
+}
+
+QTC_EXPORT int
+SpriteAtlas::addGlyph(const unsigned char *data, int w, int h, int stride,
+                      QtcPixelByteOrder order)
+{
+    Glyph glyph = {w, h, std::vector<uint32_t>(w * h)};
+    for (int y = 0;y < h;y++) {
+        const unsigned char *line = data + y * stride;
+        for (int x = 0;x < w;x++) {
+            const unsigned char *p = line + x * 4;
+            uint32_t &pixel = glyph.pixels[y * w + x];
+            switch (order) {
+            case QTC_PIXEL_ARGB:
+                pixel = argb(p[0], p[1], p[2], p[3]);
+                break;
+            case QTC_PIXEL_BGRA:
+                pixel = argb(p[3], p[2], p[1], p[0]);
+                break;
+            default:
+            case QTC_PIXEL_RGBA:
+                pixel = argb(p[3], p[0], p[1], p[2]);
+                break;
+            }
+        }
+    }
+    m_glyphs.push_back(std::move(glyph));
+    return m_glyphs.size() - 1;
+}
+
+QTC_EXPORT void
+SpriteAtlas::clear()
+{
+    m_cells.clear();
+    std::fill(m_pixels.begin(), m_pixels.end(), 0);
+    m_rowX = m_rowY = m_rowHeight = 0;
+    m_generation++;
+}
+
+void
+SpriteAtlas::allocate(int w, int h, Cell *cell)
+{
+    if (m_rowX + w > m_width) {
+        m_rowY += m_rowHeight;
+        m_rowX = m_rowHeight = 0;
+    }
+    if (m_rowY + h > m_height) {
+        int height = qtcMax(m_height * 2, m_rowY + h);
+        if (height > m_maxHeight) {
+            if (m_rowY > 0) {
+                clear();
+                allocate(w, h, cell);
+                return;
+            }
+            // A single row always fits.
+            height = m_rowY + h;
+        }
+        m_pixels.resize(m_width * height, 0);
+        m_height = height;
+        m_generation++;
+    }
+    *cell = Cell{m_rowX, m_rowY, w, h};
+    m_rowX += w;
+    m_rowHeight = qtcMax(m_rowHeight, h);
+}
+
+void
+SpriteAtlas::render(const Glyph &glyph, const Key &key, const Cell &cell)
+{
+    // Tint and premultiply at the size of the glyph first.
+    int tr = qtcBound(0, int(channel(key.rgb, 16) * key.shade + 0.5), 255);
+    int tg = qtcBound(0, int(channel(key.rgb, 8) * key.shade + 0.5), 255);
+    int tb = qtcBound(0, int(channel(key.rgb, 0) * key.shade + 0.5), 255);
+    std::vector<uint32_t> tinted(glyph.pixels.size());
+    for (size_t i = 0;i < tinted.size();i++) {
+        uint32_t pixel = glyph.pixels[i];
+        int source = channel(pixel, 8);
+        int a = channel(pixel, 24);
+        tinted[i] = argb(a, premultiply(qtcBound(0, tr - source, 255), a),
+                         premultiply(qtcBound(0, tg - source, 255), a),
+                         premultiply(qtcBound(0, tb - source, 255), a));
+    }
+    uint32_t *dest = m_pixels.data() + cell.y * m_width + cell.x;
+    if (cell.width == glyph.width && cell.height == glyph.height) {
+        for (int y = 0;y < cell.height;y++) {
+            std::copy_n(tinted.data() + y * glyph.width, glyph.width,
+                        dest + y * m_width);
+        }
+        return;
+    }
+    // Bilinear scaling, done on premultiplied pixels so that the transparent
+    // ones do not bleed their color into the edges.
+    const double sx = double(glyph.width) / cell.width;
+    const double sy = double(glyph.height) / cell.height;
+    for (int y = 0;y < cell.height;y++) {
+        double fy = qtcBound(0.0, (y + 0.5) * sy - 0.5, glyph.height - 1.0);
+        int y0 = int(fy);
+        int y1 = qtcMin(y0 + 1, glyph.height - 1);
+        double wy = fy - y0;
+        for (int x = 0;x < cell.width;x++) {
+            double fx = qtcBound(0.0, (x + 0.5) * sx - 0.5,
+                                 glyph.width - 1.0);
+            int x0 = int(fx);
+            int x1 = qtcMin(x0 + 1, glyph.width - 1);
+            double wx = fx - x0;
+            uint32_t p00 = tinted[y0 * glyph.width + x0];
+            uint32_t p01 = tinted[y0 * glyph.width + x1];
+            uint32_t p10 = tinted[y1 * glyph.width + x0];
+            uint32_t p11 = tinted[y1 * glyph.width + x1];
+            uint32_t res = 0;
+            for (int shift = 0;shift < 32;shift += 8) {
+                double top = (channel(p00, shift) * (1 - wx) +
+                              channel(p01, shift) * wx);
+                double bottom = (channel(p10, shift) * (1 - wx) +
+                                 channel(p11, shift) * wx);
+                uint32_t c = int(top * (1 - wy) + bottom * wy + 0.5);
+                res |= c << shift;
+            }
+            dest[y * m_width + x] = res;
+        }
+    }
+}
+
+QTC_EXPORT const SpriteAtlas::Cell&
+SpriteAtlas::get(int glyph, int r, int g, int b, double shade, double scale)
+{
+    static const Cell empty = {0, 0, 0, 0};
+    if (glyph < 0 || size_t(glyph) >= m_glyphs.size()) {
+        return empty;
+    }
+    const Key key = {glyph, argb(0, qtcBound(0, r, 255), qtcBound(0, g, 255),
+                                 qtcBound(0, b, 255)), shade, scale};
+    auto it = m_cells.find(key);
+    Stats::countCache(it != m_cells.end());
+    if (it != m_cells.end()) {
+        return it->second;
+    }
+    const Glyph &source = m_glyphs[glyph];
+    int w = qtcMax(1, int(lround(source.width * scale)));
+    int h = qtcMax(1, int(lround(source.height * scale)));
+    if (w > m_width) {
+        // Too large to share the atlas, nothing sensible to draw.
+        return empty;
+    }
+    Cell cell;
+    allocate(w, h, &cell);
+    render(source, key, cell);
+    m_generation++;
+    Stats::add(Stats::Counter::PixmapBytes, w * h * 4);
+    return m_cells.emplace(key, cell).first->second;
+}
+
+}
@@ -0,0 +1,151 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#ifndef _QTC_UTILS_SPRITE_H_
+#define _QTC_UTILS_SPRITE_H_
+
+#include "color.h"
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \file sprite.h
+ * \brief Atlas of tinted indicator sprites (e.g. check marks).
+ *
+ * The pixels are premultiplied ARGB32 in native byte order, which is both
+ * QImage::Format_ARGB32_Premultiplied and CAIRO_FORMAT_ARGB32, so the Qt and
+ * the Gtk styles can wrap the whole atlas once and blit cells out of it.
+ */
+
+namespace QtCurve {
+
+class SpriteAtlas {
+public:
+    struct Cell {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+    struct Key {
+        int glyph;
+        uint32_t rgb;
+        double shade;
+        double scale;
+        bool
+        operator==(const Key &other) const
+        {
+            return (glyph == other.glyph && rgb == other.rgb &&
+                    shade == other.shade && scale == other.scale);
+        }
+    };
+    /**
+     * \param width the width of the atlas in pixels, cells are packed into
+     * rows of this width.
+     * \param maxHeight the atlas is cleared instead of growing beyond this.
+     */
+    explicit SpriteAtlas(int width=256, int maxHeight=1024);
+    SpriteAtlas(const SpriteAtlas&) = delete;
+    SpriteAtlas &operator=(const SpriteAtlas&) = delete;
+
+    /**
+     * Register an untinted 4 channel glyph and return its id. The glyph is
+     * tinted like qtcAdjustPix() does, i.e. the color of each pixel is the
+     * tint minus its green channel and the alpha channel is kept.
+     */
+    int addGlyph(const unsigned char *data, int w, int h, int stride,
+                 QtcPixelByteOrder order);
+    /**
+     * The cell of \param glyph tinted with \param r, \param g, \param b
+     * multiplied by \param shade and rendered at \param scale times its
+     * size. The cell is created the first time it is asked for.
+     */
+    const Cell &get(int glyph, int r, int g, int b, double shade=1.0,
+                    double scale=1.0);
+    /**
+     * Drop all cells (but not the glyphs).
+     */
+    void clear();
+    const unsigned char*
+    data() const
+    {
+        return (const unsigned char*)m_pixels.data();
+    }
+    int
+    width() const
+    {
+        return m_width;
+    }
+    int
+    height() const
+    {
+        return m_height;
+    }
+    int
+    stride() const
+    {
+        return m_width * 4;
+    }
+    /**
+     * Changes whenever the pixels change (a cell is added, the atlas grows or
+     * is cleared), anything copying or wrapping data() has to be refreshed
+     * when it does.
+     */
+    unsigned
+    generation() const
+    {
+        return m_generation;
+    }
+    size_t
+    size() const
+    {
+        return m_cells.size();
+    }
+private:
+    struct Glyph {
+        int width;
+        int height;
+        // native ARGB32, not premultiplied
+        std::vector<uint32_t> pixels;
+    };
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+    void allocate(int w, int h, Cell *cell);
+    void render(const Glyph &glyph, const Key &key, const Cell &cell);
+
+    int m_width;
+    int m_maxHeight;
+    int m_height;
+    // next free position, in the row starting at m_rowY
+    int m_rowX;
+    int m_rowY;
+    int m_rowHeight;
+    unsigned m_generation;
+    std::vector<uint32_t> m_pixels;
+    std::vector<Glyph> m_glyphs;
+    std::unordered_map<Key, Cell, KeyHash> m_cells;
+};
+
+}
+
+#endif
@@ -0,0 +1,201 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include "stats.h"
+#include "strs.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+namespace QtCurve {
+namespace Stats {
+
+namespace {
+
+static const char *const counter_names[] = {
+    [(int)Counter::PixmapHit] = "pixmap_cache.hits",
+    [(int)Counter::PixmapMiss] = "pixmap_cache.misses",
+    [(int)Counter::PixmapBytes] = "pixmap_cache.bytes",
+    [(int)Counter::X11RoundTrip] = "x11.round_trips",
+    [(int)Counter::ConfigLoad] = "config.loads",
+    [(int)Counter::ConfigLoadTime] = "config.load_time_us",
+};
+static_assert(sizeof(counter_names) / sizeof(counter_names[0]) ==
+              (size_t)Counter::_Count, "Missing counter names");
+
+static std::atomic<uint64_t> counters[(int)Counter::_Count];
+
+static const char *const draw_names[] = {
+    [(int)Draw::Primitive] = "primitive",
+    [(int)Draw::Control] = "control",
+    [(int)Draw::ComplexControl] = "complex_control",
+};
+static_assert(sizeof(draw_names) / sizeof(draw_names[0]) ==
+              (size_t)Draw::_Count, "Missing draw type names");
+
+// The standard Qt elements are small enums, so they are counted in fixed
+// arrays without a lock. Custom elements (and the string keyed Gtk types)
+// go to the map below.
+static constexpr int max_draw_element = 128;
+static std::atomic<uint64_t>
+    draw_counters[(int)Draw::_Count][max_draw_element];
+
+struct DrawCounts {
+    std::mutex lock;
+    // keyed by the address of the type name
+    std::map<std::pair<const char*, int>, uint64_t> counts;
+};
+
+static DrawCounts&
+drawCounts()
+{
+    static DrawCounts *counts = new DrawCounts;
+    return *counts;
+}
+
+// nullptr if stats are off or no file is configured.
+static const std::string*
+statsFile()
+{
+    static const std::string *file = [] () -> const std::string* {
+        const char *env = getenv("QTCURVE_STATS");
+        if (!env || !Str::convert(env, true) || Str::convert(env, false)) {
+            return nullptr;
+        }
+        std::string *res = new std::string(env);
+        size_t pos = res->find("%p");
+        if (pos != std::string::npos) {
+            res->replace(pos, 2, std::to_string(getpid()));
+        }
+        return res;
+    }();
+    return file;
+}
+
+}
+
+QTC_EXPORT bool
+enabled()
+{
+    static bool _enabled = [] {
+        if (!Str::convert(getenv("QTCURVE_STATS"), true)) {
+            return false;
+        }
+        if (statsFile()) {
+            atexit([] {dump();});
+        }
+        return true;
+    }();
+    return _enabled;
+}
+
+QTC_EXPORT void
+_add(Counter counter, uint64_t n)
+{
+    counters[(int)counter].fetch_add(n, std::memory_order_relaxed);
+}
+
+QTC_EXPORT void
+_countDraw(const char *type, int element)
+{
+    DrawCounts &draws = drawCounts();
+    std::lock_guard<std::mutex> guard(draws.lock);
+    draws.counts[{type, element}]++;
+}
+
+QTC_EXPORT void
+_countDraw(Draw type, int element)
+{
+    if (element >= 0 && element < max_draw_element) {
+        draw_counters[(int)type][element].fetch_add(
+            1, std::memory_order_relaxed);
+    } else {
+        _countDraw(draw_names[(int)type], element);
+    }
+}
+
+QTC_EXPORT std::string
+report()
+{
+    std::string res;
+    auto append = [&] (const std::string &name, uint64_t val) {
+        res += name;
+        res += ' ';
+        res += std::to_string(val);
+        res += '\n';
+    };
+    append("pid", getpid());
+    for (int i = 0;i < (int)Counter::_Count;i++) {
+        append(counter_names[i], counters[i].load(std::memory_order_relaxed));
+    }
+    // the same name may come from different libraries
+    std::map<std::pair<std::string, int>, uint64_t> by_name;
+    for (int type = 0;type < (int)Draw::_Count;type++) {
+        for (int element = 0;element < max_draw_element;element++) {
+            uint64_t count = draw_counters[type][element].load(
+                std::memory_order_relaxed);
+            if (count) {
+                by_name[{draw_names[type], element}] += count;
+            }
+        }
+    }
+    {
+        DrawCounts &draws = drawCounts();
+        std::lock_guard<std::mutex> guard(draws.lock);
+        for (auto &draw: draws.counts) {
+            by_name[{draw.first.first, draw.first.second}] += draw.second;
+        }
+    }
+    for (auto &draw: by_name) {
+        std::string name = "draw." + draw.first.first;
+        if (draw.first.second >= 0) {
+            name += '.';
+            name += std::to_string(draw.first.second);
+        }
+        append(name, draw.second);
+    }
+    return res;
+}
+
+QTC_EXPORT bool
+dump(const char *fname)
+{
+    if (!fname) {
+        const std::string *file = statsFile();
+        QTC_RET_IF_FAIL(file, false);
+        fname = file->c_str();
+    }
+    FILE *file = fopen(fname, "w");
+    if (!file) {
+        qtcError("Cannot write statistics to %s\n", fname);
+        return false;
+    }
+    const std::string res = report();
+    fwrite(res.data(), 1, res.size(), file);
+    return fclose(file) == 0;
+}
+
+}
+}
@@ -0,0 +1,144 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#ifndef _QTC_UTILS_STATS_H_
+#define _QTC_UTILS_STATS_H_
+
+#include "timer.h"
+#include <string>
+
+/**
+ * \file stats.h
+ * \brief Per process counters of what the style spends its time on.
+ *
+ * Counting is off unless QTCURVE_STATS is set. If it is set to a file name
+ * (a "%p" in it is replaced by the pid) a report is written there at exit,
+ * the Qt styles also export the report on the session bus as
+ * org.kde.QtCurve.Stats.report at /QtCurve/Stats.
+ */
+
+namespace QtCurve {
+namespace Stats {
+
+enum class Counter {
+    PixmapHit,
+    PixmapMiss,
+    // size of the pixmaps added to the caches
+    PixmapBytes,
+    X11RoundTrip,
+    ConfigLoad,
+    ConfigLoadTime,
+    _Count
+};
+
+// Element types of the Qt styles, counted without locking.
+enum class Draw {
+    Primitive,
+    Control,
+    ComplexControl,
+    _Count
+};
+
+bool enabled();
+void _add(Counter counter, uint64_t n);
+void _countDraw(const char *type, int element);
+void _countDraw(Draw type, int element);
+
+static inline void
+add(Counter counter, uint64_t n=1)
+{
+    if (qtcUnlikely(enabled())) {
+        _add(counter, n);
+    }
+}
+
+static inline void
+countCache(bool hit)
+{
+    add(hit ? Counter::PixmapHit : Counter::PixmapMiss);
+}
+
+/**
+ * Count a draw call. \param type has to be a string with static storage
+ * (e.g. a literal or __func__) and \param element may be -1 if the type is
+ * not further divided.
+ */
+static inline void
+countDraw(const char *type, int element=-1)
+{
+    if (qtcUnlikely(enabled())) {
+        _countDraw(type, element);
+    }
+}
+
+/**
+ * Count a draw call of a Qt style element, \param element is the value of
+ * the PrimitiveElement, ControlElement or ComplexControl.
+ */
+static inline void
+countDraw(Draw type, int element)
+{
+    if (qtcUnlikely(enabled())) {
+        _countDraw(type, element);
+    }
+}
+
+/**
+ * Count one \param count event and add its duration in microseconds
+ * to \param time.
+ */
+class Timer {
+    Timer(const Timer&) = delete;
+    Counter m_count;
+    Counter m_time;
+    uint64_t m_start;
+public:
+    inline
+    Timer(Counter count, Counter time)
+        : m_count(count),
+          m_time(time),
+          m_start(enabled() ? getTime() : 0)
+    {
+    }
+    inline
+    ~Timer()
+    {
+        if (m_start) {
+            _add(m_count, 1);
+            _add(m_time, getElapse(m_start) / 1000);
+        }
+    }
+};
+
+/**
+ * Text report with one "name value" pair per line.
+ */
+std::string report();
+/**
+ * Write report() to \param fname, or to the file named by QTCURVE_STATS if
+ * it is nullptr.
+ */
+bool dump(const char *fname=nullptr);
+
+}
+}
+
+#endif
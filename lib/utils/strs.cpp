@@ -158,6 +158,33 @@ _forEach(const char *str, char delim, char escape,
         p++;
     }
 }
+
+QTC_EXPORT size_t
+unescape(std::string_view raw, char escape, char *out)
+{
+    size_t len = 0;
+    for (size_t i = 0;i < raw.size();i++) {
+        if (raw[i] == escape && escape) {
+            if (++i == raw.size()) {
+                break;
+            }
+        }
+        out[len++] = raw[i];
+    }
+    return len;
+}
+
+QTC_EXPORT size_t
+count(std::string_view str, char delim, char escape)
+{
+    size_t n = 0;
+    forEachView(str, delim, escape, [&] (std::string_view, bool) {
+            n++;
+            return true;
+        });
+    return n;
+}
+
 }
 
 }
@@ -171,8 +198,12 @@ qtcStrLoadList(const char *str, char delim, char escape, size_t size,
     size_t nele = *_nele;
     size_t offset = 0;
     if (!(buff && nele)) {
-        nele = 16;
-        buff = malloc(16 * size);
+        // size the buffer once instead of growing it element by element
+        nele = QtCurve::StrList::count(str, delim, escape);
+        if (max_len && nele > max_len) {
+            nele = max_len;
+        }
+        buff = malloc(nele * size);
     }
     QtCurve::StrList::forEach(
         str, delim, escape, [&] (const char *str, size_t len) {
@@ -29,6 +29,7 @@
 #include <numeric>
 #include <functional>
 #include <string>
+#include <string_view>
 
 namespace QtCurve {
 
@@ -136,11 +137,11 @@ cat(ArgTypes&&... strs)
     return fill(nullptr, std::forward<ArgTypes>(strs)...);
 }
 
-template<size_t N>
-class Buff : public LocalBuff<char, N> {
+template<size_t N, typename Alloc=HeapAlloc>
+class Buff : public LocalBuff<char, N, Alloc> {
 public:
     Buff(size_t size=N, const char *ary=nullptr)
-        : LocalBuff<char, N>(size, ary)
+        : LocalBuff<char, N, Alloc>(size, ary)
     {}
     Buff(const char *str)
         : Buff(str ? strlen(str) + 1 : 0, str)
@@ -154,17 +155,19 @@ public:
     printf(const char *fmt, ...)
     {
         va_list ap;
+        va_list ap2;
         va_start(ap, fmt);
-        if (this->is_static()) {
-            size_t new_size = N;
-            char *res = vformat<false>(this->m_ptr, &new_size, fmt, ap);
-            if (res != this->m_ptr) {
-                this->m_ptr = res;
-                this->m_size = new_size;
+        va_copy(ap2, ap);
+        int len = vsnprintf(this->m_ptr, this->m_size, fmt, ap);
+        if (len < 0) {
+            if (this->m_size) {
+                this->m_ptr[0] = '\0';
             }
-        } else {
-            this->m_ptr = vformat(this->m_ptr, &this->m_size, fmt, ap);
+        } else if ((size_t)len >= this->m_size) {
+            this->resize(len + 1);
+            vsnprintf(this->m_ptr, len + 1, fmt, ap2);
         }
+        va_end(ap2);
         va_end(ap);
         return this->m_ptr;
     }
@@ -276,6 +279,116 @@ forEach(const char *str, Func &&func, Args&&... args)
     forEach(str, ',', std::forward<Func>(func), std::forward<Args>(args)...);
 }
 
+/**
+ * Calls func(std::string_view raw, bool escaped) for each element of the
+ * list without copying anything. raw points into str and still contains
+ * the escape characters, escaped tells whether there are any.
+ * Splits exactly like forEach(), an empty string is a single empty element.
+ * Stops early if func returns false.
+ */
+template<typename Func>
+static inline void
+forEachView(std::string_view str, char delim, char escape, Func &&func)
+{
+    if (qtcUnlikely(escape == delim)) {
+        escape = '\0';
+    }
+    size_t start = 0;
+    while (true) {
+        bool escaped = false;
+        size_t i = start;
+        for (;i < str.size() && str[i] != delim;i++) {
+            if (escape && str[i] == escape) {
+                escaped = true;
+                i++;
+                if (i == str.size()) {
+                    break;
+                }
+            }
+        }
+        if (!func(str.substr(start, i - start), escaped) ||
+            i >= str.size()) {
+            break;
+        }
+        start = i + 1;
+    }
+}
+
+/**
+ * Copies raw to out (which has room for at least raw.size() characters)
+ * with the escape characters removed, returns the new length.
+ */
+size_t unescape(std::string_view raw, char escape, char *out);
+
+/**
+ * Number of elements forEachView() would produce.
+ */
+size_t count(std::string_view str, char delim=',', char escape='\\');
+
+/**
+ * Splits str into views. Elements that need unescaping are unescaped into
+ * arena (and NUL terminated), the rest point into str itself.
+ * Nothing is allocated unless the buffers' static sizes are too small.
+ * Views are only valid as long as str and arena are.
+ */
+template<size_t N, size_t M, typename Alloc1, typename Alloc2>
+static inline size_t
+split(std::string_view str, LocalBuff<std::string_view, N, Alloc1> &views,
+      Str::Buff<M, Alloc2> &arena, char delim=',', char escape='\\')
+{
+    size_t n = 0;
+    size_t arena_len = 0;
+    bool need_arena = false;
+    forEachView(str, delim, escape, [&] (std::string_view, bool escaped) {
+            n++;
+            need_arena |= escaped;
+            return true;
+        });
+    views.resize(n);
+    if (need_arena) {
+        // an unescaped element is never longer than the original.
+        arena.resize(str.size() + n);
+    }
+    n = 0;
+    forEachView(str, delim, escape, [&] (std::string_view raw, bool escaped) {
+            if (escaped) {
+                char *out = arena.get() + arena_len;
+                size_t len = unescape(raw, escape, out);
+                out[len] = '\0';
+                arena_len += len + 1;
+                views[n++] = std::string_view(out, len);
+            } else {
+                views[n++] = raw;
+            }
+            return true;
+        });
+    return n;
+}
+
+/**
+ * Parses up to max numbers from str into out and returns how many were
+ * stored. Elements that are not numbers are set to def.
+ * Escapes are not interpreted.
+ */
+template<typename T>
+static inline size_t
+loadNumbers(const char *str, T *out, size_t max, const T &def=T(),
+            char delim=',')
+{
+    typedef typename std::conditional<std::is_floating_point<T>::value,
+                                      double, long>::type ParseType;
+    QTC_RET_IF_FAIL(str && out, 0);
+    size_t n = 0;
+    forEachView(str, delim, '\0', [&] (std::string_view raw, bool) {
+            if (n >= max) {
+                return false;
+            }
+            out[n++] = (T)Str::convert<ParseType>(raw.data(), ParseType(def));
+            return true;
+        });
+    return n;
+}
+
 }
 }
 
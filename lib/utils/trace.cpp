@@ -0,0 +1,242 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include "trace.h"
+#include "thread.h"
+#include "number.h"
+#include <unistd.h>
+#include <signal.h>
+#include <stdio.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace QtCurve {
+namespace Trace {
+
+namespace {
+
+struct Event {
+    const char *name;
+    uint64_t start;
+    uint64_t dur;
+};
+
+struct Buffer {
+    static constexpr size_t Size = 1 << 15;
+    Event events[Size];
+    // total number of events ever recorded, the ring holds the last Size.
+    std::atomic<size_t> count;
+    unsigned tid;
+    // whether a thread is still recording into the buffer, protected by the
+    // registry lock.
+    bool in_use;
+};
+
+struct Registry {
+    std::mutex lock;
+    std::vector<Buffer*> buffers;
+    unsigned next_tid = 1;
+};
+
+// Buffers outlive their threads so that the dump can include them, until
+// a new thread reuses them. The number of buffers is therefore bounded by
+// the number of threads alive at the same time, not by the number of
+// threads ever started (e.g. by a thread pool).
+struct BufferRef {
+    Buffer *buff = nullptr;
+    ~BufferRef();
+};
+
+static Registry&
+registry()
+{
+    static Registry *reg = new Registry;
+    return *reg;
+}
+
+static ThreadLocal<BufferRef> thread_buffer;
+static uint64_t start_time = 0;
+static volatile sig_atomic_t dump_requested = 0;
+
+// nullptr if tracing is off.
+static const std::string*
+traceFile()
+{
+    static const std::string *file = [] () -> const std::string* {
+        const char *env = getenv("QTCURVE_TRACE");
+        if (!env || !*env) {
+            return nullptr;
+        }
+        std::string *res = new std::string(env);
+        size_t pos = res->find("%p");
+        if (pos != std::string::npos) {
+            res->replace(pos, 2, std::to_string(getpid()));
+        }
+        return res;
+    }();
+    return file;
+}
+
+static Buffer*
+newBuffer()
+{
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> guard(reg.lock);
+    Buffer *buff = nullptr;
+    for (Buffer *old: reg.buffers) {
+        if (!old->in_use) {
+            buff = old;
+            break;
+        }
+    }
+    if (!buff) {
+        buff = new Buffer;
+        reg.buffers.push_back(buff);
+    }
+    // Resetting under the lock keeps dump() from seeing a mixture of the
+    // events of the old and the new thread.
+    buff->count.store(0, std::memory_order_relaxed);
+    buff->tid = reg.next_tid++;
+    buff->in_use = true;
+    return buff;
+}
+
+BufferRef::~BufferRef()
+{
+    if (buff) {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> guard(reg.lock);
+        buff->in_use = false;
+    }
+}
+
+static void
+writeName(FILE *file, const char *name)
+{
+    for (;*name;name++) {
+        unsigned char c = *name;
+        if (c == '"' || c == '\\') {
+            fputc('\\', file);
+            fputc(c, file);
+        } else if (c < 0x20) {
+            fprintf(file, "\\u%04x", c);
+        } else {
+            fputc(c, file);
+        }
+    }
+}
+
+// Microseconds with nanosecond precision.
+static void
+writeTime(FILE *file, uint64_t ns)
+{
+    fprintf(file, "%" PRIu64 ".%03u", ns / 1000, unsigned(ns % 1000));
+}
+
+}
+
+QTC_EXPORT bool
+enabled()
+{
+    static bool _enabled = [] {
+        if (!traceFile()) {
+            return false;
+        }
+        start_time = getTime();
+        atexit([] {dump();});
+        struct sigaction act;
+        if (sigaction(SIGUSR2, nullptr, &act) == 0 &&
+            act.sa_handler == SIG_DFL) {
+            act = {};
+            act.sa_handler = [] (int) {dump_requested = 1;};
+            sigemptyset(&act.sa_mask);
+            act.sa_flags = SA_RESTART;
+            sigaction(SIGUSR2, &act, nullptr);
+        }
+        return true;
+    }();
+    return _enabled;
+}
+
+QTC_EXPORT void
+record(const char *name, uint64_t start, uint64_t end)
+{
+    BufferRef *ref = thread_buffer.get();
+    if (qtcUnlikely(!ref->buff)) {
+        ref->buff = newBuffer();
+    }
+    Buffer *buff = ref->buff;
+    size_t idx = buff->count.load(std::memory_order_relaxed);
+    buff->events[idx % Buffer::Size] = {name, start, end - start};
+    buff->count.store(idx + 1, std::memory_order_release);
+    // Dump from a normal context rather than from the signal handler.
+    if (qtcUnlikely(dump_requested)) {
+        dump_requested = 0;
+        dump();
+    }
+}
+
+QTC_EXPORT bool
+dump(const char *fname)
+{
+    if (!fname) {
+        const std::string *file = traceFile();
+        if (!file) {
+            return false;
+        }
+        fname = file->c_str();
+    }
+    FILE *file = fopen(fname, "w");
+    if (!file) {
+        qtcError("Cannot write trace file %s\n", fname);
+        return false;
+    }
+    const int pid = getpid();
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> guard(reg.lock);
+    const char *sep = "";
+    fputs("{\"traceEvents\":[", file);
+    for (Buffer *buff: reg.buffers) {
+        // Events of other threads may still be written to while dumping,
+        // only the ones in the oldest part of the ring can be affected.
+        size_t count = buff->count.load(std::memory_order_acquire);
+        size_t first = count > Buffer::Size ? count - Buffer::Size : 0;
+        for (size_t i = first;i < count;i++) {
+            const Event &event = buff->events[i % Buffer::Size];
+            fprintf(file, "%s\n{\"name\":\"", sep);
+            writeName(file, event.name);
+            fputs("\",\"ph\":\"X\",\"ts\":", file);
+            writeTime(file, event.start - qtcMin(start_time, event.start));
+            fputs(",\"dur\":", file);
+            writeTime(file, event.dur);
+            fprintf(file, ",\"pid\":%d,\"tid\":%u}", pid, buff->tid);
+            sep = ",";
+        }
+    }
+    fputs("\n]}\n", file);
+    return fclose(file) == 0;
+}
+
+}
+}
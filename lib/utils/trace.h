@@ -0,0 +1,87 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#ifndef _QTC_UTILS_TRACE_H_
+#define _QTC_UTILS_TRACE_H_
+
+#include <config.h>
+#include "timer.h"
+
+/**
+ * \file trace.h
+ * \brief Scoped trace points.
+ *
+ * When built with QTC_ENABLE_TRACE and run with QTCURVE_TRACE set to a file
+ * name (a "%p" in it is replaced by the pid), every QTC_TRACE_SCOPE records its name, start time, duration and
+ * thread into a per thread ring buffer (the most recent events win). The
+ * buffers are written to that file in the Chrome trace event format
+ * (loadable in chrome://tracing or Perfetto) at exit or on SIGUSR2.
+ *
+ * Without QTC_ENABLE_TRACE the macros expand to nothing.
+ */
+
+namespace QtCurve {
+namespace Trace {
+
+bool enabled();
+void record(const char *name, uint64_t start, uint64_t end);
+/**
+ * Write all recorded events to \param fname, or to the file named by
+ * QTCURVE_TRACE if it is nullptr.
+ */
+bool dump(const char *fname=nullptr);
+
+class Scope {
+    Scope(const Scope&) = delete;
+    const char *m_name;
+    uint64_t m_start;
+public:
+    // \param name has to outlive the trace, i.e. a string literal.
+    explicit inline
+    Scope(const char *name)
+        : m_name(enabled() ? name : nullptr),
+          m_start(m_name ? getTime() : 0)
+    {
+    }
+    inline
+    ~Scope()
+    {
+        if (m_name) {
+            record(m_name, m_start, getTime());
+        }
+    }
+};
+
+}
+}
+
+#define __QTC_TRACE_VAR_(n) __qtc_trace_scope_##n
+#define __QTC_TRACE_VAR(n) __QTC_TRACE_VAR_(n)
+
+#ifdef QTC_ENABLE_TRACE
+#  define QTC_TRACE_SCOPE(name)                                         \
+    QtCurve::Trace::Scope __QTC_TRACE_VAR(__COUNTER__)(name)
+#else
+#  define QTC_TRACE_SCOPE(name)
+#endif
+#define QTC_TRACE_FUNC() QTC_TRACE_SCOPE(__func__)
+
+#endif
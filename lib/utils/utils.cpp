@@ -21,6 +21,7 @@
 
 #include "utils.h"
 #include "strs.h"
+#include "thread.h"
 
 #include <config.h>
 
@@ -28,6 +29,96 @@
 
 namespace QtCurve {
 
+// A plain TLS counter, ThreadLocal would cost a pthread_getspecific per
+// allocation and can't be used before it is constructed or after the exit
+// handlers destroyed it.
+static __thread size_t heap_allocs = 0;
+
+QTC_EXPORT void
+_countHeapAlloc()
+{
+    heap_allocs++;
+}
+
+QTC_EXPORT size_t
+heapAllocCount()
+{
+    return heap_allocs;
+}
+
+// The ThreadLocal owns the arenas and frees them at thread exit, this
+// saves its pthread_getspecific on every allocation.
+static __thread Arena *local_arena = nullptr;
+
+QTC_EXPORT Arena&
+Arena::local()
+{
+    if (qtcLikely(local_arena)) {
+        return *local_arena;
+    }
+    static ThreadLocal<Arena> arena;
+    local_arena = arena.get();
+    return *local_arena;
+}
+
+// Memory kept around for reuse after all scopes have ended.
+static constexpr size_t arena_max_spare = 256 * 1024;
+
+QTC_EXPORT
+Arena::~Arena()
+{
+    if (local_arena == this) {
+        local_arena = nullptr;
+    }
+    rewind(Mark{nullptr, 0});
+    while (m_spare) {
+        Block *block = m_spare;
+        m_spare = block->prev;
+        free(block);
+    }
+}
+
+QTC_EXPORT void*
+Arena::allocSlow(size_t size)
+{
+    Block *block = nullptr;
+    for (Block **spare = &m_spare;*spare;spare = &(*spare)->prev) {
+        if ((*spare)->size >= size) {
+            block = *spare;
+            *spare = block->prev;
+            m_spare_size -= block->size;
+            break;
+        }
+    }
+    if (!block) {
+        const size_t block_size = size > 16384 ? size : 16384;
+        _countHeapAlloc();
+        block = (Block*)malloc(HeaderSize + block_size);
+        block->size = block_size;
+    }
+    block->prev = m_block;
+    m_block = block;
+    m_used = size;
+    return data(block);
+}
+
+QTC_EXPORT void
+Arena::rewind(const Mark &mark)
+{
+    while (m_block != mark.block) {
+        Block *block = m_block;
+        m_block = block->prev;
+        if (m_spare_size + block->size <= arena_max_spare) {
+            block->prev = m_spare;
+            m_spare = block;
+            m_spare_size += block->size;
+        } else {
+            free(block);
+        }
+    }
+    m_used = mark.used;
+}
+
 QTC_EXPORT const char*
 getProgName()
 {
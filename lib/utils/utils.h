@@ -175,12 +175,156 @@ struct CDeleter {
 template<typename T>
 using uniqueCPtr = std::unique_ptr<T, CDeleter>;
 
-template<typename T, size_t N>
+void _countHeapAlloc();
+
+/**
+ * Number of heap allocations done by the buffer helpers (HeapAlloc and the
+ * blocks of Arena) on the calling thread.
+ */
+size_t heapAllocCount();
+
+/**
+ * Allocator of LocalBuff and Str::Buff, memory from malloc.
+ */
+struct HeapAlloc {
+    static inline void*
+    alloc(size_t size)
+    {
+        _countHeapAlloc();
+        return qtcAlloc0(size);
+    }
+    static inline void*
+    realloc(void *p, size_t, size_t size)
+    {
+        _countHeapAlloc();
+        return ::realloc(p, size);
+    }
+    static inline void
+    free(void *p, size_t)
+    {
+        ::free(p);
+    }
+};
+
+/**
+ * Thread local bump allocator for short lived buffers.
+ * Memory is only given back when the innermost Arena::Scope that was open
+ * when it was allocated ends, so a buffer using it must neither outlive
+ * that scope nor grow while a nested scope is open.
+ */
+class Arena {
+    Arena(const Arena&) = delete;
+    struct Block {
+        Block *prev;
+        size_t size;
+    };
+    static constexpr size_t Align = alignof(max_align_t);
+    static constexpr size_t HeaderSize =
+        (sizeof(Block) + Align - 1) / Align * Align;
+    static inline char*
+    data(Block *block)
+    {
+        return (char*)block + HeaderSize;
+    }
+    Block *m_block;
+    size_t m_used;
+    // blocks released by rewind(), reused before allocating new ones.
+    Block *m_spare;
+    size_t m_spare_size;
+    void *allocSlow(size_t size);
+public:
+    struct Mark {
+        Block *block;
+        size_t used;
+    };
+    class Scope {
+        Scope(const Scope&) = delete;
+    public:
+        Scope(Arena &arena=Arena::local())
+            : m_arena(arena),
+              m_mark(arena.mark())
+        {}
+        ~Scope()
+        {
+            m_arena.rewind(m_mark);
+        }
+    private:
+        Arena &m_arena;
+        Mark m_mark;
+    };
+    Arena()
+        : m_block(nullptr),
+          m_used(0),
+          m_spare(nullptr),
+          m_spare_size(0)
+    {}
+    ~Arena();
+    static Arena &local();
+    inline void*
+    alloc(size_t size)
+    {
+        size = (size + Align - 1) / Align * Align;
+        if (qtcLikely(m_block && m_used + size <= m_block->size)) {
+            void *p = data(m_block) + m_used;
+            m_used += size;
+            return p;
+        }
+        return allocSlow(size);
+    }
+    inline void*
+    realloc(void *p, size_t old_size, size_t size)
+    {
+        if (!p) {
+            return alloc(size);
+        }
+        old_size = (old_size + Align - 1) / Align * Align;
+        size_t new_size = (size + Align - 1) / Align * Align;
+        if (m_block && (char*)p + old_size == data(m_block) + m_used &&
+            m_used - old_size + new_size <= m_block->size) {
+            // last allocation, grow or shrink in place
+            m_used = m_used - old_size + new_size;
+            return p;
+        }
+        void *res = alloc(size);
+        memcpy(res, p, old_size < size ? old_size : size);
+        return res;
+    }
+    inline Mark
+    mark() const
+    {
+        return Mark{m_block, m_used};
+    }
+    void rewind(const Mark &mark);
+};
+
+/**
+ * Allocator of LocalBuff and Str::Buff, memory from the thread's Arena.
+ */
+struct ArenaAlloc {
+    static inline void*
+    alloc(size_t size)
+    {
+        void *p = Arena::local().alloc(size);
+        memset(p, 0, size);
+        return p;
+    }
+    static inline void*
+    realloc(void *p, size_t old_size, size_t size)
+    {
+        return Arena::local().realloc(p, old_size, size);
+    }
+    static inline void
+    free(void*, size_t)
+    {
+    }
+};
+
+template<typename T, size_t N, typename Alloc=HeapAlloc>
 class LocalBuff {
     LocalBuff(const LocalBuff&) = delete;
 public:
     LocalBuff(size_t size=N, const T *ary=nullptr)
-        : m_ptr(size > N ? qtcNew(T, size) : m_static_buf),
+        : m_ptr(size > N ? (T*)Alloc::alloc(sizeof(T) * size) : m_static_buf),
           m_size(size),
           m_static_buf{}
     {
@@ -198,11 +342,12 @@ public:
     {
         if (is_static()) {
             if (size > N) {
-                m_ptr = qtcNew(T, size);
+                m_ptr = (T*)Alloc::alloc(sizeof(T) * size);
                 memcpy(m_ptr, m_static_buf, sizeof(T) * m_size);
             }
         } else {
-            m_ptr = (T*)realloc(m_ptr, sizeof(T) * size);
+            m_ptr = (T*)Alloc::realloc(m_ptr, sizeof(T) * m_size,
+                                       sizeof(T) * size);
         }
         m_size = size;
     }
@@ -224,7 +369,7 @@ public:
     ~LocalBuff()
     {
         if (!is_static()) {
-            free(m_ptr);
+            Alloc::free(m_ptr, sizeof(T) * m_size);
         }
     }
 protected:
@@ -34,6 +34,7 @@ static int shadow_size = 30;
 #include "log.h"
 #include "number.h"
 #include "shadow_p.h"
+#include "trace.h"
 #include "x11utils_p.h"
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
@@ -77,6 +78,7 @@ qtcX11ShadowCreatePixmap(const QtCurve::Image *data)
 void
 qtcX11ShadowInit()
 {
+    QTC_TRACE_FUNC();
     int shadow_radius = 4;
     QtcColor c1 = {0.4, 0.4, 0.4};
     QtcColor c2 = {0.2, 0.2, 0.2};
@@ -112,6 +114,7 @@ qtcX11ShadowDestroy()
 QTC_EXPORT void
 qtcX11ShadowInstall(xcb_window_t win, const int margins[4])
 {
+    QTC_TRACE_FUNC();
     QTC_RET_IF_FAIL(win);
     if (qtcUnlikely(!margins)) {
         qtcX11ShadowInstall(win);
@@ -143,6 +146,7 @@ qtcX11ShadowInstall(xcb_window_t win, const int margins[4])
 QTC_EXPORT void
 qtcX11ShadowInstall(xcb_window_t win)
 {
+    QTC_TRACE_FUNC();
     QTC_RET_IF_FAIL(win);
     // In principle, I should check for _KDE_NET_WM_SHADOW in _NET_SUPPORTED.
     // However, it's complicated and we will gain nothing.
@@ -160,6 +164,7 @@ qtcX11ShadowInstall(xcb_window_t win)
 QTC_EXPORT void
 qtcX11ShadowUninstall(xcb_window_t win)
 {
+    QTC_TRACE_FUNC();
     QTC_RET_IF_FAIL(win);
     qtcX11CallVoid(delete_property, win, qtc_x11_kde_net_wm_shadow);
     qtcX11Flush();
@@ -169,6 +174,7 @@ qtcX11ShadowUninstall(xcb_window_t win)
 QTC_EXPORT void
 qtcX11MoveTrigger(xcb_window_t wid, uint32_t x, uint32_t y)
 {
+    QTC_TRACE_FUNC();
     QTC_RET_IF_FAIL(wid);
     qtcX11FlushXlib();
     qtcX11CallVoid(ungrab_pointer, XCB_TIME_CURRENT_TIME);
@@ -200,6 +206,7 @@ QTC_EXPORT void
 qtcX11BlurTrigger(xcb_window_t wid, bool enable, unsigned prop_num,
                   const uint32_t *props)
 {
+    QTC_TRACE_FUNC();
     QTC_RET_IF_FAIL(wid);
     xcb_atom_t atom = qtc_x11_kde_net_wm_blur_behind_region;
     if (enable) {
@@ -224,6 +231,7 @@ qtcX11BlurTrigger(xcb_window_t wid, bool enable, unsigned prop_num,
 QTC_EXPORT int32_t
 qtcX11GetShortProp(xcb_window_t win, xcb_atom_t atom)
 {
+    QTC_TRACE_FUNC();
     QTC_RET_IF_FAIL(qtc_xcb_conn && win, -1);
     int32_t res = -1;
     xcb_get_property_reply_t *reply =
@@ -242,6 +250,7 @@ qtcX11GetShortProp(xcb_window_t win, xcb_atom_t atom)
 static inline void
 qtcX11SetShortProp(xcb_window_t win, xcb_atom_t atom, unsigned short prop)
 {
+    QTC_TRACE_FUNC();
     qtcX11ChangeProperty(XCB_PROP_MODE_REPLACE, win, atom,
                          XCB_ATOM_CARDINAL, 16, 1, &prop);
     qtcX11Flush();
@@ -268,6 +277,7 @@ qtcX11SetOpacity(xcb_window_t win, unsigned short o)
 QTC_EXPORT void
 qtcX11SetBgnd(xcb_window_t win, uint32_t prop)
 {
+    QTC_TRACE_FUNC();
     qtcX11ChangeProperty(XCB_PROP_MODE_REPLACE, win, qtc_x11_qtc_bgnd,
                          XCB_ATOM_CARDINAL, 32, 1, &prop);
     qtcX11Flush();
@@ -38,6 +38,7 @@ QTC_EXPORT xcb_atom_t qtc_x11_qtc_bgnd;
 #include "x11shadow_p.h"
 #include "x11wrap.h"
 #include "log.h"
+#include "trace.h"
 #include "x11utils_p.h"
 #include <X11/Xlib-xcb.h>
 // #include <X11/Xutil.h>
@@ -199,6 +200,7 @@ qtcX11MapRaised(xcb_window_t win)
 QTC_EXPORT bool
 qtcX11CompositingActive()
 {
+    QTC_TRACE_FUNC();
     QTC_RET_IF_FAIL(qtc_xcb_conn, false);
     xcb_get_selection_owner_reply_t *reply =
         qtcX11Call(get_selection_owner, qtc_x11_net_wm_cm_s_default);
@@ -211,6 +213,7 @@ qtcX11CompositingActive()
 QTC_EXPORT bool
 qtcX11HasAlpha(xcb_window_t win)
 {
+    QTC_TRACE_FUNC();
     QTC_RET_IF_FAIL(qtc_xcb_conn && win, false);
     if (!qtcX11CompositingActive()) {
         return false;
@@ -225,6 +228,7 @@ qtcX11HasAlpha(xcb_window_t win)
 QTC_EXPORT bool
 qtcX11IsEmbed(xcb_window_t win)
 {
+    QTC_TRACE_FUNC();
     QTC_RET_IF_FAIL(qtc_xcb_conn && win, false);
     xcb_get_property_reply_t *reply =
         qtcX11GetProperty(0, win, qtc_x11_xembed_info,
@@ -20,6 +20,7 @@
  *****************************************************************************/
 
 #include "x11utils.h"
+#include "stats.h"
 
 #ifndef _QTC_UTILS_X11UTILS_P_H_
 #define _QTC_UTILS_X11UTILS_P_H_
@@ -42,6 +43,7 @@ _qtcX11Call(Cookie (*func)(xcb_connection_t*, Args...),
 {
     xcb_connection_t *conn = qtc_xcb_conn;
     QTC_RET_IF_FAIL(conn, nullptr);
+    QtCurve::Stats::add(QtCurve::Stats::Counter::X11RoundTrip);
     Cookie cookie = func(conn, args...);
     return reply_func(conn, cookie, 0);
 }
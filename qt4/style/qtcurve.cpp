@@ -3369,15 +3369,15 @@ QIcon Style::standardIconImplementation(StandardPixmap pix, const QStyleOption *
 #ifndef QTC_QT4_ENABLE_KDE
         case SP_MessageBoxQuestion:
         case SP_MessageBoxInformation: {
-            static QIcon icn(QPixmap::fromImage(qtc_dialog_information));
+            static QIcon icn(QPixmap::fromImage(qtc_dialog_information()));
             return icn;
         }
         case SP_MessageBoxWarning: {
-            static QIcon icn(QPixmap::fromImage(qtc_dialog_warning));
+            static QIcon icn(QPixmap::fromImage(qtc_dialog_warning()));
             return icn;
         }
         case SP_MessageBoxCritical: {
-            static QIcon icn(QPixmap::fromImage(qtc_dialog_error));
+            static QIcon icn(QPixmap::fromImage(qtc_dialog_error()));
             return icn;
         }
 /*
@@ -13211,9 +13211,9 @@ QPixmap * Style::getPixmap(const QColor col, EPixmap p, double shade) const
             switch (p) {
             case PIX_CHECK:
                 if(opts.xCheck)
-                    img = qtc_check_x_on;
+                    img = qtc_check_x_on();
                 else
-                    img = qtc_check_on;
+                    img = qtc_check_on();
                 break;
             default:
                 break;
@@ -329,12 +329,6 @@ typedef enum {
     TITLEBAR_BUTTON_USE_HOVER_COLOR         = 0x4000
 } ETitleBarButtonFlags;
 
-typedef enum {
-    TITLEBAR_ICON_NONE,
-    TITLEBAR_ICON_MENU_BUTTON,
-    TITLEBAR_ICON_NEXT_TO_TITLE
-} ETitleBarIcon;
-
 typedef enum {
     TITLEBAR_CLOSE,
     TITLEBAR_MIN,
@@ -363,15 +357,6 @@ typedef enum
     WINDOW_BORDER_FILL_TITLEBAR                  = 0x20
 } EWindowBorder;
 
-typedef enum
-{
-    IMG_NONE,
-    IMG_BORDERED_RINGS,
-    IMG_PLAIN_RINGS,
-    IMG_SQUARE_RINGS,
-    IMG_FILE
-} EImageType;
-
 typedef struct {
     QString   file;
     QPixmap   img;
@@ -433,13 +418,6 @@ typedef enum
     WM_DRAG_ALL              = 3
 } EWmDrag;
 
-typedef enum
-{
-    EFFECT_NONE,
-    EFFECT_ETCH,
-    EFFECT_SHADOW
-} EEffect;
-
 typedef enum {
     PIX_CHECK,
     PIX_DOT
@@ -494,54 +472,10 @@ typedef enum
     WIDGET_OTHER
 } EWidget;
 
-typedef enum {
-    APP_ALLOW_BASIC,
-    APP_ALLOW_FADE,
-    APP_ALLOW_STRIPED,
-    APP_ALLOW_NONE
-} EAppAllow;
-
 #define IS_SLIDER(w) QtCurve::oneOf(w, WIDGET_SLIDER, WIDGET_SB_SLIDER)
 #define IS_TROUGH(w) QtCurve::oneOf(w, WIDGET_SLIDER_TROUGH, WIDGET_PBAR_TROUGH, \
                               WIDGET_TROUGH, WIDGET_FILLED_SLIDER_TROUGH)
 
-typedef enum {
-    IND_CORNER,
-    IND_FONT_COLOR,
-    IND_COLORED,
-    IND_TINT,
-    IND_GLOW,
-    IND_DARKEN,
-    IND_SELECTED,
-    IND_NONE
-} EDefBtnIndicator;
-
-typedef enum
-{
-    LINE_NONE,
-    LINE_SUNKEN,
-    LINE_FLAT,
-    LINE_DOTS,
-    LINE_1DOT,
-    LINE_DASHES,
-} ELine;
-
-typedef enum
-{
-    TB_NONE,
-    TB_LIGHT,
-    TB_DARK,
-    TB_LIGHT_ALL,
-    TB_DARK_ALL
-} ETBarBorder;
-
-typedef enum
-{
-    TBTN_STANDARD,
-    TBTN_RAISED,
-    TBTN_JOINED
-} ETBarBtn;
-
 typedef enum
 {
     BORDER_FLAT,
@@ -550,34 +484,6 @@ typedef enum
     BORDER_LIGHT
 } EBorder;
 
-/*
-    This whole EShade enum is a complete mess!
-    For menubars, we dont blend - so blend is selected, and selected is darken
-    For check/radios - we dont blend, so blend is selected, and we dont allow darken
-*/
-typedef enum {
-    SHADE_NONE,
-    SHADE_CUSTOM,
-    SHADE_SELECTED,
-    SHADE_BLEND_SELECTED,
-    SHADE_DARKEN,
-    SHADE_WINDOW_BORDER
-} EShade;
-
-typedef enum {
-    ECOLOR_BASE,
-    ECOLOR_BACKGROUND,
-    ECOLOR_DARK,
-} EColor;
-
-typedef enum {
-    ROUND_NONE,
-    ROUND_SLIGHT,
-    ROUND_FULL,
-    ROUND_EXTRA,
-    ROUND_MAX
-} ERound;
-
 typedef enum {
     GB_LBL_BOLD = 0x01,
     GB_LBL_CENTRED = 0x02,
@@ -585,58 +491,6 @@ typedef enum {
     GB_LBL_OUTSIDE = 0x08
 } EGBLabel;
 
-typedef enum {
-    MO_NONE,
-    MO_COLORED,
-    MO_COLORED_THICK,
-    MO_PLASTIK,
-    MO_GLOW
-} EMouseOver;
-
-typedef enum {
-    STRIPE_NONE,
-    STRIPE_PLAIN,
-    STRIPE_DIAGONAL,
-    STRIPE_FADE
-} EStripe;
-
-typedef enum {
-    SLIDER_PLAIN,
-    SLIDER_ROUND,
-    SLIDER_PLAIN_ROTATED,
-    SLIDER_ROUND_ROTATED,
-    SLIDER_TRIANGULAR,
-    SLIDER_CIRCULAR
-} ESliderStyle;
-
-typedef enum {
-    FOCUS_STANDARD,
-    FOCUS_RECTANGLE,
-    FOCUS_FULL,
-    FOCUS_FILLED,
-    FOCUS_LINE,
-    FOCUS_GLOW,
-    FOCUS_NONE
-} EFocus;
-
-typedef enum {
-    TAB_MO_TOP,
-    TAB_MO_BOTTOM,
-    TAB_MO_GLOW
-} ETabMo;
-
-typedef enum {
-    GT_HORIZ,
-    GT_VERT
-} EGradType;
-
-typedef enum {
-    GLOW_NONE,
-    GLOW_START,
-    GLOW_MIDDLE,
-    GLOW_END
-} EGlow;
-
 enum
 {
     HIDE_NONE     = 0x00,
@@ -644,13 +498,6 @@ enum
     HIDE_KWIN     = 0x02
 };
 
-typedef enum {
-    ALIGN_LEFT,
-    ALIGN_CENTER,
-    ALIGN_FULL_CENTER,
-    ALIGN_RIGHT
-} EAlign;
-
 struct GradientStop {
     GradientStop(double p=0.0, double v=0.0, double a=1.0) : pos(p), val(v), alpha(a) { }
 
@@ -0,0 +1,352 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include "kdesettings.h"
+#include "qtcurve_p.h"
+#include <common/config_file.h>
+
+#include <QCoreApplication>
+#include <QFileSystemWatcher>
+#include <QFileInfo>
+#include <QPointer>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QDir>
+
+#ifdef QTC_QT5_ENABLE_KDE
+#include <KConfigCore/KSharedConfig>
+#include <KConfigCore/KConfigGroup>
+#else
+#include <QFile>
+#include <QTextStream>
+#endif
+
+namespace QtCurve {
+
+#ifdef QTC_QT5_ENABLE_KDE
+static void parseWindowLine(const QString &line, QList<int> &data)
+{
+    int len(line.length());
+
+    for(int i = 0;i < len;++i) {
+        switch(line[i].toLatin1()) {
+        case 'M':
+            data.append(QStyle::SC_TitleBarSysMenu);
+            break;
+        case '_':
+            data.append(WINDOWTITLE_SPACER);
+            break;
+        case 'H':
+            data.append(QStyle::SC_TitleBarContextHelpButton);
+            break;
+        case 'L':
+            data.append(QStyle::SC_TitleBarShadeButton);
+            break;
+        case 'I':
+            data.append(QStyle::SC_TitleBarMinButton);
+            break;
+        case 'A':
+            data.append(QStyle::SC_TitleBarMaxButton);
+            break;
+        case 'X':
+            data.append(QStyle::SC_TitleBarCloseButton);
+        default:
+            break;
+        }
+    }
+}
+
+static QString
+kdeGlobalsFile()
+{
+    return QStandardPaths::locate(QStandardPaths::GenericConfigLocation,
+                                  QStringLiteral("kdeglobals"));
+}
+#else
+static void
+setRgb(QColor *col, const QStringList &rgb)
+{
+    if (rgb.size() == 3) {
+        *col = QColor(rgb[0].toInt(), rgb[1].toInt(), rgb[2].toInt());
+    }
+}
+
+static QString
+kdeHome()
+{
+    static QString kdeHomePath;
+    if (kdeHomePath.isEmpty()) {
+        kdeHomePath = QString::fromLocal8Bit(qgetenv("KDEHOME"));
+        if (kdeHomePath.isEmpty()) {
+            QDir homeDir(QDir::homePath());
+            QString kdeConfDir(QLatin1String("/.kde"));
+            if (homeDir.exists(QLatin1String(".kde4")))
+                kdeConfDir = QLatin1String("/.kde4");
+            kdeHomePath = QDir::homePath() + kdeConfDir;
+        }
+    }
+    return kdeHomePath;
+}
+
+static QString
+kdeGlobalsFile()
+{
+    return kdeHome() + "/share/config/kdeglobals";
+}
+#endif
+
+KdeSettings*
+KdeSettings::instance()
+{
+    // Owned by the application so that it goes away (and is recreated if
+    // needed) together with it.
+    static QPointer<KdeSettings> settings;
+    if (!settings) {
+        settings = new KdeSettings(QCoreApplication::instance());
+    }
+    return settings.data();
+}
+
+KdeSettings::KdeSettings(QObject *parent)
+    : QObject(parent),
+      m_watcher(new QFileSystemWatcher(this)),
+      m_contrastRead(false),
+      m_mdiButtonsRead(false),
+      m_wmColorsRead(false),
+      m_contrast(DEFAULT_CONTRAST)
+{
+    connect(m_watcher, &QFileSystemWatcher::fileChanged,
+            this, &KdeSettings::fileChanged);
+    // Files that do not exist yet can only be noticed through their
+    // directory.
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, [this] (const QString&) {
+                    const QStringList files = m_watcher->files();
+                    watchFiles();
+                    for (const QString &file: m_watcher->files()) {
+                        if (!files.contains(file)) {
+                            fileChanged(file);
+                        }
+                    }
+                });
+    watchFiles();
+}
+
+void
+KdeSettings::watchFiles()
+{
+    QStringList files = {
+#ifdef QTC_QT5_ENABLE_KDE
+        QStandardPaths::locate(QStandardPaths::GenericConfigLocation,
+                               QStringLiteral("kwinrc")),
+#endif
+        kdeGlobalsFile(),
+        QSettings(QLatin1String("Trolltech")).fileName()
+    };
+    files += qtcConfigFiles();
+    for (const QString &file: files) {
+        if (file.isEmpty()) {
+            continue;
+        }
+        QFileInfo info(file);
+        if (info.exists()) {
+            if (!m_watcher->files().contains(file)) {
+                m_watcher->addPath(file);
+            }
+        } else if (info.dir().exists() &&
+                   !m_watcher->directories().contains(info.path())) {
+            m_watcher->addPath(info.path());
+        }
+    }
+}
+
+void
+KdeSettings::fileChanged(const QString &path)
+{
+    // Config files are usually replaced rather than modified, which makes
+    // the watcher drop them, so add them back.
+    watchFiles();
+    if (qtcConfigFiles().contains(path)) {
+        emit styleConfigChanged();
+        return;
+    }
+    m_contrastRead = m_mdiButtonsRead = m_wmColorsRead = false;
+#ifdef QTC_QT5_ENABLE_KDE
+    KSharedConfig::openConfig(QStringLiteral("kwinrc"))
+        ->reparseConfiguration();
+    KSharedConfig::openConfig(QStringLiteral("kdeglobals"), KConfig::NoGlobals)
+        ->reparseConfiguration();
+#endif
+    emit changed();
+}
+
+int
+KdeSettings::contrast()
+{
+    if (!m_contrastRead) {
+        m_contrastRead = true;
+        m_contrast = QSettings(QLatin1String("Trolltech"))
+            .value("/Qt/KDE/contrast", DEFAULT_CONTRAST).toInt();
+        if (m_contrast < 0 || m_contrast > 10) {
+            m_contrast = DEFAULT_CONTRAST;
+        }
+    }
+    return m_contrast;
+}
+
+const QList<int>&
+KdeSettings::mdiButtons(int side)
+{
+    if (!m_mdiButtonsRead) {
+        m_mdiButtonsRead = true;
+        readMdiButtons();
+    }
+    return m_mdiButtons[side ? 1 : 0];
+}
+
+void
+KdeSettings::readMdiButtons()
+{
+    m_mdiButtons[0].clear();
+    m_mdiButtons[1].clear();
+#ifdef Q_OS_MACOS
+    // no control over where the system menu appears, so we have little choice
+    // but to keep it at its default position. The user can still override this.
+    m_mdiButtons[0].append(QStyle::SC_TitleBarSysMenu);
+    m_mdiButtons[0].append(QStyle::SC_TitleBarCloseButton);
+    m_mdiButtons[0].append(QStyle::SC_TitleBarMinButton);
+    m_mdiButtons[0].append(QStyle::SC_TitleBarMaxButton);
+
+    m_mdiButtons[1].append(QStyle::SC_TitleBarShadeButton);
+    m_mdiButtons[1].append(QStyle::SC_TitleBarContextHelpButton);
+#else
+    // Set defaults...
+    m_mdiButtons[0].append(QStyle::SC_TitleBarSysMenu);
+    m_mdiButtons[0].append(QStyle::SC_TitleBarShadeButton);
+
+    m_mdiButtons[1].append(QStyle::SC_TitleBarContextHelpButton);
+    m_mdiButtons[1].append(QStyle::SC_TitleBarMinButton);
+    m_mdiButtons[1].append(QStyle::SC_TitleBarMaxButton);
+    m_mdiButtons[1].append(WINDOWTITLE_SPACER);
+    m_mdiButtons[1].append(QStyle::SC_TitleBarCloseButton);
+#endif
+
+#ifdef QTC_QT5_ENABLE_KDE
+    KSharedConfigPtr cfg = KSharedConfig::openConfig("kwinrc");
+    KConfigGroup grp = cfg->group("org.kde.kdecoration2");
+
+    QString left=grp.readEntry("ButtonsOnLeft", QString()),
+        right=grp.readEntry("ButtonsOnRight", QString());
+
+    if(!left.isEmpty() || !right.isEmpty())
+        m_mdiButtons[0].clear(), m_mdiButtons[1].clear();
+
+    if(!left.isEmpty())
+        parseWindowLine(left, m_mdiButtons[0]);
+
+    if(!right.isEmpty())
+        parseWindowLine(right, m_mdiButtons[1]);
+
+    // Designer uses shade buttons, not min/max - so if we don't have shade in our kwin config. 
+    // then add this button near the max button...
+    if (-1==m_mdiButtons[0].indexOf(QStyle::SC_TitleBarShadeButton) && -1==m_mdiButtons[1].indexOf(QStyle::SC_TitleBarShadeButton)) {
+        int maxPos=m_mdiButtons[0].indexOf(QStyle::SC_TitleBarMaxButton);
+
+        if(-1==maxPos) // Left doesnt have max button, assume right does and add shade there
+        {
+            int minPos=m_mdiButtons[1].indexOf(QStyle::SC_TitleBarMinButton);
+            maxPos=m_mdiButtons[1].indexOf(QStyle::SC_TitleBarMaxButton);
+
+            m_mdiButtons[1].insert(minPos<maxPos ? (minPos==-1 ? 0 : minPos)
+                                    : (maxPos==-1 ? 0 : maxPos), QStyle::SC_TitleBarShadeButton);
+        }
+        else // Add to left button
+        {
+            int minPos=m_mdiButtons[0].indexOf(QStyle::SC_TitleBarMinButton);
+
+            m_mdiButtons[1].insert(minPos>maxPos ? (minPos==-1 ? 0 : minPos)
+                                    : (maxPos==-1 ? 0 : maxPos), QStyle::SC_TitleBarShadeButton);
+        }
+    }
+#endif
+}
+
+const KdeSettings::WMColors&
+KdeSettings::wmColors()
+{
+    if (!m_wmColorsRead) {
+        m_wmColorsRead = true;
+        readWMColors();
+    }
+    return m_wmColors;
+}
+
+void
+KdeSettings::readWMColors()
+{
+    m_wmColors = WMColors();
+#ifndef QTC_QT5_ENABLE_KDE
+    QFile f(kdeGlobalsFile());
+
+    if (f.open(QIODevice::ReadOnly)) {
+        QTextStream in(&f);
+        bool inPal = false;
+
+        while (!in.atEnd()) {
+            QString line(in.readLine());
+            if (inPal) {
+                if (line.indexOf("activeBackground=") == 0) {
+                    setRgb(&m_wmColors.activeBackground,
+                           line.mid(17).split(","));
+                } else if (line.indexOf("inactiveBackground=") == 0) {
+                    setRgb(&m_wmColors.inactiveBackground,
+                           line.mid(19).split(","));
+                } else if(line.indexOf("activeForeground=") == 0) {
+                    setRgb(&m_wmColors.activeForeground,
+                           line.mid(17).split(","));
+                } else if(line.indexOf("inactiveForeground=") == 0) {
+                    setRgb(&m_wmColors.inactiveForeground,
+                           line.mid(19).split(","));
+                } else if (line.indexOf('[') != -1) {
+                    break;
+                }
+            } else if(line.indexOf("[WM]") == 0) {
+                inPal = true;
+            }
+        }
+        f.close();
+    }
+#else
+    KConfigGroup cg(KSharedConfig::openConfig(QStringLiteral("kdeglobals"),
+                                              KConfig::NoGlobals), "WM");
+
+    m_wmColors.activeBackground =
+        cg.readEntry("activeBackground", QColor(48, 174, 232));
+    m_wmColors.inactiveBackground =
+        cg.readEntry("inactiveBackground", QColor(224, 223, 222));
+    m_wmColors.activeForeground =
+        cg.readEntry("activeForeground", QColor(255, 255, 255));
+    m_wmColors.inactiveForeground =
+        cg.readEntry("inactiveForeground", QColor(75, 71, 67));
+#endif
+}
+
+}
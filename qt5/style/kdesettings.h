@@ -0,0 +1,83 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#ifndef __KDESETTINGS_H__
+#define __KDESETTINGS_H__
+
+#include <QObject>
+#include <QColor>
+#include <QList>
+
+class QFileSystemWatcher;
+
+namespace QtCurve {
+
+/**
+ * Process wide cache of the settings QtCurve reads from KDE's config files,
+ * i.e. the titlebar button order from kwinrc, the window manager colors from
+ * kdeglobals and the contrast from Trolltech.conf. Each file is parsed at
+ * most once and is only parsed again after the file watcher reports a change,
+ * no matter how many Style instances ask for it.
+ *
+ * QtCurve's own config files are watched as well, styleConfigChanged() is
+ * emitted when any of them changes.
+ */
+class KdeSettings: public QObject {
+    Q_OBJECT
+public:
+    // Invalid colors are used for the entries missing in kdeglobals.
+    struct WMColors {
+        QColor activeBackground;
+        QColor inactiveBackground;
+        QColor activeForeground;
+        QColor inactiveForeground;
+    };
+
+    static KdeSettings *instance();
+
+    int contrast();
+    // 0=left, 1=right
+    const QList<int> &mdiButtons(int side);
+    const WMColors &wmColors();
+
+Q_SIGNALS:
+    void changed();
+    void styleConfigChanged();
+
+private:
+    explicit KdeSettings(QObject *parent);
+    void watchFiles();
+    void fileChanged(const QString &path);
+    void readMdiButtons();
+    void readWMColors();
+
+    QFileSystemWatcher *m_watcher;
+    bool m_contrastRead;
+    bool m_mdiButtonsRead;
+    bool m_wmColorsRead;
+    int m_contrast;
+    QList<int> m_mdiButtons[2];
+    WMColors m_wmColors;
+};
+
+}
+
+#endif
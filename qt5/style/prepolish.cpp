@@ -55,7 +55,7 @@ Style::prePolish(QWidget *widget) const
             (opts.dlgOpacity != 100 && qtcIsDialog(widget)) ||
             (opts.menuBgndOpacity != 100 &&
              (qobject_cast<QMenu*>(widget) ||
-              widget->inherits("QComboBoxPrivateContainer")))) {
+              classFlags(widget) & CLASS_COMBO_CONTAINER))) {
             props->prePolishing = true;
             addAlphaChannel(widget);
             // QWidgetPrivate::updateIsTranslucent sets the format back
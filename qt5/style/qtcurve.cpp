@@ -24,6 +24,7 @@
 #include "qtcurve_plugin.h"
 #include "qtcurve_fonthelper.h"
 #include <qtcurve-utils/qtprops.h>
+#include <qtcurve-utils/stats.h>
 
 #include <qglobal.h>
 #include <QDBusConnection>
@@ -31,6 +32,7 @@
 #include "windowmanager.h"
 #include "blurhelper.h"
 #include "shortcuthandler.h"
+#include "kdesettings.h"
 #include <common/config_file.h>
 #include "check_on-png.h"
 #include "check_x_on-png.h"
@@ -57,6 +59,7 @@
 #include <QDial>
 #include <QLabel>
 #include <QStackedLayout>
+#include <QMenu>
 #include <QMenuBar>
 #include <QMouseEvent>
 #include <QScrollBar>
@@ -92,6 +95,7 @@ class Style::DBusHelper {
 public:
     DBusHelper()
         : m_dBus(0)
+        , m_stats(0)
         , m_dbusConnected(false)
     {}
     ~DBusHelper()
@@ -105,14 +109,46 @@ public:
 
     std::once_flag m_aboutToQuitInit;
     QDBusInterface *m_dBus;
+    StatsExporter *m_stats;
     bool m_dbusConnected;
 };
 
+QString StatsExporter::report() const
+{
+    return QString::fromStdString(Stats::report());
+}
+
 static inline void setPainterPen(QPainter *p, const QColor &col, const qreal width=1.0)
 {
     p->setPen(QPen(col, width));
 }
 
+static inline int
+pixmapCost(const QPixmap *pix)
+{
+    return pix->width() * pix->height() * (pix->depth() / 8);
+}
+
+static inline bool
+findCachedPixmap(bool useCache, const QString &key, QPixmap *pix)
+{
+    if (!useCache) {
+        return false;
+    }
+    bool found = QPixmapCache::find(key, pix);
+    Stats::countCache(found);
+    return found;
+}
+
+static inline void
+insertCachedPixmap(bool useCache, const QString &key, const QPixmap &pix)
+{
+    if (useCache) {
+        QPixmapCache::insert(key, pix);
+        Stats::add(Stats::Counter::PixmapBytes, pixmapCost(&pix));
+    }
+}
+
 static Style::Icon
 pix2Icon(QStyle::StandardPixmap pix)
 {
@@ -201,33 +237,6 @@ addStripes(QPainter *p, const QPainterPath &path,
     }
 }
 
-#ifndef QTC_QT5_ENABLE_KDE
-static void
-setRgb(QColor *col, const QStringList &rgb)
-{
-    if (rgb.size() == 3) {
-        *col = QColor(rgb[0].toInt(), rgb[1].toInt(), rgb[2].toInt());
-    }
-}
-
-static QString
-kdeHome()
-{
-    static QString kdeHomePath;
-    if (kdeHomePath.isEmpty()) {
-        kdeHomePath = QString::fromLocal8Bit(qgetenv("KDEHOME"));
-        if (kdeHomePath.isEmpty()) {
-            QDir homeDir(QDir::homePath());
-            QString kdeConfDir(QLatin1String("/.kde"));
-            if (homeDir.exists(QLatin1String(".kde4")))
-                kdeConfDir = QLatin1String("/.kde4");
-            kdeHomePath = QDir::homePath() + kdeConfDir;
-        }
-    }
-    return kdeHomePath;
-}
-#endif
-
 static bool
 isHoriz(const QStyleOption *option, EWidget w, bool joinedTBar)
 {
@@ -298,39 +307,13 @@ static QtcKey createKey(const QColor &color, EPixmap p)
         (((qulonglong)1)<<38);
 }
 
-#ifdef QTC_QT5_ENABLE_KDE
-static void parseWindowLine(const QString &line, QList<int> &data)
+static int
+addGlyph(SpriteAtlas &atlas, const QImage &image)
 {
-    int len(line.length());
-
-    for(int i = 0;i < len;++i) {
-        switch(line[i].toLatin1()) {
-        case 'M':
-            data.append(QStyle::SC_TitleBarSysMenu);
-            break;
-        case '_':
-            data.append(WINDOWTITLE_SPACER);
-            break;
-        case 'H':
-            data.append(QStyle::SC_TitleBarContextHelpButton);
-            break;
-        case 'L':
-            data.append(QStyle::SC_TitleBarShadeButton);
-            break;
-        case 'I':
-            data.append(QStyle::SC_TitleBarMinButton);
-            break;
-        case 'A':
-            data.append(QStyle::SC_TitleBarMaxButton);
-            break;
-        case 'X':
-            data.append(QStyle::SC_TitleBarCloseButton);
-        default:
-            break;
-        }
-    }
+    const QImage img = image.convertToFormat(QImage::Format_ARGB32);
+    return atlas.addGlyph(img.constBits(), img.width(), img.height(),
+                          img.bytesPerLine(), QTC_PIXEL_QT);
 }
-#endif
 
 Style::Style() :
     m_dBusHelper(new DBusHelper()),
@@ -351,6 +334,10 @@ Style::Style() :
     m_activeMdiColors(0L),
     m_mdiColors(0L),
     m_pixmapCache(150000),
+    m_pathCache(512),
+    m_spriteGeneration(0),
+    m_checkGlyph(-1),
+    m_checkXGlyph(-1),
     m_active(true),
     m_sbWidget(0L),
     m_clickedLabel(0L),
@@ -407,6 +394,10 @@ void Style::init(bool initial)
             }
 #endif
             connectDBus();
+            connect(KdeSettings::instance(), &KdeSettings::changed,
+                    this, &Style::kdeSettingsChanged);
+            connect(KdeSettings::instance(), &KdeSettings::styleConfigChanged,
+                    this, &Style::reloadConfig);
 #ifdef QTC_QT5_ENABLE_KDE
             connect(KWindowSystem::self(), &KWindowSystem::compositingChanged, this, &Style::compositingToggled);
 #endif
@@ -430,10 +421,28 @@ void Style::init(bool initial)
         }
     }
 
-    opts.contrast=QSettings(QLatin1String("Trolltech")).value("/Qt/KDE/contrast", DEFAULT_CONTRAST).toInt();
-    if(opts.contrast<0 || opts.contrast>10)
-        opts.contrast=DEFAULT_CONTRAST;
+    opts.contrast = KdeSettings::instance()->contrast();
 
+    setupColors();
+    m_windowManager->initialize(opts.windowDrag, opts.windowDragWhiteList.values(), opts.windowDragBlackList.values());
+
+    m_blurHelper->setEnabled(opts.bgndOpacity != 100 ||
+                             opts.dlgOpacity != 100 ||
+                             opts.menuBgndOpacity != 100);
+
+    opts.fontTickWidth=-1;
+    opts.menuTick=QString(QChar(0x2713));
+
+#ifdef QTC_QT5_ENABLE_KDE
+    // We need to set the decoration colours for the preview now...
+    if (m_isPreview) {
+        setDecorationColors();
+    }
+#endif
+}
+
+void Style::setupColors()
+{
     shadeColors(QApplication::palette().color(QPalette::Active, QPalette::Highlight), m_highlightCols);
     shadeColors(QApplication::palette().color(QPalette::Active, QPalette::Background), m_backgroundCols);
     shadeColors(QApplication::palette().color(QPalette::Active, QPalette::Button), m_buttonCols);
@@ -448,8 +457,6 @@ void Style::init(bool initial)
 //    setupKde4();
 //#endif
 
-    m_windowManager->initialize(opts.windowDrag, opts.windowDragWhiteList.values(), opts.windowDragBlackList.values());
-
     switch(opts.shadeSliders)
     {
     default:
@@ -680,20 +687,6 @@ void Style::init(bool initial)
               IMG_SQUARE_RINGS)) {
         qtcCalcRingAlphas(&m_backgroundCols[ORIGINAL_SHADE]);
     }
-
-    m_blurHelper->setEnabled(opts.bgndOpacity != 100 ||
-                             opts.dlgOpacity != 100 ||
-                             opts.menuBgndOpacity != 100);
-
-    opts.fontTickWidth=-1;
-    opts.menuTick=QString(QChar(0x2713));
-
-#ifdef QTC_QT5_ENABLE_KDE
-    // We need to set the decoration colours for the preview now...
-    if (m_isPreview) {
-        setDecorationColors();
-    }
-#endif
 }
 
 void Style::connectDBus()
@@ -703,6 +696,16 @@ void Style::connectDBus()
     auto bus = QDBusConnection::sessionBus();
     if (bus.isConnected()) {
         m_dBusHelper->m_dbusConnected = true;
+        if (Stats::enabled()) {
+            // Only one style instance per process can own the path.
+            StatsExporter *stats = new StatsExporter(this);
+            if (bus.registerObject("/QtCurve/Stats", stats,
+                                   QDBusConnection::ExportScriptableSlots)) {
+                m_dBusHelper->m_stats = stats;
+            } else {
+                delete stats;
+            }
+        }
         bus.connect(QString(), "/KGlobalSettings", "org.kde.KGlobalSettings",
                     "notifyChange", this, SLOT(kdeGlobalSettingsChange(int, int)));
 #ifndef QTC_QT5_ENABLE_KDE
@@ -736,6 +739,11 @@ void Style::disconnectDBus()
     if (!bus.isConnected())
         return;
     m_dBusHelper->m_dbusConnected = false;
+    if (m_dBusHelper->m_stats) {
+        bus.unregisterObject("/QtCurve/Stats");
+        delete m_dBusHelper->m_stats;
+        m_dBusHelper->m_stats = 0;
+    }
     if (getenv("QTCURVE_DEBUG")) {
         qWarning() << Q_FUNC_INFO << this << "Disconnecting from" << bus.name() << "/" << bus.baseService();
         dumpObjectInfo();
@@ -796,11 +804,6 @@ void Style::freeColor(QSet<QColor *> &freedColors, QColor **cols)
 
 void Style::freeColors()
 {
-    if(0!=m_progressBarAnimateTimer) {
-        killTimer(m_progressBarAnimateTimer);
-        m_progressBarAnimateTimer = 0;
-    }
-
     QSet<QColor*> freedColors;
 
     freeColor(freedColors, &m_sidebarButtonsCols);
@@ -980,15 +983,15 @@ QIcon Style::standardIcon(StandardPixmap pix, const QStyleOption *option,
 #ifndef QTC_QT5_ENABLE_KDE
     case SP_MessageBoxQuestion:
     case SP_MessageBoxInformation: {
-        static QIcon icn(QPixmap::fromImage(qtc_dialog_information));
+        static QIcon icn(QPixmap::fromImage(qtc_dialog_information()));
         return icn;
     }
     case SP_MessageBoxWarning: {
-        static QIcon icn(QPixmap::fromImage(qtc_dialog_warning));
+        static QIcon icn(QPixmap::fromImage(qtc_dialog_warning()));
         return icn;
     }
     case SP_MessageBoxCritical: {
-        static QIcon icn(QPixmap::fromImage(qtc_dialog_error));
+        static QIcon icn(QPixmap::fromImage(qtc_dialog_error()));
         return icn;
     }
 /*
@@ -1377,6 +1380,7 @@ void Style::drawProgressBevelGradient(QPainter *p, const QRect &origRect, const
               horiz ? origRect.height() : PROGRESS_CHUNK_WIDTH*2);
     QtcKey  key(createKey(horiz ? r.height() : r.width(), cols[ORIGINAL_SHADE], horiz, bevApp, WIDGET_PROGRESSBAR));
     QPixmap *pix(m_pixmapCache.object(key));
+    Stats::countCache(pix != nullptr);
 
     if(!pix)
     {
@@ -1434,16 +1438,23 @@ void Style::drawProgressBevelGradient(QPainter *p, const QRect &origRect, const
                 pixPainter.fillRect(r, cols[1]);
             else
                 drawBevelGradientReal(cols[1], &pixPainter, r, horiz, false, bevApp, WIDGET_PROGRESSBAR);
+            break;
         }
+        case STRIPE_FADE:
+            // The stripes repeat with the same period as the tile.
+            addStripes(&pixPainter, QPainterPath(), r, horiz);
+            break;
         }
 
         pixPainter.end();
-        int cost(pix->width()*pix->height()*(pix->depth()/8));
+        int cost(pixmapCost(pix));
 
-        if(cost<m_pixmapCache.maxCost())
+        if(cost<m_pixmapCache.maxCost()) {
             m_pixmapCache.insert(key, pix, cost);
-        else
+            Stats::add(Stats::Counter::PixmapBytes, cost);
+        } else {
             inCache=false;
+        }
     }
     QRect fillRect(origRect);
 
@@ -1465,10 +1476,6 @@ void Style::drawProgressBevelGradient(QPainter *p, const QRect &origRect, const
     p->save();
     p->setClipRect(origRect, Qt::IntersectClip);
     p->drawTiledPixmap(fillRect, *pix);
-    if (opts.stripedProgress == STRIPE_FADE && fillRect.width() > 4 &&
-        fillRect.height() > 4) {
-        addStripes(p, QPainterPath(), fillRect, !vertical);
-    }
     p->restore();
 
     if (!inCache) {
@@ -1513,6 +1520,7 @@ Style::drawBevelGradient(const QColor &base, QPainter *p, const QRect &origRect,
             QtcKey key(createKey(horiz ? r.height() : r.width(),
                                  base, horiz, app, w));
             QPixmap *pix(m_pixmapCache.object(key));
+            Stats::countCache(pix != nullptr);
             bool inCache(true);
 
             if (!pix) {
@@ -1524,10 +1532,11 @@ Style::drawBevelGradient(const QColor &base, QPainter *p, const QRect &origRect,
                 drawBevelGradientReal(base, &pixPainter, r, horiz, sel, app, w);
                 pixPainter.end();
 
-                int cost(pix->width()*pix->height()*(pix->depth()/8));
+                int cost(pixmapCost(pix));
 
                 if (cost < m_pixmapCache.maxCost()) {
                     m_pixmapCache.insert(key, pix, cost);
+                    Stats::add(Stats::Counter::PixmapBytes, cost);
                 } else {
                     inCache = false;
                 }
@@ -1701,7 +1710,7 @@ Style::drawLightBevel(QPainter *p, const QRect &r, const QStyleOption *option,
                 .arg((int)realRound, 0, 16).arg(pixSize.width(), 0, 16)
                 .arg(pixSize.height(), 0, 16)
                 .arg(state, 0, 16).arg(fill.rgba(), 0, 16).arg((int)(radius * 100), 0, 16);
-            if (!m_usePixmapCache || !QPixmapCache::find(key, &pix)) {
+            if (!findCachedPixmap(m_usePixmapCache, key, &pix)) {
                 pix = QPixmap(pixSize);
                 pix.fill(Qt::transparent);
 
@@ -1716,9 +1725,7 @@ Style::drawLightBevel(QPainter *p, const QRect &r, const QStyleOption *option,
                 opts.round = oldRound;
                 pixPainter.end();
 
-                if (m_usePixmapCache) {
-                    QPixmapCache::insert(key, pix);
-                }
+                insertCachedPixmap(m_usePixmapCache, key, pix);
             }
 
             if (small) {
@@ -2123,7 +2130,7 @@ QPixmap Style::drawStripes(const QColor &color, int opacity) const
         col.setAlphaF(opacity/100.0);
 
     QString key = QStringLiteral("qtc-stripes-%1").arg(col.rgba(), 0, 16);
-    if(!m_usePixmapCache || !QPixmapCache::find(key, &pix))
+    if(!findCachedPixmap(m_usePixmapCache, key, &pix))
     {
         pix=QPixmap(QSize(64, 64));
 
@@ -2156,8 +2163,7 @@ QPixmap Style::drawStripes(const QColor &color, int opacity) const
         for(int i=2; i<pix.height()-1; i+=4)
             pixPainter.drawLine(0, i, pix.width()-1, i);
 
-        if(m_usePixmapCache)
-            QPixmapCache::insert(key, pix);
+        insertCachedPixmap(m_usePixmapCache, key, pix);
     }
 
     return pix;
@@ -2193,7 +2199,7 @@ Style::drawBackground(QPainter *p, const QColor &bgnd, const QRect &r,
 
             QString key = QStringLiteral("qtc-bgnd-%1-%2-%3")
                 .arg(col.rgba(), 0, 16).arg(grad).arg(app);
-            if (!m_usePixmapCache || !QPixmapCache::find(key, &pix)) {
+            if (!findCachedPixmap(m_usePixmapCache, key, &pix)) {
                 pix = QPixmap(QSize(grad == GT_HORIZ ? constPixmapWidth :
                                     constPixmapHeight, grad == GT_HORIZ ?
                                     constPixmapHeight : constPixmapWidth));
@@ -2205,9 +2211,7 @@ Style::drawBackground(QPainter *p, const QColor &bgnd, const QRect &r,
                                       grad == GT_HORIZ, false, app,
                                       WIDGET_OTHER);
                 pixPainter.end();
-                if (m_usePixmapCache) {
-                    QPixmapCache::insert(key, pix);
-                }
+                insertCachedPixmap(m_usePixmapCache, key, pix);
             }
         }
 
@@ -2232,7 +2236,7 @@ Style::drawBackground(QPainter *p, const QColor &bgnd, const QRect &r,
             qtcGetGradient(app, &opts)->border == GB_SHINE) {
             int size = qMin(BGND_SHINE_SIZE, qMin(r.height() * 2, r.width()));
             QString key = QStringLiteral("qtc-radial-%1").arg(size / BGND_SHINE_STEPS, 0, 16);
-            if (!m_usePixmapCache || !QPixmapCache::find(key, &pix)) {
+            if (!findCachedPixmap(m_usePixmapCache, key, &pix)) {
                 size /= BGND_SHINE_STEPS;
                 size *= BGND_SHINE_STEPS;
                 pix = QPixmap(size, size / 2);
@@ -2255,9 +2259,7 @@ Style::drawBackground(QPainter *p, const QColor &bgnd, const QRect &r,
                 pixPainter.fillRect(QRect(0, 0, pix.width(), pix.height()),
                                     gradient);
                 pixPainter.end();
-                if (m_usePixmapCache) {
-                    QPixmapCache::insert(key, pix);
-                }
+                insertCachedPixmap(m_usePixmapCache, key, pix);
             }
             p->drawPixmap(r.x() + ((r.width() - pix.width()) / 2), r.y(), pix);
         }
@@ -2463,25 +2465,29 @@ Style::drawBackground(QPainter *p, const QWidget *widget,
     p->restore();
 }
 
-QPainterPath
-Style::buildPath(const QRectF &r, EWidget w, int round, double radius) const
+// Apart from the size, corners and radius, the only thing the paths built
+// by buildPath and buildSplitPath depend on.
+enum {
+    PATH_ELLIPSE,
+    PATH_ROUNDED,
+    PATH_MDI_TITLE,
+    PATH_SPLIT_TL,
+    PATH_SPLIT_BR
+};
+
+static QPainterPath
+createPath(const QRectF &r, int shape, int round, double radius)
 {
     QPainterPath path;
 
-    if (oneOf(w, WIDGET_RADIO_BUTTON, WIDGET_DIAL) ||
-        (w == WIDGET_MDI_WINDOW_BUTTON &&
-         opts.titlebarButtons & TITLEBAR_BUTTON_ROUND) || CIRCULAR_SLIDER(w)) {
+    if (shape == PATH_ELLIPSE) {
         path.addEllipse(r);
         return path;
     }
 
-    if (opts.round == ROUND_NONE || radius < 0.01) {
-        round = ROUNDED_NONE;
-    }
-
     double diameter = radius * 2;
 
-    if (w != WIDGET_MDI_WINDOW_TITLE && round & CORNER_BR) {
+    if (shape != PATH_MDI_TITLE && round & CORNER_BR) {
         path.moveTo(r.x() + r.width(), r.y() + r.height() - radius);
     } else {
         path.moveTo(r.x() + r.width(), r.y() + r.height());
@@ -2497,14 +2503,14 @@ Style::buildPath(const QRectF &r, EWidget w, int round, double radius) const
     } else {
         path.lineTo(r.x(), r.y());
     }
-    if (w != WIDGET_MDI_WINDOW_TITLE && round & CORNER_BL) {
+    if (shape != PATH_MDI_TITLE && round & CORNER_BL) {
         path.arcTo(r.x(), r.y() + r.height() - diameter,
                    diameter, diameter, 180, 90);
     } else {
         path.lineTo(r.x(), r.y() + r.height());
     }
 
-    if (w != WIDGET_MDI_WINDOW_TITLE) {
+    if (shape != PATH_MDI_TITLE) {
         if (round & CORNER_BR) {
             path.arcTo(r.x() + r.width() - diameter,
                        r.y() + r.height() - diameter,
@@ -2516,23 +2522,14 @@ Style::buildPath(const QRectF &r, EWidget w, int round, double radius) const
     return path;
 }
 
-QPainterPath
-Style::buildPath(const QRect &r, EWidget w, int round, double radius) const
-{
-    return buildPath(QRectF(r.x() + 0.5, r.y() + 0.5,
-                            r.width() - 1, r.height() - 1), w, round, radius);
-}
-
-void
-Style::buildSplitPath(const QRect &r, int round, double radius,
-                      QPainterPath &tl, QPainterPath &br) const
+static void
+createSplitPath(int width, int height, int round, double radius,
+                QPainterPath &tl, QPainterPath &br)
 {
-    double xd = r.x() + 0.5;
-    double yd = r.y() + 0.5;
+    double xd = 0.5;
+    double yd = 0.5;
     double diameter = radius * 2;
     bool rounded = diameter > 0.0;
-    int width = r.width() - 1;
-    int height = r.height() - 1;
 
     if (rounded && round & CORNER_TR) {
         tl.arcMoveTo(xd + width - diameter, yd, diameter, diameter, 45);
@@ -2573,6 +2570,82 @@ Style::buildSplitPath(const QRect &r, int round, double radius,
     }
 }
 
+static inline void
+appendPath(QPainterPath &dest, const QPainterPath &path)
+{
+    if (dest.isEmpty()) {
+        dest = path;
+    } else {
+        dest.addPath(path);
+    }
+}
+
+QPainterPath
+Style::buildPath(const QRectF &r, EWidget w, int round, double radius) const
+{
+    int shape = PATH_ROUNDED;
+    if (oneOf(w, WIDGET_RADIO_BUTTON, WIDGET_DIAL) ||
+        (w == WIDGET_MDI_WINDOW_BUTTON &&
+         opts.titlebarButtons & TITLEBAR_BUTTON_ROUND) || CIRCULAR_SLIDER(w)) {
+        shape = PATH_ELLIPSE;
+        round = ROUNDED_NONE;
+        radius = 0;
+    } else if (w == WIDGET_MDI_WINDOW_TITLE) {
+        shape = PATH_MDI_TITLE;
+    }
+    if (shape != PATH_ELLIPSE &&
+        (opts.round == ROUND_NONE || radius < 0.01)) {
+        round = ROUNDED_NONE;
+    }
+    round &= ROUNDED_ALL;
+
+    const PathKey key = {r.width(), r.height(), radius, round, shape};
+    QPainterPath *path = m_pathCache.object(key);
+    if (!path) {
+        path = new QPainterPath(createPath(QRectF(0, 0, r.width(), r.height()),
+                                           shape, round, radius));
+        m_pathCache.insert(key, path);
+    }
+    return path->translated(r.topLeft());
+}
+
+QPainterPath
+Style::buildPath(const QRect &r, EWidget w, int round, double radius) const
+{
+    return buildPath(QRectF(r.x() + 0.5, r.y() + 0.5,
+                            r.width() - 1, r.height() - 1), w, round, radius);
+}
+
+void
+Style::buildSplitPath(const QRect &r, int round, double radius,
+                      QPainterPath &tl, QPainterPath &br) const
+{
+    int width = r.width() - 1;
+    int height = r.height() - 1;
+    if (radius * 2 > 0.0) {
+        round &= ROUNDED_ALL;
+    } else {
+        round = ROUNDED_NONE;
+        radius = 0;
+    }
+
+    const PathKey tlKey = {double(width), double(height), radius, round,
+                           PATH_SPLIT_TL};
+    const PathKey brKey = {double(width), double(height), radius, round,
+                           PATH_SPLIT_BR};
+    QPainterPath *tlPath = m_pathCache.object(tlKey);
+    QPainterPath *brPath = tlPath ? m_pathCache.object(brKey) : nullptr;
+    if (!tlPath || !brPath) {
+        tlPath = new QPainterPath;
+        brPath = new QPainterPath;
+        createSplitPath(width, height, round, radius, *tlPath, *brPath);
+        m_pathCache.insert(tlKey, tlPath);
+        m_pathCache.insert(brKey, brPath);
+    }
+    appendPath(tl, tlPath->translated(r.topLeft()));
+    appendPath(br, brPath->translated(r.topLeft()));
+}
+
 void
 Style::drawBorder(QPainter *p, const QRect &r, const QStyleOption *option,
                   int round, const QColor *custom, EWidget w,
@@ -3652,12 +3725,15 @@ void Style::shadeColors(const QColor &base, QColor *vals) const
 {
     bool useCustom(USE_CUSTOM_SHADES(opts));
     double hl=TO_FACTOR(opts.highlightFactor);
+    // The standard shades followed by SHADE_ORIG_HIGHLIGHT, all of base
+    double k[QTC_NUM_STD_SHADES + 1];
 
     for(int i=0; i<QTC_NUM_STD_SHADES; ++i)
-        shade(base, &vals[i], useCustom ? opts.customShades[i] :
-              qtcShadeGetIntern(opts.contrast, i,
-                                opts.darkerBorders, opts.shading));
-    shade(base, &vals[SHADE_ORIG_HIGHLIGHT], hl);
+        k[i] = useCustom ? opts.customShades[i] :
+            qtcShadeGetIntern(opts.contrast, i,
+                              opts.darkerBorders, opts.shading);
+    k[SHADE_ORIG_HIGHLIGHT] = hl;
+    qtcShadeN(&base, k, vals, QTC_NUM_STD_SHADES + 1, opts.shading);
     shade(vals[4], &vals[SHADE_4_HIGHLIGHT], hl);
     shade(vals[2], &vals[SHADE_2_HIGHLIGHT], hl);
     vals[ORIGINAL_SHADE]=base;
@@ -3894,70 +3970,34 @@ const QColor*
 Style::getMdiColors(const QStyleOption *option, bool active) const
 {
     if (!m_activeMdiColors) {
+        const KdeSettings::WMColors &wmColors =
+            KdeSettings::instance()->wmColors();
+        QColor col = wmColors.activeBackground;
 #ifndef QTC_QT5_ENABLE_KDE
-        m_activeMdiTextColor = (option ? option->palette.text().color() :
-                                 QApplication::palette().text().color());
-        m_mdiTextColor = (option ? option->palette.text().color() :
-                           QApplication::palette().text().color());
-
-        QFile f(kdeHome() + "/share/config/kdeglobals");
-
-        if (f.open(QIODevice::ReadOnly)) {
-            QTextStream in(&f);
-            bool inPal = false;
-
-            while (!in.atEnd()) {
-                QString line(in.readLine());
-                if (inPal) {
-                    if (!m_activeMdiColors &&
-                        line.indexOf("activeBackground=") == 0) {
-                        QColor col;
-                        setRgb(&col, line.mid(17).split(","));
-                        if (col != m_highlightCols[ORIGINAL_SHADE]) {
-                            m_activeMdiColors = new QColor[TOTAL_SHADES + 1];
-                            shadeColors(col, m_activeMdiColors);
-                        }
-                    } else if (!m_mdiColors &&
-                               line.indexOf("inactiveBackground=") == 0) {
-                        QColor col;
-                        setRgb(&col, line.mid(19).split(","));
-                        if (col != m_buttonCols[ORIGINAL_SHADE]) {
-                            m_mdiColors = new QColor[TOTAL_SHADES+1];
-                            shadeColors(col, m_mdiColors);
-                        }
-                    } else if(line.indexOf("activeForeground=") == 0) {
-                        setRgb(&m_activeMdiTextColor, line.mid(17).split(","));
-                    } else if(line.indexOf("inactiveForeground=") == 0) {
-                        setRgb(&m_mdiTextColor, line.mid(19).split(","));
-                    } else if (line.indexOf('[') != -1) {
-                        break;
-                    }
-                } else if(line.indexOf("[WM]") == 0) {
-                    inPal = true;
-                }
-            }
-            f.close();
-        }
+        if (col.isValid() && col != m_highlightCols[ORIGINAL_SHADE]) {
 #else
-        Q_UNUSED(option);
-        KConfigGroup cg(m_kdeGlobals, "WM");
-
-        QColor col = cg.readEntry("activeBackground", QColor(48, 174, 232));
-
         if (col != m_backgroundCols[ORIGINAL_SHADE]) {
+#endif
             m_activeMdiColors = new QColor[TOTAL_SHADES + 1];
             shadeColors(col, m_activeMdiColors);
         }
 
-        col = cg.readEntry("inactiveBackground", QColor(224, 223, 222));;
+        col = wmColors.inactiveBackground;
+#ifndef QTC_QT5_ENABLE_KDE
+        if (col.isValid() && col != m_buttonCols[ORIGINAL_SHADE]) {
+#else
         if (col != m_backgroundCols[ORIGINAL_SHADE]) {
+#endif
             m_mdiColors = new QColor[TOTAL_SHADES+1];
             shadeColors(col, m_mdiColors);
         }
 
-        m_activeMdiTextColor = cg.readEntry("activeForeground", QColor(255, 255, 255));
-        m_mdiTextColor = cg.readEntry("inactiveForeground", QColor(75, 71, 67));
-#endif
+        const QColor &textColor = (option ? option->palette.text().color() :
+                                   QApplication::palette().text().color());
+        m_activeMdiTextColor = (wmColors.activeForeground.isValid() ?
+                                wmColors.activeForeground : textColor);
+        m_mdiTextColor = (wmColors.inactiveForeground.isValid() ?
+                          wmColors.inactiveForeground : textColor);
 
         if(!m_activeMdiColors)
             m_activeMdiColors=(QColor *)m_backgroundCols;
@@ -3975,66 +4015,153 @@ Style::getMdiColors(const QStyleOption *option, bool active) const
 void Style::readMdiPositions() const
 {
     if (0==m_mdiButtons[0].size() && 0==m_mdiButtons[1].size()) {
-#ifdef Q_OS_MACOS
-        // no control over where the system menu appears, so we have little choice
-        // but to keep it at its default position. The user can still override this.
-        m_mdiButtons[0].append(SC_TitleBarSysMenu);
-        m_mdiButtons[0].append(SC_TitleBarCloseButton);
-        m_mdiButtons[0].append(SC_TitleBarMinButton);
-        m_mdiButtons[0].append(SC_TitleBarMaxButton);
-
-        m_mdiButtons[1].append(SC_TitleBarShadeButton);
-        m_mdiButtons[1].append(SC_TitleBarContextHelpButton);
-#else
-        // Set defaults...
-        m_mdiButtons[0].append(SC_TitleBarSysMenu);
-        m_mdiButtons[0].append(SC_TitleBarShadeButton);
-
-        m_mdiButtons[1].append(SC_TitleBarContextHelpButton);
-        m_mdiButtons[1].append(SC_TitleBarMinButton);
-        m_mdiButtons[1].append(SC_TitleBarMaxButton);
-        m_mdiButtons[1].append(WINDOWTITLE_SPACER);
-        m_mdiButtons[1].append(SC_TitleBarCloseButton);
-#endif
-
-#ifdef QTC_QT5_ENABLE_KDE
-        KSharedConfigPtr cfg = KSharedConfig::openConfig("kwinrc");
-        KConfigGroup grp = cfg->group("org.kde.kdecoration2");
-
-        QString left=grp.readEntry("ButtonsOnLeft", QString()),
-            right=grp.readEntry("ButtonsOnRight", QString());
+        KdeSettings *settings = KdeSettings::instance();
+        m_mdiButtons[0] = settings->mdiButtons(0);
+        m_mdiButtons[1] = settings->mdiButtons(1);
+    }
+}
 
-        if(!left.isEmpty() || !right.isEmpty())
-            m_mdiButtons[0].clear(), m_mdiButtons[1].clear();
+void
+Style::kdeSettingsChanged()
+{
+    // Only drop what is derived from the KDE settings, the rest is updated
+    // by init() the next time the palette or the style config changes.
+    QSet<QColor*> freedColors;
+    freeColor(freedColors, &m_activeMdiColors);
+    freeColor(freedColors, &m_mdiColors);
+    m_mdiButtons[0].clear();
+    m_mdiButtons[1].clear();
 
-        if(!left.isEmpty())
-            parseWindowLine(left, m_mdiButtons[0]);
+    int contrast = KdeSettings::instance()->contrast();
+    if (contrast != opts.contrast) {
+        Options newOpts(opts);
+        newOpts.contrast = contrast;
+        applyOptions(newOpts);
+    }
+}
 
-        if(!right.isEmpty())
-            parseWindowLine(right, m_mdiButtons[1]);
+void
+Style::reloadConfig()
+{
+    if (m_isPreview) {
+        return;
+    }
+    // Background pixmaps are only loaded from disk if they have changed.
+    // A different appearance also needs them, in case the old one is the
+    // fallback for a `file:` background that failed to load.
+    Options newOpts;
+    qtcReadConfig(QString(), &newOpts, nullptr, false);
+    adjustOptsForApp(newOpts);
+    if (qtcConfigChanges(&opts, &newOpts) & QTC_CFG_BGND_IMAGES ||
+        newOpts.bgndAppearance != opts.bgndAppearance ||
+        newOpts.menuBgndAppearance != opts.menuBgndAppearance) {
+        qtcLoadBgndPixmaps(&newOpts);
+    }
+    newOpts.contrast = KdeSettings::instance()->contrast();
+    applyOptions(newOpts);
+}
 
-        // Designer uses shade buttons, not min/max - so if we don't have shade in our kwin config. 
-        // then add this button near the max button...
-        if (-1==m_mdiButtons[0].indexOf(SC_TitleBarShadeButton) && -1==m_mdiButtons[1].indexOf(SC_TitleBarShadeButton)) {
-            int maxPos=m_mdiButtons[0].indexOf(SC_TitleBarMaxButton);
+// Switch to newOpts, only updating what depends on the options that
+// actually changed, so that e.g. a new contrast does not throw away the
+// background images and a new menu opacity does not polish every button
+// again.
+void
+Style::applyOptions(Options &newOpts)
+{
+    int changes = qtcConfigChanges(&opts, &newOpts);
+    if (!changes) {
+        return;
+    }
+    qtcDebug("Config changes 0x%x\n", changes);
 
-            if(-1==maxPos) // Left doesnt have max button, assume right does and add shade there
-            {
-                int minPos=m_mdiButtons[1].indexOf(SC_TitleBarMinButton);
-                maxPos=m_mdiButtons[1].indexOf(SC_TitleBarMaxButton);
+    if (!(changes & QTC_CFG_BGND_IMAGES)) {
+        // Reuse what has already been loaded from disk.
+        newOpts.bgndPixmap = opts.bgndPixmap;
+        newOpts.menuBgndPixmap = opts.menuBgndPixmap;
+        newOpts.bgndImage = opts.bgndImage;
+        newOpts.menuBgndImage = opts.menuBgndImage;
+    }
+    newOpts.tickFont = opts.tickFont;
+    newOpts.menuTick = opts.menuTick;
+    newOpts.fontTickWidth = (changes & (QTC_CFG_MENUS | QTC_CFG_POLISH) ?
+                             -1 : opts.fontTickWidth);
+#ifdef Q_OS_MACOS
+    newOpts.currentNonnativeMenubarApps = opts.currentNonnativeMenubarApps;
+#endif
 
-                m_mdiButtons[1].insert(minPos<maxPos ? (minPos==-1 ? 0 : minPos)
-                                        : (maxPos==-1 ? 0 : maxPos), SC_TitleBarShadeButton);
+    // Has to be done with the old options, they decide what to undo.
+    QList<QWidget*> repolish;
+    if (changes & (QTC_CFG_POLISH | QTC_CFG_MENUS | QTC_CFG_OPACITY)) {
+        for (QWidget *widget: QApplication::allWidgets()) {
+            if (widget->style() != this) {
+                continue;
             }
-            else // Add to left button
-            {
-                int minPos=m_mdiButtons[0].indexOf(SC_TitleBarMinButton);
-
-                m_mdiButtons[1].insert(minPos>maxPos ? (minPos==-1 ? 0 : minPos)
-                                        : (maxPos==-1 ? 0 : maxPos), SC_TitleBarShadeButton);
+            if (changes & QTC_CFG_POLISH ||
+                (changes & QTC_CFG_MENUS && qobject_cast<QMenu*>(widget)) ||
+                (changes & QTC_CFG_OPACITY && widget->isWindow())) {
+                unpolish(widget);
+                repolish << widget;
             }
         }
-#endif
+    }
+    if (changes & QTC_CFG_BAR_HIDING) {
+        disconnectDBus();
+    }
+    if (changes & QTC_CFG_COLORS) {
+        freeColors();
+    }
+    if (opts.hideShortcutUnderline != newOpts.hideShortcutUnderline &&
+        qApp && qApp->style() == this) {
+        if (newOpts.hideShortcutUnderline) {
+            qApp->installEventFilter(m_shortcutHandler);
+        } else {
+            qApp->removeEventFilter(m_shortcutHandler);
+        }
+    }
+    opts = newOpts;
+
+    if (changes & QTC_CFG_COLORS) {
+        setupColors();
+        if (theThemedApp == APP_OPENOFFICE && opts.useHighlightForMenu &&
+            blendOOMenuHighlight(QApplication::palette(),
+                                 m_highlightCols[ORIGINAL_SHADE])) {
+            m_ooMenuCols = new QColor[TOTAL_SHADES + 1];
+            shadeColors(tint(popupMenuCols()[ORIGINAL_SHADE],
+                             m_highlightCols[ORIGINAL_SHADE], 0.5),
+                        m_ooMenuCols);
+        }
+    }
+    if (changes & QTC_CFG_WINDOW_DRAG) {
+        m_windowManager->initialize(opts.windowDrag,
+                                    opts.windowDragWhiteList.values(),
+                                    opts.windowDragBlackList.values());
+    }
+    if (changes & QTC_CFG_OPACITY) {
+        m_blurHelper->setEnabled(opts.bgndOpacity != 100 ||
+                                 opts.dlgOpacity != 100 ||
+                                 opts.menuBgndOpacity != 100);
+    }
+    if (changes & QTC_CFG_BAR_HIDING) {
+        connectDBus();
+    }
+    if (changes & QTC_CFG_PIXMAPS) {
+        m_pixmapCache.clear();
+        m_sprites.clear();
+        if (m_usePixmapCache) {
+            QPixmapCache::clear();
+        }
+    }
+
+    for (QWidget *widget: repolish) {
+        polish(widget);
+        if (changes & QTC_CFG_POLISH) {
+            // Let the widget pick up the new metrics.
+            QEvent event(QEvent::StyleChange);
+            QApplication::sendEvent(widget, &event);
+        }
+    }
+    for (QWidget *widget: QApplication::topLevelWidgets()) {
+        widget->update();
     }
 }
 
@@ -4057,6 +4184,7 @@ QPixmap * Style::getPixmap(const QColor col, EPixmap p, double shade) const
 {
     QtcKey  key(createKey(col, p));
     QPixmap *pix=m_pixmapCache.object(key);
+    Stats::countCache(pix != nullptr);
 
     if (!pix) {
         if (p == PIX_DOT) {
@@ -4094,9 +4222,9 @@ QPixmap * Style::getPixmap(const QColor col, EPixmap p, double shade) const
             {
             case PIX_CHECK:
                 if(opts.xCheck) {
-                    img = qtc_check_x_on;
+                    img = qtc_check_x_on();
                 } else {
-                    img = qtc_check_on;
+                    img = qtc_check_on();
                 }
                 break;
             default:
@@ -4112,11 +4240,42 @@ QPixmap * Style::getPixmap(const QColor col, EPixmap p, double shade) const
             *pix=QPixmap::fromImage(img);
         }
         m_pixmapCache.insert(key, pix, pix->depth()/8);
+        Stats::add(Stats::Counter::PixmapBytes, pixmapCost(pix));
     }
 
     return pix;
 }
 
+void
+Style::drawCheckMark(QPainter *p, const QPoint &center,
+                     const QColor &col) const
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
+    const qreal dpr = p->device()->devicePixelRatioF();
+#else
+    const qreal dpr = p->device()->devicePixelRatio();
+#endif
+    int &glyph = opts.xCheck ? m_checkXGlyph : m_checkGlyph;
+    if (glyph < 0) {
+        glyph = addGlyph(m_sprites, opts.xCheck ? qtc_check_x_on() :
+                         qtc_check_on());
+    }
+    const SpriteAtlas::Cell cell = m_sprites.get(glyph, col.red(), col.green(),
+                                                 col.blue(), 1.0, dpr);
+    if (m_spriteGeneration != m_sprites.generation()) {
+        const QImage img(m_sprites.data(), m_sprites.width(),
+                         m_sprites.height(), m_sprites.stride(),
+                         QImage::Format_ARGB32_Premultiplied);
+        m_spritePixmap = QPixmap::fromImage(img);
+        m_spriteGeneration = m_sprites.generation();
+    }
+    const qreal w = cell.width / dpr;
+    const qreal h = cell.height / dpr;
+    p->drawPixmap(QRectF(center.x() - int(w) / 2, center.y() - int(h) / 2,
+                         w, h), m_spritePixmap,
+                  QRectF(cell.x, cell.y, cell.width, cell.height));
+}
+
 const QColor & Style::getTabFill(bool current, bool highlight, const QColor *use) const
 {
     return (current ? use[ORIGINAL_SHADE] : highlight ?
@@ -47,6 +47,7 @@ using ParentStyleClass = QCommonStyle;
 
 typedef qulonglong QtcKey;
 #include <common/common.h>
+#include <qtcurve-utils/sprite.h>
 
 class QStyleOptionSlider;
 class QLabel;
@@ -186,6 +187,9 @@ public:
 
 private:
     void init(bool initial);
+    void setupColors();
+    void adjustOptsForApp(Options &opts);
+    void applyOptions(Options &newOpts);
     void connectDBus();
     void freeColor(QSet<QColor*> &freedColors, QColor **cols);
     void freeColors();
@@ -348,12 +352,16 @@ private:
     bool coloredMdiButtons(bool active, bool mouseOver) const;
     const QColor *getMdiColors(const QStyleOption *option, bool active) const;
     void readMdiPositions() const;
+    void kdeSettingsChanged();
+    void reloadConfig();
     const QColor &getFill(const QStyleOption *option, const QColor *use,
                           bool cr=false, bool darker=false) const;
     const QColor &getTabFill(bool current, bool highlight,
                              const QColor *use) const;
     QColor menuStripeCol() const;
     QPixmap *getPixmap(const QColor col, EPixmap p, double shade=1.0) const;
+    void drawCheckMark(QPainter *p, const QPoint &center,
+                       const QColor &col) const;
     const QColor &checkRadioCol(const QStyleOption *opt) const;
     QColor shade(const QColor &a, double k) const;
     void shade(const QColor &ca, QColor *cb, double k) const;
@@ -525,6 +533,31 @@ private:
     void initFontTickData(const QFont &font, const QWidget *widget=0) const;
 
 private:
+    // Key of m_pathCache. Paths are built with their bounding rect at the
+    // origin and translated to where they are drawn.
+    struct PathKey {
+        double width;
+        double height;
+        double radius;
+        int round;
+        int shape;
+        bool
+        operator==(const PathKey &other) const
+        {
+            return (width == other.width && height == other.height &&
+                    radius == other.radius && round == other.round &&
+                    shape == other.shape);
+        }
+        friend inline uint
+        qHash(const PathKey &key, uint seed=0)
+        {
+            return (::qHash(key.width, seed) ^
+                    ::qHash(key.height, seed) * 31 ^
+                    ::qHash(key.radius, seed) * 961 ^
+                    (key.round << 4 | key.shape));
+        }
+    };
+
     class DBusHelper;
     DBusHelper *m_dBusHelper;
     class FontHelper;
@@ -560,6 +593,14 @@ private:
     mutable QColor m_coloredBackgroundCols[TOTAL_SHADES + 1];
     mutable QColor m_coloredHighlightCols[TOTAL_SHADES + 1];
     mutable QCache<QtcKey, QPixmap> m_pixmapCache;
+    mutable QCache<PathKey, QPainterPath> m_pathCache;
+    // Check marks for every color and scale, blitted from m_spritePixmap
+    // which is refreshed when the atlas changes.
+    mutable SpriteAtlas m_sprites;
+    mutable QPixmap m_spritePixmap;
+    mutable unsigned m_spriteGeneration;
+    mutable int m_checkGlyph;
+    mutable int m_checkXGlyph;
     mutable bool m_active;
     mutable const QWidget *m_sbWidget;
     mutable QLabel *m_clickedLabel;
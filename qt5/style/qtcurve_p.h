@@ -241,6 +241,7 @@ QToolBar *getToolBarChild(QWidget *w);
 void setStyleRecursive(QWidget *w, QStyle *s, int minSize);
 bool updateMenuBarEvent(QMouseEvent *event, QMenuBar *menu);
 QRegion windowMask(const QRect &r, bool full);
+void setWindowMask(QWidget *widget, bool full);
 const QWidget *getWidget(const QPainter *p);
 const QImage *getImage(const QPainter *p);
 const QAbstractButton *getButton(const QWidget *w, const QPainter *p);
@@ -282,6 +283,53 @@ void adjustToolbarButtons(const QWidget *widget, const QToolBar *toolbar,
                           int &bottomAdjust, int &round);
 bool isA(const QObject *w, const char *type);
 
+// Classes the style special cases by name. A class gets the flags of every
+// class it inherits from, see classFlags().
+enum ClassFlag {
+    CLASS_MENU_BAR = 1 << 0,
+    CLASS_SCROLL_AREA = 1 << 1,
+    CLASS_FILE_PLACES_VIEW = 1 << 2,
+    CLASS_COMBO_CONTAINER = 1 << 3,
+    CLASS_COMBO_LIST_VIEW = 1 << 4,
+    CLASS_MAIN_WINDOW = 1 << 5,
+    CLASS_STATUS_BAR = 1 << 6,
+    CLASS_LABEL = 1 << 7,
+    CLASS_FRAME = 1 << 8,
+    CLASS_PROGRESS_BAR = 1 << 9,
+    CLASS_TIP_LABEL = 1 << 10,
+    CLASS_WHATS_THAT = 1 << 11,
+    CLASS_PRINT_PROPERTIES_DIALOG = 1 << 12,
+    CLASS_WORKSPACE_TITLE_BAR = 1 << 13,
+    CLASS_DOCK_SEPARATOR = 1 << 14,
+    CLASS_DOCK_WIDGET_TITLE_BUTTON = 1 << 15,
+    CLASS_TOOL_BAR_EXTENSION = 1 << 16,
+    CLASS_K3B_THEMED_HEADER = 1 << 17,
+    CLASS_KCOLOR_PATCH = 1 << 18,
+    CLASS_KURL_BUTTON = 1 << 19,
+    CLASS_KO_DOCK_TITLE_BAR = 1 << 20,
+    CLASS_IDEAL_BUTTON_BAR = 1 << 21,
+    CLASS_WEB_VIEW = 1 << 22
+};
+
+// Flags of the class of \param w, computed once per QMetaObject by walking
+// its superClass() chain so that callers don't need inherits().
+unsigned classFlags(const QObject *w);
+// Forget the classes seen so far. Meta objects of unloaded plugins may be
+// freed and their addresses reused, so this is done whenever the style is
+// removed from the application (from the GUI thread, with nothing being
+// painted).
+void clearClassFlags();
+
+// Exports the QTCURVE_STATS counters of this process on the session bus.
+class StatsExporter: public QObject {
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kde.QtCurve.Stats")
+public:
+    using QObject::QObject;
+public Q_SLOTS:
+    Q_SCRIPTABLE QString report() const;
+};
+
 }
 
 // **** experiments (deactivated) to hunt down the cause of the issues drawing round(ed) objects in Qt5 **** //
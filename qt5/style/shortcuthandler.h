@@ -26,6 +26,8 @@
 #include <QObject>
 #include <QSet>
 #include <QList>
+#include <QHash>
+#include <QRect>
 
 class QWidget;
 
@@ -40,17 +42,25 @@ public:
     bool hasSeenAlt(const QWidget *widget) const;
     bool isAltDown() const { return m_altDown; }
     bool showShortcut(const QWidget *widget) const;
+    // Record that \param widget painted mnemonic text inside \param rect
+    // so that only that area is repainted when Alt is pressed or released.
+    void addMnemonic(const QWidget *widget, const QRect &rect);
 
 protected:
     void updateWidget(QWidget *w);
+    void updateWidget(QWidget *w, const QRect &rect);
     bool eventFilter(QObject *watched, QEvent *event) override;
 
 private:
     bool m_altDown;
     QSet<QWidget*> m_seenAlt;
-    QSet<QWidget*> m_updated;
+    // Widgets repainted because of Alt, with the area that was repainted.
+    QHash<QWidget*, QRect> m_updated;
+    // Widgets that have painted mnemonic text, with the text area.
+    QHash<QWidget*, QRect> m_mnemonics;
     QList<QWidget*> m_openMenus;
 
+    void watchWidget(QWidget *w);
     void widgetDestroyed(QObject *o);
 };
 
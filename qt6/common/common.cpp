@@ -51,6 +51,88 @@ qtcSetupGradient(Gradient *grad, EGradientBorder border, int numStops, ...)
     va_end(ap);
 }
 
+// The standard gradients, indexed by appearance - APPEARANCE_FLAT.
+struct StdGradient {
+    EGradientBorder border;
+    int numStops;
+    // position and value of each stop
+    double stops[4][2];
+};
+
+// APPEARANCE_FADE and APPEARANCE_FILE are not gradients
+#ifdef QTC_UTILS_QT
+#define QTC_NO_GRADIENT {GB_3D, 0, {}}
+#else
+#define QTC_NO_GRADIENT {GB_NONE, 0, {}}
+#endif
+
+static constexpr StdGradient stdGradientData[] = {
+    // APPEARANCE_FLAT
+    {GB_3D, 2, {{0.0, 1.0}, {1.0, 1.0}}},
+    // APPEARANCE_RAISED
+    {GB_3D_FULL, 2, {{0.0, 1.0}, {1.0, 1.0}}},
+    // APPEARANCE_DULL_GLASS
+    {GB_LIGHT, 4, {{0.0, 1.05}, {0.499, 0.984}, {0.5, 0.928}, {1.0, 1.0}}},
+    // APPEARANCE_SHINY_GLASS
+    {GB_LIGHT, 4, {{0.0, 1.2}, {0.499, 0.984}, {0.5, 0.9}, {1.0, 1.06}}},
+    // APPEARANCE_AGUA
+    {GB_SHINE, 2, {{0.0, 0.6}, {1.0, 1.1}}},
+    // APPEARANCE_SOFT_GRADIENT
+    {GB_3D, 2, {{0.0, 1.04}, {1.0, 0.98}}},
+    // APPEARANCE_GRADIENT
+    {GB_3D, 2, {{0.0, 1.1}, {1.0, 0.94}}},
+    // APPEARANCE_HARSH_GRADIENT
+    {GB_3D, 2, {{0.0, 1.3}, {1.0, 0.925}}},
+    // APPEARANCE_INVERTED
+    {GB_3D, 2, {{0.0, 0.93}, {1.0, 1.04}}},
+    // APPEARANCE_DARK_INVERTED
+    {GB_NONE, 3, {{0.0, 0.8}, {0.7, 0.95}, {1.0, 1.0}}},
+    // APPEARANCE_SPLIT_GRADIENT
+    {GB_3D, 4, {{0.0, 1.06}, {0.499, 1.004}, {0.5, 0.986}, {1.0, 0.92}}},
+    // APPEARANCE_BEVELLED
+    {GB_3D, 4, {{0.0, 1.05}, {0.1, 1.02}, {0.9, 0.985}, {1.0, 0.94}}},
+    // APPEARANCE_FADE
+    QTC_NO_GRADIENT,
+    // APPEARANCE_FILE
+    QTC_NO_GRADIENT,
+    // APPEARANCE_LV_BEVELLED
+    {GB_3D, 3, {{0.0, 1.00}, {0.85, 1.0}, {1.0, 0.90}}},
+    // APPEARANCE_AGUA_MOD
+    {GB_NONE, 3, {{0.0, 1.5}, {0.49, 0.85}, {1.0, 1.3}}},
+    // APPEARANCE_LV_AGUA
+    {GB_NONE, 4, {{0.0, 0.98}, {0.35, 0.95}, {0.4, 0.93}, {1.0, 1.15}}},
+};
+#undef QTC_NO_GRADIENT
+static_assert(sizeof(stdGradientData) / sizeof(stdGradientData[0]) ==
+              NUM_STD_APP, "Missing standard gradient");
+
+static const Gradient*
+createStdGradients()
+{
+    static Gradient grads[NUM_STD_APP];
+#ifndef QTC_UTILS_QT
+    static GradientStop stops[NUM_STD_APP][4];
+#endif
+    for (int i = 0;i < NUM_STD_APP;i++) {
+        const StdGradient &data = stdGradientData[i];
+        grads[i].border = data.border;
+#ifndef QTC_UTILS_QT
+        grads[i].numStops = data.numStops;
+        grads[i].stops = data.numStops ? stops[i] : nullptr;
+#endif
+        for (int j = 0;j < data.numStops;j++) {
+#ifdef QTC_UTILS_QT
+            grads[i].stops.insert(GradientStop(data.stops[j][0],
+                                               data.stops[j][1]));
+#else
+            stops[i][j] = GradientStop{data.stops[j][0], data.stops[j][1],
+                                       1.0};
+#endif
+        }
+    }
+    return grads;
+}
+
 const Gradient*
 qtcGetGradient(EAppearance app, const Options *opts)
 {
@@ -71,58 +153,7 @@ qtcGetGradient(EAppearance app, const Options *opts)
         app = APPEARANCE_RAISED;
     }
 
-    static Gradient stdGradients[NUM_STD_APP];
-    static bool init = false;
-
-    if (!init) {
-        qtcSetupGradient(&stdGradients[APPEARANCE_FLAT - APPEARANCE_FLAT],
-                         GB_3D, 2, 0.0, 1.0, 1.0, 1.0);
-        qtcSetupGradient(&stdGradients[APPEARANCE_RAISED - APPEARANCE_FLAT],
-                         GB_3D_FULL, 2, 0.0, 1.0, 1.0, 1.0);
-        qtcSetupGradient(&stdGradients[APPEARANCE_DULL_GLASS -
-                                       APPEARANCE_FLAT], GB_LIGHT, 4, 0.0,
-                         1.05, 0.499, 0.984, 0.5, 0.928,
-                         1.0, 1.0);
-        qtcSetupGradient(&stdGradients[APPEARANCE_SHINY_GLASS -
-                                       APPEARANCE_FLAT], GB_LIGHT, 4, 0.0,
-                         1.2, 0.499, 0.984, 0.5, 0.9,
-                         1.0, 1.06);
-        qtcSetupGradient(&stdGradients[APPEARANCE_AGUA - APPEARANCE_FLAT],
-                         GB_SHINE, 2, 0.0, 0.6, 1.0, 1.1);
-        qtcSetupGradient(&stdGradients[APPEARANCE_SOFT_GRADIENT -
-                                       APPEARANCE_FLAT], GB_3D, 2, 0.0,
-                         1.04, 1.0, 0.98);
-        qtcSetupGradient(
-            &stdGradients[APPEARANCE_GRADIENT - APPEARANCE_FLAT], GB_3D, 2,
-            0.0, 1.1, 1.0, 0.94);
-        qtcSetupGradient(&stdGradients[APPEARANCE_HARSH_GRADIENT -
-                                       APPEARANCE_FLAT], GB_3D, 2, 0.0, 1.3,
-                         1.0, 0.925);
-        qtcSetupGradient(
-            &stdGradients[APPEARANCE_INVERTED - APPEARANCE_FLAT], GB_3D, 2,
-            0.0, 0.93, 1.0, 1.04);
-        qtcSetupGradient(&stdGradients[APPEARANCE_DARK_INVERTED -
-                                       APPEARANCE_FLAT], GB_NONE, 3, 0.0,
-                         0.8, 0.7, 0.95, 1.0, 1.0);
-        qtcSetupGradient(&stdGradients[APPEARANCE_SPLIT_GRADIENT -
-                                       APPEARANCE_FLAT], GB_3D, 4, 0.0,
-                         1.06, 0.499, 1.004, 0.5, 0.986,
-                         1.0, 0.92);
-        qtcSetupGradient(
-            &stdGradients[APPEARANCE_BEVELLED - APPEARANCE_FLAT], GB_3D, 4,
-            0.0, 1.05, 0.1, 1.02, 0.9, 0.985, 1.0, 0.94);
-        qtcSetupGradient(&stdGradients[APPEARANCE_LV_BEVELLED -
-                                       APPEARANCE_FLAT], GB_3D, 3, 0.0,
-                         1.00, 0.85, 1.0, 1.0, 0.90);
-        qtcSetupGradient(
-            &stdGradients[APPEARANCE_AGUA_MOD - APPEARANCE_FLAT], GB_NONE,
-            3, 0.0, 1.5, 0.49, 0.85, 1.0, 1.3);
-        qtcSetupGradient(
-            &stdGradients[APPEARANCE_LV_AGUA - APPEARANCE_FLAT], GB_NONE, 4,
-            0.0, 0.98, 0.35, 0.95, 0.4, 0.93, 1.0, 1.15);
-        init = true;
-    }
-
+    static const Gradient *const stdGradients = createStdGradients();
     return &stdGradients[app - APPEARANCE_FLAT];
 }
 
@@ -22,6 +22,9 @@
 
 #include <qtcurve-utils/dirs.h>
 #include <qtcurve-utils/color.h>
+#include <qtcurve-utils/rcfile.h>
+#include <qtcurve-utils/trace.h>
+#include <qtcurve-utils/stats.h>
 #include "common.h"
 #include "config_file.h"
 
@@ -74,436 +77,23 @@ qtcSetRgb(QColor *col, const char *str)
     }
 }
 
-static bool
-loadImage(const QString &file, QtCPixmap *pixmap)
-{
-    // Need to store filename for config dialog!
-    QString f(determineFileName(file));
-    pixmap->file = f;
-    return pixmap->img.load(f);
-}
-
-static EDefBtnIndicator
-toInd(const char *str, EDefBtnIndicator def)
-{
-    if (str && str[0]) {
-        if(0==strncmp(str, "fontcolor", 9) || 0==strncmp(str, "border", 6))
-            return IND_FONT_COLOR;
-        if(0==strncmp(str, "none", 4))
-            return IND_NONE;
-        if(0==strncmp(str, "corner", 6))
-            return IND_CORNER;
-        if(0==strncmp(str, "colored", 7))
-            return IND_COLORED;
-        if(0==strncmp(str, "tint", 4))
-            return IND_TINT;
-        if(0==strncmp(str, "glow", 4))
-            return IND_GLOW;
-        if(0==strncmp(str, "darken", 6))
-            return IND_DARKEN;
-        if(0==strncmp(str, "origselected", 12))
-            return IND_SELECTED;
-    }
-    return def;
-}
-
-static ELine
-toLine(const char *str, ELine def)
-{
-    if (str && str[0]) {
-        if(0==strncmp(str, "dashes", 6))
-            return LINE_DASHES;
-        if(0==strncmp(str, "none", 4))
-            return LINE_NONE;
-        if(0==strncmp(str, "sunken", 6))
-            return LINE_SUNKEN;
-        if(0==strncmp(str, "dots", 4))
-            return LINE_DOTS;
-        if(0==strncmp(str, "flat", 4))
-            return LINE_FLAT;
-        if(0==strncmp(str, "1dot", 5))
-            return LINE_1DOT;
-    }
-    return def;
-}
-
-static ETBarBorder
-toTBarBorder(const char *str, ETBarBorder def)
-{
-    if (str && str[0]) {
-        if(0==strncmp(str, "dark", 4))
-            return 0==strncmp(&str[4], "-all", 4) ? TB_DARK_ALL : TB_DARK;
-        if(0==strncmp(str, "none", 4))
-            return TB_NONE;
-        if(0==strncmp(str, "light", 5))
-            return 0==strncmp(&str[5], "-all", 4) ? TB_LIGHT_ALL : TB_LIGHT;
-    }
-    return def;
-}
-
-static EMouseOver
-toMouseOver(const char *str, EMouseOver def)
-{
-    if (str && str[0]) {
-        if(0==strncmp(str, "true", 4) || 0==strncmp(str, "colored", 7))
-            return MO_COLORED;
-        if(0==strncmp(str, "thickcolored", 12))
-            return MO_COLORED_THICK;
-        if(0==strncmp(str, "plastik", 7))
-            return MO_PLASTIK;
-        if(0==strncmp(str, "glow", 4))
-            return MO_GLOW;
-        if(0==strncmp(str, "false", 4) || 0==strncmp(str, "none", 4))
-            return MO_NONE;
-    }
-    return def;
-}
-
-static EAppearance
-toAppearance(const char *str, EAppearance def, EAppAllow allow,
-             QtCPixmap *pix, bool checkImage)
-{
-    if (str && str[0]) {
-        if(0==strncmp(str, "flat", 4))
-            return APPEARANCE_FLAT;
-        if(0==strncmp(str, "raised", 6))
-            return APPEARANCE_RAISED;
-        if(0==strncmp(str, "dullglass", 9))
-            return APPEARANCE_DULL_GLASS;
-        if(0==strncmp(str, "glass", 5) || 0==strncmp(str, "shinyglass", 10))
-            return APPEARANCE_SHINY_GLASS;
-        if(0==strncmp(str, "agua", 4))
-            return APPEARANCE_AGUA;
-        if(0==strncmp(str, "soft", 4))
-            return APPEARANCE_SOFT_GRADIENT;
-        if(0==strncmp(str, "gradient", 8) || 0==strncmp(str, "lightgradient", 13))
-            return APPEARANCE_GRADIENT;
-        if(0==strncmp(str, "harsh", 5))
-            return APPEARANCE_HARSH_GRADIENT;
-        if(0==strncmp(str, "inverted", 8))
-            return APPEARANCE_INVERTED;
-        if(0==strncmp(str, "darkinverted", 12))
-            return APPEARANCE_DARK_INVERTED;
-        if(0==strncmp(str, "splitgradient", 13))
-            return APPEARANCE_SPLIT_GRADIENT;
-        if(0==strncmp(str, "bevelled", 8))
-            return APPEARANCE_BEVELLED;
-        if(APP_ALLOW_FADE==allow && 0==strncmp(str, "fade", 4))
-            return APPEARANCE_FADE;
-        if(APP_ALLOW_STRIPED==allow && 0==strncmp(str, "striped", 7))
-            return APPEARANCE_STRIPED;
-        if(APP_ALLOW_NONE==allow && 0==strncmp(str, "none", 4))
-            return APPEARANCE_NONE;
-        if (pix && APP_ALLOW_STRIPED==allow && 0==strncmp(str, "file", 4) && strlen(str)>9)
-            return loadImage(&str[5], pix) || !checkImage ? APPEARANCE_FILE : def;
-
-        if(0==strncmp(str, "customgradient", 14) && strlen(str)>14)
-        {
-            int i=atoi(&str[14]);
-
-            i--;
-            if(i>=0 && i<NUM_CUSTOM_GRAD)
-                return (EAppearance)(APPEARANCE_CUSTOM1+i);
-        }
-    }
-    return def;
-}
-
-static EShade
-toShade(const char *str, bool allowMenu, EShade def,
-        bool menuShade, QColor *col)
-{
-    if (str && str[0]) {
-        /* true/false is from 0.25... */
-        if((!menuShade && 0==strncmp(str, "true", 4)) || 0==strncmp(str, "selected", 8))
-            return SHADE_BLEND_SELECTED;
-        if(0==strncmp(str, "origselected", 12))
-            return SHADE_SELECTED;
-        if(allowMenu && (0==strncmp(str, "darken", 6) || (menuShade && 0==strncmp(str, "true", 4))))
-            return SHADE_DARKEN;
-        if(allowMenu && 0==strncmp(str, "wborder", 7))
-            return SHADE_WINDOW_BORDER;
-        if(0==strncmp(str, "custom", 6))
-            return SHADE_CUSTOM;
-        if('#'==str[0] && col)
-        {
-            qtcSetRgb(col, str);
-            return SHADE_CUSTOM;
-        }
-        if(0==strncmp(str, "none", 4))
-            return SHADE_NONE;
-    }
-
-    return def;
-}
-
-/* Prior to 0.42 round was a bool - so need to read 'false' as 'none' */
-static ERound
-toRound(const char *str, ERound def)
-{
-    if (str && str[0]) {
-        if(0==strncmp(str, "none", 4) || 0==strncmp(str, "false", 5))
-            return ROUND_NONE;
-        if(0==strncmp(str, "slight", 6))
-            return ROUND_SLIGHT;
-        if(0==strncmp(str, "full", 4))
-            return ROUND_FULL;
-        if(0==strncmp(str, "extra", 5))
-            return ROUND_EXTRA;
-        if(0==strncmp(str, "max", 3))
-            return ROUND_MAX;
-    }
-    return def;
-}
-
-static EScrollbar
-toScrollbar(const char *str, EScrollbar def)
-{
-    return QtCurve::Config::loadValue<EScrollbar>(str, def);
-}
-
-static EFrame
-toFrame(const char *str, EFrame def)
-{
-    return QtCurve::Config::loadValue<EFrame>(str, def);
-}
-
-static EEffect
-toEffect(const char *str, EEffect def)
-{
-    if (str && str[0]) {
-        if(0==strncmp(str, "none", 4))
-            return EFFECT_NONE;
-        if(0==strncmp(str, "shadow", 6))
-            return EFFECT_SHADOW;
-        if(0==strncmp(str, "etch", 4))
-            return EFFECT_ETCH;
-    }
-
-    return def;
-}
-
-static Shading
-toShading(const char *str, Shading def)
-{
-    return QtCurve::Config::loadValue<Shading>(str, def);
-}
-
-static EStripe
-toStripe(const char *str, EStripe def)
-{
-    if (str && str[0]) {
-        if(0==strncmp(str, "plain", 5) || 0==strncmp(str, "true", 4))
-            return STRIPE_PLAIN;
-        if(0==strncmp(str, "none", 4) || 0==strncmp(str, "false", 5))
-            return STRIPE_NONE;
-        if(0==strncmp(str, "diagonal", 8))
-            return STRIPE_DIAGONAL;
-        if(0==strncmp(str, "fade", 4))
-            return STRIPE_FADE;
-    }
-
-    return def;
-}
-
-static ESliderStyle toSlider(const char *str, ESliderStyle def)
-{
-    if(str && 0!=str[0])
-    {
-        if(0==strncmp(str, "round", 5))
-            return SLIDER_ROUND;
-        if(0==strncmp(str, "plain", 5))
-            return SLIDER_PLAIN;
-        if(0==strncmp(str, "r-round", 7))
-            return SLIDER_ROUND_ROTATED;
-        if(0==strncmp(str, "r-plain", 7))
-            return SLIDER_PLAIN_ROTATED;
-        if(0==strncmp(str, "triangular", 10))
-            return SLIDER_TRIANGULAR;
-        if(0==strncmp(str, "circular", 8))
-            return SLIDER_CIRCULAR;
-    }
-
-    return def;
-}
-
-static EColor toEColor(const char *str, EColor def)
-{
-    if(str && 0!=str[0])
-    {
-        if(0==strncmp(str, "base", 4))
-            return ECOLOR_BASE;
-        if(0==strncmp(str, "dark", 4))
-            return ECOLOR_DARK;
-        if(0==strncmp(str, "background", 10))
-            return ECOLOR_BACKGROUND;
-    }
-
-    return def;
-}
-
-static EFocus toFocus(const char *str, EFocus def)
-{
-    if(str && 0!=str[0])
-    {
-        if(0==strncmp(str, "standard", 8))
-            return FOCUS_STANDARD;
-        if(0==strncmp(str, "rect", 4) || 0==strncmp(str, "highlight", 9))
-            return FOCUS_RECTANGLE;
-        if(0==strncmp(str, "filled", 6))
-            return FOCUS_FILLED;
-        if(0==strncmp(str, "full", 4))
-            return FOCUS_FULL;
-        if(0==strncmp(str, "line", 4))
-            return FOCUS_LINE;
-        if(0==strncmp(str, "glow", 4))
-            return FOCUS_GLOW;
-        if(0==strncmp(str, "none", 4))
-            return FOCUS_NONE;
-    }
-
-    return def;
-}
-
-static ETabMo toTabMo(const char *str, ETabMo def)
-{
-    if(str && 0!=str[0])
-    {
-        if(0==strncmp(str, "top", 3))
-            return TAB_MO_TOP;
-        if(0==strncmp(str, "bot", 3))
-            return TAB_MO_BOTTOM;
-        if(0==strncmp(str, "glow", 4))
-            return TAB_MO_GLOW;
-    }
-
-    return def;
-}
-
-static EGradType toGradType(const char *str, EGradType def)
-{
-    if(str && 0!=str[0])
-    {
-        if(0==strncmp(str, "horiz", 5))
-            return GT_HORIZ;
-        if(0==strncmp(str, "vert", 4))
-            return GT_VERT;
-    }
-    return def;
-}
-
-static bool toLvLines(const char *str, bool def)
-{
-    if(str && 0!=str[0])
-    {
-#if 0
-        if(0==strncmp(str, "true", 4) || 0==strncmp(str, "new", 3))
-            return LV_NEW;
-        if(0==strncmp(str, "old", 3))
-            return LV_OLD;
-        if(0==strncmp(str, "false", 5) || 0==strncmp(str, "none", 4))
-            return LV_NONE;
-#else
-        return 0!=strncmp(str, "false", 5);
-#endif
-    }
-    return def;
-}
-
-static EGradientBorder toGradientBorder(const char *str, bool *haveAlpha)
-{
-    if (str && str[0]) {
-        *haveAlpha = strstr(str, "-alpha") ? true : false;
-        if(0==strncmp(str, "light", 5) || 0==strncmp(str, "true", 4))
-            return GB_LIGHT;
-        if(0==strncmp(str, "none", 4))
-            return GB_NONE;
-        if(0==strncmp(str, "3dfull", 6))
-            return GB_3D_FULL;
-        if(0==strncmp(str, "3d", 2) || 0==strncmp(str, "false", 5))
-            return GB_3D;
-        if(0==strncmp(str, "shine", 5))
-            return GB_SHINE;
-    }
-    return GB_3D;
-}
+namespace {
 
-static EAlign toAlign(const char *str, EAlign def)
-{
-    if(str && 0!=str[0])
-    {
-        if(0==strncmp(str, "left", 4))
-            return ALIGN_LEFT;
-        if(0==strncmp(str, "center-full", 11))
-            return ALIGN_FULL_CENTER;
-        if(0==strncmp(str, "center", 6))
-            return ALIGN_CENTER;
-        if(0==strncmp(str, "right", 5))
-            return ALIGN_RIGHT;
-    }
-    return def;
-}
-
-static ETitleBarIcon toTitlebarIcon(const char *str, ETitleBarIcon def)
-{
-    if(str && 0!=str[0])
-    {
-        if(0==strncmp(str, "none", 4))
-            return TITLEBAR_ICON_NONE;
-        if(0==strncmp(str, "menu", 4))
-            return TITLEBAR_ICON_MENU_BUTTON;
-        if(0==strncmp(str, "title", 5))
-            return TITLEBAR_ICON_NEXT_TO_TITLE;
-    }
-    return def;
-}
-
-static EImageType toImageType(const char *str, EImageType def)
-{
-    if(str && 0!=str[0])
+struct ConfigAdapter {
+    static void
+    setColor(QColor *col, const char *str)
     {
-        if(0==strncmp(str, "none", 4))
-            return IMG_NONE;
-        if(0==strncmp(str, "plainrings", 10))
-            return IMG_PLAIN_RINGS;
-        if(0==strncmp(str, "rings", 5))
-            return IMG_BORDERED_RINGS;
-        if(0==strncmp(str, "squarerings", 11))
-            return IMG_SQUARE_RINGS;
-        if(0==strncmp(str, "file", 4))
-            return IMG_FILE;
+        qtcSetRgb(col, str);
     }
-    return def;
-}
-
-static EGlow toGlow(const char *str, EGlow def)
-{
-    if(str && 0!=str[0])
+    static bool
+    loadPixmap(const char *file, QtCPixmap *pixmap, bool load)
     {
-        if(0==strncmp(str, "none", 4))
-            return GLOW_NONE;
-        if(0==strncmp(str, "start", 5))
-            return GLOW_START;
-        if(0==strncmp(str, "middle", 6))
-            return GLOW_MIDDLE;
-        if(0==strncmp(str, "end", 3))
-            return GLOW_END;
+        // Need to store filename for config dialog!
+        pixmap->file = determineFileName(file);
+        return !load || pixmap->img.load(pixmap->file);
     }
-    return def;
-}
+};
 
-static ETBarBtn toTBarBtn(const char *str, ETBarBtn def)
-{
-    if(str && 0!=str[0])
-    {
-        if(0==strncmp(str, "standard", 8))
-            return TBTN_STANDARD;
-        if(0==strncmp(str, "raised", 6))
-            return TBTN_RAISED;
-        if(0==strncmp(str, "joined", 6))
-            return TBTN_JOINED;
-    }
-    return def;
 }
 
 WindowBorders qtcGetWindowBorderSize(bool force)
@@ -588,72 +178,31 @@ checkColor(EShade *s, QColor *c)
     }
 }
 
-class QtCConfig {
-public:
-    QtCConfig(const QString &filename);
-
-    bool ok() const {return values.count() > 0;}
-    bool hasKey(const QString &key) {return values.contains(key);}
-    QString readEntry(const QString &key, const QString &def=QString());
-private:
-    QMap<QString, QString> values;
-};
-
-QtCConfig::QtCConfig(const QString &filename)
-{
-    QFile f(filename);
-
-    if (f.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&f);
-        QString     line;
-
-        while(!stream.atEnd())
-        {
-            line = stream.readLine();
-            int pos=line.indexOf('=');
-            if(-1!=pos)
-                values[line.left(pos)]=line.mid(pos+1);
-        }
-        f.close();
-    }
-}
-
-inline QString
-QtCConfig::readEntry(const QString &key, const QString &def)
+static inline QString
+readStringEntry(const QtCurve::Config::RcFile &cfg, const char *key)
 {
-    return values.contains(key) ? values[key] : def;
+    return QString::fromUtf8(cfg.value(key));
 }
 
-inline QString readStringEntry(QtCConfig &cfg, const QString &key)
+static inline int
+readNumEntry(const QtCurve::Config::RcFile &cfg, const char *key, int def)
 {
-    return cfg.readEntry(key);
+    return cfg.intValue(key, def);
 }
 
-static int readNumEntry(QtCConfig &cfg, const QString &key, int def)
+static inline int
+readVersionEntry(const QtCurve::Config::RcFile &cfg, const char *key)
 {
-    const QString &val(readStringEntry(cfg, key));
-
-    return val.isEmpty() ? def : val.toInt();
+    return cfg.versionValue(key);
 }
 
-static int readVersionEntry(QtCConfig &cfg, const QString &key)
+static inline bool
+readBoolEntry(const QtCurve::Config::RcFile &cfg, const char *key, bool def)
 {
-    const QString &val(readStringEntry(cfg, key));
-    int           major, minor, patch;
-
-    return !val.isEmpty() && 3==sscanf(TO_LATIN1(val), "%d.%d.%d", &major, &minor, &patch)
-            ? qtcMakeVersion(major, minor, patch)
-            : 0;
+    return cfg.boolValue(key, def);
 }
 
-static bool readBoolEntry(QtCConfig &cfg, const QString &key, bool def)
-{
-    const QString &val(readStringEntry(cfg, key));
-
-    return val.isEmpty() ? def : (val==QLatin1String("true") ? true : false);
-}
-
-static void readDoubleList(QtCConfig &cfg, const char *key, double *list, int count)
+static void readDoubleList(const QtCurve::Config::RcFile &cfg, const char *key, double *list, int count)
 {
     QStringList strings(readStringEntry(cfg, key).split(',', Qt::SkipEmptyParts));
     bool ok(count==strings.size());
@@ -671,25 +220,15 @@ static void readDoubleList(QtCConfig &cfg, const char *key, double *list, int co
         list[0]=0;
 }
 
-#define CFG_READ_COLOR(ENTRY) do {                      \
-        QString sVal(cfg.readEntry(#ENTRY));            \
-        if (sVal.isEmpty()) {                           \
-            opts->ENTRY = def->ENTRY;                   \
-        } else {                                        \
-            qtcSetRgb(&opts->ENTRY, TO_LATIN1(sVal));   \
-        }                                               \
-    } while (0)
-
 #define CFG_READ_IMAGE(ENTRY) do {                                      \
         opts->ENTRY.type =                                              \
-            toImageType(TO_LATIN1(readStringEntry(cfg, #ENTRY)),        \
-                        def->ENTRY.type);                               \
+            cfg.value<EImageType>(#ENTRY, def->ENTRY.type);             \
         opts->ENTRY.loaded = false;                                     \
         opts->ENTRY.width = opts->ENTRY.height = 0;                     \
         opts->ENTRY.onBorder = false;                                   \
         opts->ENTRY.pos = PP_TR;                                        \
         if (opts->ENTRY.type == IMG_FILE) {                             \
-            QString file(cfg.readEntry(#ENTRY ".file"));                \
+            QString file(readStringEntry(cfg, #ENTRY ".file"));         \
             if (!file.isEmpty()) {                                      \
                 opts->ENTRY.pixmap.file = file;                         \
                 opts->ENTRY.width = readNumEntry(cfg, #ENTRY ".width", 0); \
@@ -711,137 +250,6 @@ static void readDoubleList(QtCConfig &cfg, const char *key, double *list, int co
         opts->ENTRY = set.count() || cfg.hasKey(#ENTRY) ? set : def->ENTRY; \
     } while (0)
 
-#define CFG_READ_BOOL(ENTRY) do {                               \
-        opts->ENTRY = readBoolEntry(cfg, #ENTRY, def->ENTRY);   \
-    } while (0)
-
-#define CFG_READ_ROUND(ENTRY) do {                                      \
-        opts->ENTRY = toRound(TO_LATIN1(readStringEntry(cfg, #ENTRY)),  \
-                              def->ENTRY);                              \
-    } while (0)
-
-#define CFG_READ_INT(ENTRY) do {                                \
-        opts->ENTRY = readNumEntry(cfg, #ENTRY, def->ENTRY);    \
-    } while (0)
-
-#define CFG_READ_INT_BOOL(ENTRY, DEF) do {                              \
-        if (readBoolEntry(cfg, #ENTRY, false)) {                        \
-            opts->ENTRY = DEF;                                          \
-        } else {                                                        \
-            opts->ENTRY = readNumEntry(cfg, #ENTRY, def->ENTRY);        \
-        }                                                               \
-    } while (0)
-
-#define CFG_READ_TB_BORDER(ENTRY) do {                                  \
-        opts->ENTRY = toTBarBorder(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                                   def->ENTRY);                         \
-    } while (0)
-
-#define CFG_READ_MOUSE_OVER(ENTRY) do {                                 \
-        opts->ENTRY = toMouseOver(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                                  def->ENTRY);                          \
-    } while (0)
-
-#define CFG_READ_APPEARANCE(ENTRY, ALLOW) do {                          \
-        opts->ENTRY = toAppearance(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                                   def->ENTRY, ALLOW, nullptr, false);     \
-    } while (0)
-
-#define CFG_READ_APPEARANCE_PIXMAP(ENTRY, ALLOW, PIXMAP, CHECK) do {    \
-        opts->ENTRY = toAppearance(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                                   def->ENTRY, ALLOW, PIXMAP, CHECK);   \
-    } while (0)
-
-#define CFG_READ_STRIPE(ENTRY) do {                                     \
-        opts->ENTRY=toStripe(TO_LATIN1(readStringEntry(cfg, #ENTRY)),   \
-                             def->ENTRY);                               \
-    } while (0)
-
-#define CFG_READ_SLIDER(ENTRY) do {                                     \
-        opts->ENTRY = toSlider(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                             def->ENTRY);                               \
-    } while (0)
-
-#define CFG_READ_DEF_BTN(ENTRY) do {                                    \
-        opts->ENTRY = toInd(TO_LATIN1(readStringEntry(cfg, #ENTRY)),    \
-                            def->ENTRY);                                \
-    } while (0)
-
-#define CFG_READ_LINE(ENTRY) do {                                       \
-        opts->ENTRY = toLine(TO_LATIN1(readStringEntry(cfg, #ENTRY)),   \
-                             def->ENTRY);                               \
-    } while (0)
-
-#define CFG_READ_SHADE(ENTRY, AD, MENU_STRIPE, COL) do {                \
-        opts->ENTRY = toShade(TO_LATIN1(readStringEntry(cfg, #ENTRY)), AD, \
-                              def->ENTRY, MENU_STRIPE, COL);            \
-    } while (0)
-
-#define CFG_READ_SCROLLBAR(ENTRY) do {                                  \
-        opts->ENTRY = toScrollbar(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                                  def->ENTRY);                          \
-    } while (0)
-
-#define CFG_READ_FRAME(ENTRY) do {                                      \
-        opts->ENTRY = toFrame(TO_LATIN1(readStringEntry(cfg, #ENTRY)),  \
-                              def->ENTRY);                              \
-    } while (0)
-
-#define CFG_READ_EFFECT(ENTRY) do {                                     \
-        opts->ENTRY = toEffect(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                               def->ENTRY);                             \
-    } while (0)
-
-#define CFG_READ_SHADING(ENTRY) do {                                    \
-        opts->ENTRY = toShading(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                                def->ENTRY);                            \
-    } while (0)
-
-#define CFG_READ_ECOLOR(ENTRY) do {                                     \
-        opts->ENTRY = toEColor(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                               def->ENTRY);                             \
-    } while (0)
-
-#define CFG_READ_FOCUS(ENTRY) do {                                      \
-        opts->ENTRY = toFocus(TO_LATIN1(readStringEntry(cfg, #ENTRY)),  \
-                              def->ENTRY);                              \
-    } while (0)
-
-#define CFG_READ_TAB_MO(ENTRY) do {                                     \
-        opts->ENTRY = toTabMo(TO_LATIN1(readStringEntry(cfg, #ENTRY)),  \
-                              def->ENTRY);                              \
-    } while (0)
-
-#define CFG_READ_GRAD_TYPE(ENTRY) do {                                  \
-        opts->ENTRY = toGradType(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                                 def->ENTRY);                           \
-    } while (0)
-
-#define CFG_READ_LV_LINES(ENTRY) do {                                   \
-        opts->ENTRY = toLvLines(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                                def->ENTRY);                            \
-    } while (0)
-
-#define CFG_READ_ALIGN(ENTRY) do {                                      \
-        opts->ENTRY = toAlign(TO_LATIN1(readStringEntry(cfg, #ENTRY)),  \
-                              def->ENTRY);                              \
-    } while (0)
-
-#define CFG_READ_TB_ICON(ENTRY) do {                                    \
-        opts->ENTRY = toTitlebarIcon(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                                     def->ENTRY);                       \
-    } while (0)
-
-#define CFG_READ_GLOW(ENTRY) do {                                       \
-        opts->ENTRY = toGlow(TO_LATIN1(readStringEntry(cfg, #ENTRY)),   \
-                             def->ENTRY);                               \
-    } while (0)
-
-#define CFG_READ_TBAR_BTN(ENTRY) do {                                   \
-        opts->ENTRY = toTBarBtn(TO_LATIN1(readStringEntry(cfg, #ENTRY)), \
-                                def->ENTRY);                            \
-    } while (0)
-
 static void checkAppearance(EAppearance *ap, Options *opts)
 {
     if(*ap>=APPEARANCE_CUSTOM1 && *ap<(APPEARANCE_CUSTOM1+NUM_CUSTOM_GRAD))
@@ -1070,25 +478,37 @@ void qtcCheckConfig(Options *opts)
         opts->toolbarSeparators=LINE_DOTS;
 }
 
+static QString
+userConfigFile()
+{
+    const char *env=getenv("QTCURVE_CONFIG_FILE");
+
+    if (nullptr != env)
+        return QFile::decodeName(env);
+
+    const char *cfgDir=QtCurve::getConfDir();
+    if(cfgDir) {
+        QString filename(QFile::decodeName(cfgDir) + CONFIG_FILE);
+
+        if(!QFile::exists(filename))
+            filename = QFile::decodeName(cfgDir) + "../" OLD_CONFIG_FILE;
+        return filename;
+    }
+    return QString();
+}
+
 bool qtcReadConfig(const QString &file, Options *opts, Options *defOpts, bool checkImages)
 {
+    QTC_TRACE_SCOPE("qtcReadConfig");
     if (file.isEmpty()) {
-        const char *env=getenv("QTCURVE_CONFIG_FILE");
-
-        if (nullptr != env) {
-            return qtcReadConfig(env, opts, defOpts);
-        } else {
-            const char *cfgDir=QtCurve::getConfDir();
-            if(cfgDir) {
-                QString filename(QFile::decodeName(cfgDir) + CONFIG_FILE);
+        QString filename(userConfigFile());
 
-                if(!QFile::exists(filename))
-                    filename = QFile::decodeName(cfgDir) + "../" OLD_CONFIG_FILE;
-                return qtcReadConfig(filename, opts, defOpts);
-            }
-        }
+        if (!filename.isEmpty())
+            return qtcReadConfig(filename, opts, defOpts, checkImages);
     } else {
-        QtCConfig cfg(file);
+        QtCurve::Stats::Timer timer(QtCurve::Stats::Counter::ConfigLoad,
+                                    QtCurve::Stats::Counter::ConfigLoadTime);
+        QtCurve::Config::RcFile cfg(QFile::encodeName(file).constData());
         if (cfg.ok()) {
             int i;
             opts->version = readVersionEntry(cfg, VERSION_KEY);
@@ -1103,247 +523,8 @@ bool qtcReadConfig(const QString &file, Options *opts, Options *defOpts, bool ch
 
             if(opts!=def)
                 opts->customGradient=def->customGradient;
-            /* Check if the config file expects old default values... */
-            if(opts->version<qtcMakeVersion(1, 6))
-            {
-                bool framelessGroupBoxes=readBoolEntry(cfg, "framelessGroupBoxes", true),
-                     groupBoxLine=readBoolEntry(cfg, "groupBoxLine", true);
-                opts->groupBox=framelessGroupBoxes ? (groupBoxLine ? FRAME_LINE : FRAME_NONE) : FRAME_PLAIN;
-                opts->gbLabel=framelessGroupBoxes ? GB_LBL_BOLD : 0;
-                opts->gbFactor=0;
-                def->focus=FOCUS_LINE;
-                def->crHighlight=3;
-            } else {
-                CFG_READ_FRAME(groupBox);
-                CFG_READ_INT(gbLabel);
-            }
-
-            if(opts->version<qtcMakeVersion(1, 5))
-            {
-                opts->windowBorder=
-                    (readBoolEntry(cfg, "colorTitlebarOnly", def->windowBorder&WINDOW_BORDER_COLOR_TITLEBAR_ONLY)
-                                                                ? WINDOW_BORDER_COLOR_TITLEBAR_ONLY : 0)+
-                    (readBoolEntry(cfg, "titlebarBorder", def->windowBorder&WINDOW_BORDER_ADD_LIGHT_BORDER)
-                                                                ? WINDOW_BORDER_ADD_LIGHT_BORDER : 0)+
-                    (readBoolEntry(cfg, "titlebarBlend", def->windowBorder&WINDOW_BORDER_BLEND_TITLEBAR)
-                                                                ? WINDOW_BORDER_BLEND_TITLEBAR : 0);
-            }
-            else
-                CFG_READ_INT(windowBorder);
-
-            if(opts->version<qtcMakeVersion(1, 7))
-            {
-                opts->windowBorder|=WINDOW_BORDER_FILL_TITLEBAR;
-                def->square=SQUARE_POPUP_MENUS;
-            }
-
-            if(opts->version<qtcMakeVersion(1, 4))
-            {
-                opts->square=
-                    (readBoolEntry(cfg, "squareLvSelection", def->square&SQUARE_LISTVIEW_SELECTION) ? SQUARE_LISTVIEW_SELECTION : SQUARE_NONE)+
-                    (readBoolEntry(cfg, "squareScrollViews", def->square&SQUARE_SCROLLVIEW) ? SQUARE_SCROLLVIEW : SQUARE_NONE)+
-                    (readBoolEntry(cfg, "squareProgress", def->square&SQUARE_PROGRESS) ? SQUARE_PROGRESS : SQUARE_NONE)+
-                    (readBoolEntry(cfg, "squareEntry", def->square&SQUARE_ENTRY)? SQUARE_ENTRY : SQUARE_NONE);
-            }
-            else
-                CFG_READ_INT(square);
-            if(opts->version<qtcMakeVersion(1, 7))
-            {
-                def->tbarBtns=TBTN_STANDARD;
-                opts->thin=(readBoolEntry(cfg, "thinnerMenuItems", def->thin&THIN_MENU_ITEMS) ? THIN_MENU_ITEMS : 0)+
-                           (readBoolEntry(cfg, "thinnerBtns", def->thin&THIN_BUTTONS) ? THIN_BUTTONS : 0);
-            }
-            else
-            {
-                CFG_READ_INT(thin);
-            }
-            if(opts->version<qtcMakeVersion(1, 6))
-                opts->square|=SQUARE_TOOLTIPS;
-            if(opts->version<qtcMakeVersion(1, 6, 1))
-                opts->square|=SQUARE_POPUP_MENUS;
-            if(opts->version<qtcMakeVersion(1, 2))
-                def->crSize=CR_SMALL_SIZE;
-            if(opts!=def)
-            {
-                opts->customShades[0]=0;
-                opts->customAlphas[0]=0;
-                if(USE_CUSTOM_SHADES(*def))
-                    memcpy(opts->customShades, def->customShades, sizeof(double)*QTC_NUM_STD_SHADES);
-            }
-
-            CFG_READ_INT(gbFactor);
-            CFG_READ_INT(passwordChar);
-            CFG_READ_ROUND(round);
-            CFG_READ_INT(highlightFactor);
-            CFG_READ_INT(menuDelay);
-            CFG_READ_INT(menuCloseDelay);
-            CFG_READ_INT(sliderWidth);
-            CFG_READ_INT(tabBgnd);
-            CFG_READ_TB_BORDER(toolbarBorders);
-            CFG_READ_APPEARANCE(appearance, APP_ALLOW_BASIC);
-            if(opts->version<qtcMakeVersion(1, 8))
-            {
-                opts->tbarBtnAppearance=APPEARANCE_NONE;
-                opts->tbarBtnEffect=EFFECT_NONE;
-            }
-            else
-            {
-                CFG_READ_APPEARANCE(tbarBtnAppearance, APP_ALLOW_NONE);
-                CFG_READ_EFFECT(tbarBtnEffect);
-            }
-            CFG_READ_APPEARANCE_PIXMAP(bgndAppearance, APP_ALLOW_STRIPED,
-                                       &opts->bgndPixmap, checkImages);
-            CFG_READ_GRAD_TYPE(bgndGrad);
-            CFG_READ_GRAD_TYPE(menuBgndGrad);
-            CFG_READ_INT_BOOL(lighterPopupMenuBgnd, def->lighterPopupMenuBgnd);
-            CFG_READ_APPEARANCE_PIXMAP(menuBgndAppearance, APP_ALLOW_STRIPED,
-                                       &opts->menuBgndPixmap, checkImages);
-
-            if(APPEARANCE_FLAT==opts->menuBgndAppearance && 0==opts->lighterPopupMenuBgnd && opts->version<qtcMakeVersion(1, 7))
-                opts->menuBgndAppearance=APPEARANCE_RAISED;
-
-            CFG_READ_STRIPE(stripedProgress);
-            CFG_READ_SLIDER(sliderStyle);
-            CFG_READ_BOOL(animatedProgress);
-            CFG_READ_BOOL(embolden);
-            CFG_READ_DEF_BTN(defBtnIndicator);
-            CFG_READ_LINE(sliderThumbs);
-            CFG_READ_LINE(handles);
-            CFG_READ_BOOL(highlightTab);
-            CFG_READ_INT_BOOL(colorSelTab, DEF_COLOR_SEL_TAB_FACTOR);
-            CFG_READ_BOOL(roundAllTabs);
-            CFG_READ_TAB_MO(tabMouseOver);
-            CFG_READ_SHADE(shadeSliders, true, false, &opts->customSlidersColor);
-            CFG_READ_SHADE(shadeMenubars, true, false, &opts->customMenubarsColor);
-            CFG_READ_SHADE(shadeCheckRadio, false, false, &opts->customCheckRadioColor);
-            CFG_READ_SHADE(sortedLv, true, false, &opts->customSortedLvColor);
-            CFG_READ_SHADE(crColor,  true, false, &opts->customCrBgndColor);
-            CFG_READ_SHADE(progressColor, false, false, &opts->customProgressColor);
-            CFG_READ_APPEARANCE(menubarAppearance, APP_ALLOW_BASIC);
-            CFG_READ_APPEARANCE(menuitemAppearance, APP_ALLOW_FADE);
-            CFG_READ_APPEARANCE(toolbarAppearance, APP_ALLOW_BASIC);
-            CFG_READ_APPEARANCE(selectionAppearance, APP_ALLOW_BASIC);
-            CFG_READ_APPEARANCE(dwtAppearance, APP_ALLOW_BASIC);
-            CFG_READ_LINE(toolbarSeparators);
-            CFG_READ_LINE(splitters);
-            CFG_READ_BOOL(customMenuTextColor);
-            CFG_READ_MOUSE_OVER(coloredMouseOver);
-            CFG_READ_BOOL(menubarMouseOver);
-            CFG_READ_BOOL(useHighlightForMenu);
-            CFG_READ_BOOL(shadeMenubarOnlyWhenActive);
-            CFG_READ_TBAR_BTN(tbarBtns);
-            CFG_READ_COLOR(customMenuSelTextColor);
-            CFG_READ_COLOR(customMenuNormTextColor);
-            CFG_READ_SCROLLBAR(scrollbarType);
-            CFG_READ_EFFECT(buttonEffect);
-            CFG_READ_APPEARANCE(lvAppearance, APP_ALLOW_BASIC);
-            CFG_READ_APPEARANCE(tabAppearance, APP_ALLOW_BASIC);
-            CFG_READ_APPEARANCE(activeTabAppearance, APP_ALLOW_BASIC);
-            CFG_READ_APPEARANCE(sliderAppearance, APP_ALLOW_BASIC);
-            CFG_READ_APPEARANCE(progressAppearance, APP_ALLOW_BASIC);
-            CFG_READ_APPEARANCE(progressGrooveAppearance, APP_ALLOW_BASIC);
-            CFG_READ_APPEARANCE(grooveAppearance, APP_ALLOW_BASIC);
-            CFG_READ_APPEARANCE(sunkenAppearance, APP_ALLOW_BASIC);
-            CFG_READ_APPEARANCE(sbarBgndAppearance, APP_ALLOW_BASIC);
-            if (opts->version < qtcMakeVersion(1, 6)) {
-                opts->tooltipAppearance = APPEARANCE_FLAT;
-            } else {
-                CFG_READ_APPEARANCE(tooltipAppearance, APP_ALLOW_BASIC);
-            }
-
-            CFG_READ_APPEARANCE(sliderFill, APP_ALLOW_BASIC);
-            CFG_READ_ECOLOR(progressGrooveColor);
-            CFG_READ_FOCUS(focus);
-            CFG_READ_BOOL(lvButton);
-            CFG_READ_LV_LINES(lvLines);
-            CFG_READ_BOOL(drawStatusBarFrames);
-            CFG_READ_BOOL(fillSlider);
-            CFG_READ_BOOL(roundMbTopOnly);
-            CFG_READ_BOOL(borderMenuitems);
-            CFG_READ_BOOL(darkerBorders);
-            CFG_READ_BOOL(vArrows);
-            CFG_READ_BOOL(xCheck);
-            CFG_READ_BOOL(fadeLines);
-            CFG_READ_GLOW(glowProgress);
-            CFG_READ_BOOL(colorMenubarMouseOver);
-            CFG_READ_INT_BOOL(crHighlight, opts->highlightFactor);
-            CFG_READ_BOOL(crButton);
-            CFG_READ_BOOL(smallRadio);
-            CFG_READ_BOOL(fillProgress);
-            CFG_READ_BOOL(comboSplitter);
-            CFG_READ_BOOL(highlightScrollViews);
-            CFG_READ_BOOL(etchEntry);
-            CFG_READ_INT_BOOL(splitterHighlight, opts->highlightFactor);
-            CFG_READ_INT(crSize);
-            CFG_READ_BOOL(flatSbarButtons);
-            CFG_READ_BOOL(borderSbarGroove);
-            CFG_READ_BOOL(borderProgress);
-            CFG_READ_BOOL(popupBorder);
-            CFG_READ_BOOL(unifySpinBtns);
-            CFG_READ_BOOL(unifySpin);
-            CFG_READ_BOOL(unifyCombo);
-            CFG_READ_BOOL(borderTab);
-            CFG_READ_BOOL(borderInactiveTab);
-            CFG_READ_BOOL(thinSbarGroove);
-            CFG_READ_BOOL(colorSliderMouseOver);
-            CFG_READ_BOOL(menuIcons);
-            CFG_READ_BOOL(onlyTicksInMenu);
-            CFG_READ_BOOL(buttonStyleMenuSections);
-            CFG_READ_BOOL(forceAlternateLvCols);
-            CFG_READ_BOOL(invertBotTab);
-            CFG_READ_INT_BOOL(menubarHiding, HIDE_KEYBOARD);
-            CFG_READ_INT_BOOL(statusbarHiding, HIDE_KEYBOARD);
-            CFG_READ_BOOL(boldProgress);
-            CFG_READ_BOOL(coloredTbarMo);
-            CFG_READ_BOOL(borderSelection);
-            CFG_READ_BOOL(stripedSbar);
-            CFG_READ_INT_BOOL(windowDrag, WM_DRAG_MENUBAR);
-            CFG_READ_BOOL(shadePopupMenu);
-            CFG_READ_BOOL(hideShortcutUnderline);
-
-            CFG_READ_BOOL(stdBtnSizes);
-            CFG_READ_INT(titlebarButtons);
-            CFG_READ_TB_ICON(titlebarIcon);
-            CFG_READ_INT(dwtSettings);
-            CFG_READ_INT(bgndOpacity);
-            CFG_READ_INT(menuBgndOpacity);
-            CFG_READ_INT(dlgOpacity);
-            CFG_READ_INT(shadowSize);
-            qtcX11SetShadowSize(opts->shadowSize);
-            CFG_READ_SHADE(menuStripe, true, true, &opts->customMenuStripeColor);
-            CFG_READ_APPEARANCE(menuStripeAppearance, APP_ALLOW_BASIC);
-            CFG_READ_SHADE(comboBtn, true, false, &opts->customComboBtnColor);
-            CFG_READ_BOOL(gtkScrollViews);
-            CFG_READ_BOOL(doubleGtkComboArrow);
-            CFG_READ_BOOL(stdSidebarButtons);
-            CFG_READ_BOOL(toolbarTabs);
-            CFG_READ_BOOL(gtkComboMenus);
-            CFG_READ_ALIGN(titlebarAlignment);
-            CFG_READ_EFFECT(titlebarEffect);
-            CFG_READ_BOOL(centerTabText);
-// #if defined CONFIG_DIALOG
-            CFG_READ_INT(expanderHighlight);
-            CFG_READ_BOOL(mapKdeIcons);
-// #endif
-            CFG_READ_BOOL(gtkButtonOrder);
-// #if defined CONFIG_DIALOG
-            CFG_READ_BOOL(reorderGtkButtons);
-// #endif
-            CFG_READ_APPEARANCE(titlebarAppearance, APP_ALLOW_NONE);
-            CFG_READ_APPEARANCE(inactiveTitlebarAppearance, APP_ALLOW_NONE);
-
-            if(APPEARANCE_BEVELLED==opts->titlebarAppearance)
-                opts->titlebarAppearance=APPEARANCE_GRADIENT;
-            else if(APPEARANCE_RAISED==opts->titlebarAppearance)
-                opts->titlebarAppearance=APPEARANCE_FLAT;
-            if((opts->windowBorder&WINDOW_BORDER_BLEND_TITLEBAR) && !(opts->windowBorder&WINDOW_BORDER_COLOR_TITLEBAR_ONLY))
-                opts->windowBorder-=WINDOW_BORDER_BLEND_TITLEBAR;
-            if(APPEARANCE_BEVELLED==opts->inactiveTitlebarAppearance)
-                opts->inactiveTitlebarAppearance=APPEARANCE_GRADIENT;
-            else if(APPEARANCE_RAISED==opts->inactiveTitlebarAppearance)
-                opts->inactiveTitlebarAppearance=APPEARANCE_FLAT;
-            CFG_READ_APPEARANCE(titlebarButtonAppearance, APP_ALLOW_BASIC);
-            CFG_READ_SHADING(shading);
+            QtCurve::Config::readOptions<ConfigAdapter>(cfg, opts, def,
+                                                        checkImages);
             CFG_READ_IMAGE(bgndImage);
             CFG_READ_IMAGE(menuBgndImage);
             CFG_READ_STRING_LIST(noMenuStripeApps);
@@ -1386,8 +567,8 @@ bool qtcReadConfig(const QString &file, Options *opts, Options *defOpts, bool ch
             }
 
             for (i = APPEARANCE_CUSTOM1; i < (APPEARANCE_CUSTOM1 + NUM_CUSTOM_GRAD); ++i) {
-                QString gradKey;
-                QTextStream(&gradKey) << "customgradient" << i - APPEARANCE_CUSTOM1 + 1;
+                char gradKey[32];
+                sprintf(gradKey, "customgradient%d", i - APPEARANCE_CUSTOM1 + 1);
 
                 QStringList vals(readStringEntry(cfg, gradKey)
                                  .split(',', Qt::SkipEmptyParts));
@@ -1404,7 +585,7 @@ bool qtcReadConfig(const QString &file, Options *opts, Options *defOpts, bool ch
                     Gradient                   grad;
                     int                        j;
 
-                    grad.border=toGradientBorder(TO_LATIN1((*it)), &haveAlpha);
+                    grad.border=QtCurve::Config::loadGradientBorder(TO_LATIN1((*it)), &haveAlpha);
                     ok=vals.size()%(haveAlpha ? 3 : 2);
 
                     for(++it, j=0; it!=end && ok; ++it, ++j)
@@ -1457,158 +638,34 @@ static const char * getSystemConfigFile()
     return nullptr;
 }
 
+void qtcLoadBgndPixmaps(Options *opts)
+{
+    // Same fallback as qtcReadConfig() with defOpts unset.
+    Options def;
+    bool defRead = false;
+    auto load = [&] (EAppearance Options::*app, QtCPixmap Options::*pixmap) {
+        if (opts->*app == APPEARANCE_FILE &&
+            !(opts->*pixmap).img.load((opts->*pixmap).file)) {
+            if (!defRead) {
+                qtcDefaultSettings(&def);
+                defRead = true;
+            }
+            opts->*app = def.*app;
+        }
+    };
+    load(&Options::bgndAppearance, &Options::bgndPixmap);
+    load(&Options::menuBgndAppearance, &Options::menuBgndPixmap);
+}
+
 void qtcDefaultSettings(Options *opts)
 {
     /* Set hard-coded defaults... */
+    QtCurve::Config::defaultOptions<ConfigAdapter>(opts);
     // Setup titlebar gradients...
     qtcSetupGradient(&opts->customGradient[APPEARANCE_CUSTOM1], GB_3D, 3,
                      0.0, 1.2, 0.5, 1.0, 1.0, 1.0);
     qtcSetupGradient(&opts->customGradient[APPEARANCE_CUSTOM2], GB_3D, 3,
                      0.0, 0.9, 0.5, 1.0, 1.0, 1.0);
-    opts->customShades[0] = 1.16;
-    opts->customShades[1] = 1.07;
-    opts->customShades[2] = 0.9;
-    opts->customShades[3] = 0.78;
-    opts->customShades[4] = 0.84;
-    opts->customShades[5] = 0.75;
-    opts->customAlphas[0] = 0;
-    opts->contrast = 7;
-    opts->passwordChar = 0x25CF;
-    opts->gbFactor = DEF_GB_FACTOR;
-    opts->highlightFactor=DEFAULT_HIGHLIGHT_FACTOR;
-    opts->crHighlight=DEFAULT_CR_HIGHLIGHT_FACTOR;
-    opts->splitterHighlight=DEFAULT_SPLITTER_HIGHLIGHT_FACTOR;
-    opts->crSize=CR_LARGE_SIZE;
-    opts->menuDelay=DEFAULT_MENU_DELAY;
-    opts->menuCloseDelay=DEFAULT_MENU_CLOSE_DELAY;
-    opts->sliderWidth=DEFAULT_SLIDER_WIDTH;
-    opts->selectionAppearance=APPEARANCE_HARSH_GRADIENT;
-    opts->fadeLines=true;
-    opts->glowProgress=GLOW_NONE;
-    opts->round=ROUND_EXTRA;
-    opts->gtkButtonOrder=false;
-    opts->dwtAppearance=APPEARANCE_CUSTOM1;
-    opts->reorderGtkButtons=false;
-    opts->bgndImage.type=IMG_NONE;
-    opts->bgndImage.width=opts->bgndImage.height=0;
-    opts->bgndImage.onBorder=false;
-    opts->bgndImage.pos=PP_TR;
-    opts->menuBgndImage.type=IMG_NONE;
-    opts->menuBgndImage.width=opts->menuBgndImage.height=0;
-    opts->menuBgndImage.onBorder=false;
-    opts->menuBgndImage.pos=PP_TR;
-    opts->lighterPopupMenuBgnd=DEF_POPUPMENU_LIGHT_FACTOR;
-    opts->tabBgnd=DEF_TAB_BGND;
-    opts->animatedProgress=false;
-    opts->stripedProgress=STRIPE_NONE;
-    opts->sliderStyle=SLIDER_PLAIN;
-    opts->highlightTab=false;
-    opts->colorSelTab=0;
-    opts->roundAllTabs=true;
-    opts->tabMouseOver=TAB_MO_GLOW;
-    opts->embolden=false;
-    opts->bgndGrad=GT_HORIZ;
-    opts->menuBgndGrad=GT_HORIZ;
-    opts->appearance=APPEARANCE_SOFT_GRADIENT;
-    opts->tbarBtnAppearance=APPEARANCE_NONE;
-    opts->tbarBtnEffect=EFFECT_NONE;
-    opts->bgndAppearance=APPEARANCE_FLAT;
-    opts->menuBgndAppearance=APPEARANCE_FLAT;
-    opts->lvAppearance=APPEARANCE_BEVELLED;
-    opts->tabAppearance=APPEARANCE_SOFT_GRADIENT;
-    opts->activeTabAppearance=APPEARANCE_SOFT_GRADIENT;
-    opts->sliderAppearance=APPEARANCE_SOFT_GRADIENT;
-    opts->menubarAppearance=APPEARANCE_FLAT;
-    opts->menuitemAppearance=APPEARANCE_FADE;
-    opts->toolbarAppearance=APPEARANCE_FLAT;
-    opts->progressAppearance=APPEARANCE_DULL_GLASS;
-    opts->progressGrooveAppearance=APPEARANCE_INVERTED;
-    opts->progressGrooveColor=ECOLOR_DARK;
-    opts->grooveAppearance=APPEARANCE_INVERTED;
-    opts->sunkenAppearance=APPEARANCE_SOFT_GRADIENT;
-    opts->sbarBgndAppearance=APPEARANCE_FLAT;
-    opts->tooltipAppearance=APPEARANCE_GRADIENT;
-    opts->sliderFill=APPEARANCE_GRADIENT;
-    opts->defBtnIndicator=IND_GLOW;
-    opts->sliderThumbs=LINE_FLAT;
-    opts->handles=LINE_1DOT;
-    opts->shadeSliders=SHADE_NONE;
-    opts->shadeMenubars=SHADE_NONE;
-    opts->shadeCheckRadio=SHADE_NONE;
-    opts->sortedLv=SHADE_NONE;
-    opts->toolbarBorders=TB_NONE;
-    opts->toolbarSeparators=LINE_SUNKEN;
-    opts->splitters=LINE_1DOT;
-    opts->customMenuTextColor=false;
-    opts->coloredMouseOver=MO_GLOW;
-    opts->menubarMouseOver=true;
-    opts->useHighlightForMenu=false;
-    opts->shadeMenubarOnlyWhenActive=false;
-    opts->thin=THIN_BUTTONS;
-    opts->tbarBtns=TBTN_STANDARD;
-    opts->scrollbarType=SCROLLBAR_KDE;
-    opts->buttonEffect=EFFECT_SHADOW;
-    opts->focus=FOCUS_GLOW;
-    opts->lvButton=false;
-    opts->lvLines=false; /*LV_NONE;*/
-    opts->drawStatusBarFrames=false;
-    opts->fillSlider=true;
-    opts->roundMbTopOnly=true;
-    opts->borderMenuitems=false;
-    opts->darkerBorders=false;
-    opts->vArrows=true;
-    opts->xCheck=false;
-    opts->colorMenubarMouseOver=true;
-    opts->crButton=true;
-    opts->crColor=SHADE_NONE;
-    opts->progressColor=SHADE_SELECTED;
-    opts->smallRadio=true;
-    opts->fillProgress=true;
-    opts->comboSplitter=false;
-    opts->highlightScrollViews=false;
-    opts->etchEntry=false;
-    opts->flatSbarButtons=true;
-    opts->borderSbarGroove=true;
-    opts->borderProgress=true;
-    opts->popupBorder=true;
-    opts->unifySpinBtns=false;
-    opts->unifySpin=true;
-    opts->unifyCombo=true;
-    opts->borderTab=true;
-    opts->borderInactiveTab=false;
-    opts->thinSbarGroove=true;
-    opts->colorSliderMouseOver=false;
-    opts->menuIcons=true;
-    opts->forceAlternateLvCols=false;
-    opts->invertBotTab=true;
-    opts->menubarHiding=HIDE_NONE;
-    opts->statusbarHiding=HIDE_NONE;
-    opts->boldProgress=true;
-    opts->coloredTbarMo=false;
-    opts->borderSelection=false;
-    opts->square=SQUARE_POPUP_MENUS|SQUARE_TOOLTIPS;
-    opts->stripedSbar=false;
-    opts->windowDrag=WM_DRAG_NONE;
-    opts->shadePopupMenu=false;
-    opts->hideShortcutUnderline=false;
-    opts->windowBorder=WINDOW_BORDER_ADD_LIGHT_BORDER|WINDOW_BORDER_FILL_TITLEBAR;
-    opts->groupBox=FRAME_FADED;
-    opts->gbFactor=DEF_GB_FACTOR;
-    opts->gbLabel=GB_LBL_BOLD|GB_LBL_OUTSIDE;
-    opts->stdBtnSizes=false;
-    opts->titlebarButtons=TITLEBAR_BUTTON_ROUND|TITLEBAR_BUTTON_HOVER_SYMBOL;
-    opts->titlebarIcon=TITLEBAR_ICON_NEXT_TO_TITLE;
-    opts->menuStripe=SHADE_NONE;
-    opts->menuStripeAppearance=APPEARANCE_DARK_INVERTED;
-    opts->shading=Shading::HSL;
-    opts->gtkScrollViews=true;
-    opts->comboBtn=SHADE_NONE;
-    opts->doubleGtkComboArrow=true;
-    opts->stdSidebarButtons=false;
-    opts->toolbarTabs=false;
-    opts->bgndOpacity=opts->dlgOpacity=opts->menuBgndOpacity=100;
-    opts->shadowSize = qtcX11ShadowSize();
-    opts->gtkComboMenus=false;
     opts->customMenubarsColor.setRgb(0, 0, 0);
     opts->customSlidersColor.setRgb(0, 0, 0);
     opts->customMenuNormTextColor.setRgb(0, 0, 0);
@@ -1617,10 +674,6 @@ void qtcDefaultSettings(Options *opts)
     opts->customComboBtnColor.setRgb(0, 0, 0);
     opts->customMenuStripeColor.setRgb(0, 0, 0);
     opts->customProgressColor.setRgb(0, 0, 0);
-    opts->titlebarAlignment=ALIGN_FULL_CENTER;
-    opts->titlebarEffect=EFFECT_SHADOW;
-    opts->centerTabText=false;
-    opts->dwtSettings=DWT_BUTTONS_AS_PER_TITLEBAR|DWT_ROUND_TOP_ONLY;
     opts->menubarApps << "smplayer" << "VirtualBox";
     opts->statusbarApps << "kde";
     opts->noMenuBgndOpacityApps << "sonata" << "totem" << "vmware"
@@ -1629,19 +682,6 @@ void qtcDefaultSettings(Options *opts)
                             << "vmplayer";
     opts->noMenuStripeApps << "gtk" << "soffice.bin";
 
-    opts->mapKdeIcons=true;
-    opts->expanderHighlight=DEFAULT_EXPANDER_HIGHLIGHT_FACTOR;
-    opts->titlebarAppearance=APPEARANCE_CUSTOM1;
-    opts->inactiveTitlebarAppearance=APPEARANCE_CUSTOM1;
-    opts->titlebarButtonAppearance=APPEARANCE_GRADIENT;
-#ifdef Q_OS_MACOS
-    opts->onlyTicksInMenu=true;
-    opts->buttonStyleMenuSections=false;
-#else
-    opts->onlyTicksInMenu=false;
-    opts->buttonStyleMenuSections=true;
-#endif
-
     /* Read system config file... */
     {
     static const char * systemFilename=nullptr;
@@ -1654,6 +694,71 @@ void qtcDefaultSettings(Options *opts)
     }
 }
 
+QStringList qtcConfigFiles()
+{
+    QStringList files;
+    const char *env=getenv("QTCURVE_CONFIG_FILE");
+
+    if (nullptr != env) {
+        files << QFile::decodeName(env);
+    } else if (const char *cfgDir=QtCurve::getConfDir()) {
+        QString filename(QFile::decodeName(cfgDir) + CONFIG_FILE);
+
+        // Watch for the new file even while the old one is still in use.
+        files << filename;
+        if(!QFile::exists(filename))
+            files << QFile::decodeName(cfgDir) + "../" OLD_CONFIG_FILE;
+    }
+    if (const char *systemFilename=getSystemConfigFile())
+        files << QFile::decodeName(systemFilename);
+    return files;
+}
+
+static bool
+sameImage(const QtCImage &a, const QtCImage &b)
+{
+    return a.type==b.type && a.onBorder==b.onBorder && a.width==b.width &&
+        a.height==b.height && a.pos==b.pos && a.pixmap.file==b.pixmap.file;
+}
+
+#define CFG_DIFF(ENTRY, FLAGS)                  \
+    do {                                        \
+        if (!(from->ENTRY == to->ENTRY))        \
+            changes |= (FLAGS);                 \
+    } while (0)
+
+int qtcConfigChanges(const Options *from, const Options *to)
+{
+    // The options shared with Gtk, with the change flags from the table
+    int changes = QtCurve::Config::optionChanges(from, to);
+
+    CFG_DIFF(titlebarButtonColors, QTC_CFG_COLORS);
+    CFG_DIFF(customGradient, QTC_CFG_PIXMAPS);
+    CFG_DIFF(noBgndGradientApps, QTC_CFG_POLISH);
+    CFG_DIFF(noBgndImageApps, QTC_CFG_POLISH);
+    CFG_DIFF(useQtFileDialogApps, QTC_CFG_POLISH);
+    CFG_DIFF(nonnativeMenubarApps, QTC_CFG_POLISH);
+    CFG_DIFF(noBgndOpacityApps, QTC_CFG_OPACITY);
+    CFG_DIFF(noMenuBgndOpacityApps, QTC_CFG_OPACITY|QTC_CFG_MENUS);
+    CFG_DIFF(noMenuStripeApps, QTC_CFG_REPAINT);
+    CFG_DIFF(windowDragWhiteList, QTC_CFG_WINDOW_DRAG);
+    CFG_DIFF(windowDragBlackList, QTC_CFG_WINDOW_DRAG);
+    CFG_DIFF(menubarApps, QTC_CFG_BAR_HIDING|QTC_CFG_POLISH);
+    CFG_DIFF(statusbarApps, QTC_CFG_BAR_HIDING|QTC_CFG_POLISH);
+    CFG_DIFF(bgndPixmap.file, QTC_CFG_BGND_IMAGES);
+    CFG_DIFF(menuBgndPixmap.file, QTC_CFG_BGND_IMAGES);
+    if (!sameImage(from->bgndImage, to->bgndImage) ||
+        !sameImage(from->menuBgndImage, to->menuBgndImage)) {
+        // The ring images are drawn with alphas calculated in Style::init
+        changes |= QTC_CFG_BGND_IMAGES|QTC_CFG_COLORS;
+    }
+
+    // Whatever has changed needs to be painted again.
+    return changes ? changes|QTC_CFG_REPAINT : 0;
+}
+
+#undef CFG_DIFF
+
 #ifdef CONFIG_WRITE
 #include <KConfig>
 #include <KConfigGroup>
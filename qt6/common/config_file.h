@@ -24,6 +24,8 @@
 #define QTC_CONFIG_FILE_H
 
 #include "common.h"
+#include <qtcurve-utils/optionfields.h>
+#include <QStringList>
 
 #define QTC_MENU_FILE_PREFIX   "menubar-"
 #define QTC_STATUS_FILE_PREFIX "statusbar-"
@@ -41,6 +43,11 @@ void qtcDefaultSettings(Options *opts);
 void qtcCheckConfig(Options *opts);
 bool qtcReadConfig(const QString &file, Options *opts, Options *defOpts=nullptr,
                    bool checkImages=true);
+// Load the `file:` backgrounds of a config read without checkImages.
+void qtcLoadBgndPixmaps(Options *opts);
+QStringList qtcConfigFiles();
+
+int qtcConfigChanges(const Options *from, const Options *to);
 WindowBorders qtcGetWindowBorderSize(bool force);
 
 #ifdef CONFIG_WRITE
@@ -62,7 +62,7 @@
 #  include "private/qhighdpiscaling_p.h"
 #endif
 
-#include <qtcurve-utils/qtutils.h>
+#include <qtcurve-utils/qtprops.h>
 #include <qtcurve-utils/x11blur.h>
 
 namespace QtCurve {
@@ -83,6 +83,7 @@ BlurHelper::unregisterWidget(QWidget *widget)
 {
     widget->removeEventFilter(this);
     if (isTransparent(widget)) {
+        QtcQWidgetProps(widget)->blurRegionSent = false;
         clear(qtcGetWid(widget));
     }
 }
@@ -95,36 +96,42 @@ BlurHelper::eventFilter(QObject *object, QEvent *event)
         return false;
 
     switch (event->type()) {
-    case QEvent::Hide: {
-        QWidget *widget = qtcToWidget(object);
-        if (widget && isOpaque(widget)) {
-            QWidget *window(widget->window());
-            if (window && isTransparent(window) &&
-                !_pendingWidgets.contains(window)) {
-                _pendingWidgets.insert(window, window);
-                delayedUpdate();
-            }
-        }
-        break;
-    }
     case QEvent::Show:
-    case QEvent::Resize: {
+    case QEvent::Hide:
+    case QEvent::Resize:
+    case QEvent::Move: {
         // cast to widget and check
         QWidget *widget = qtcToWidget(object);
         if (!widget)
             break;
-        if (isTransparent(widget)) {
-            _pendingWidgets.insert(widget, widget);
-            delayedUpdate();
-        } else if (isOpaque(widget)) {
+        if (widget->isWindow()) {
+            if (oneOf(event->type(), QEvent::Hide, QEvent::Move) ||
+                !isTransparent(widget))
+                break;
+            if (event->type() == QEvent::Show) {
+                // The native window may be new, start from scratch.
+                invalidateAll(widget);
+            }
+            scheduleUpdate(widget);
+        } else if (isOpaque(widget) || event->type() == QEvent::Move) {
+            // A moved widget keeps its own opaque region but changes the
+            // one of its parents.
             QWidget *window(widget->window());
-            if (isTransparent(window)) {
-                _pendingWidgets.insert(window, window);
-                delayedUpdate();
+            if (window && isTransparent(window)) {
+                invalidate(widget);
+                scheduleUpdate(window);
             }
         }
         break;
     }
+    case QEvent::WinIdChange: {
+        QWidget *widget = qtcToWidget(object);
+        if (widget && widget->isWindow() && isTransparent(widget)) {
+            QtcQWidgetProps(widget)->blurRegionSent = false;
+            scheduleUpdate(widget);
+        }
+        break;
+    }
     default:
         break;
     }
@@ -140,36 +147,60 @@ BlurHelper::blurRegion(QWidget *widget) const
     // get main region
     QRegion region = widget->mask().isEmpty() ? widget->rect() : widget->mask();
 
-    // trim blur region to remove unnecessary areas
-    trimBlurRegion(widget, widget, region);
+    // remove areas covered by opaque children
+    return region - opaqueRegion(widget);
+}
+
+QRegion
+BlurHelper::opaqueRegion(QWidget *widget) const
+{
+    QtcQWidgetProps props(widget);
+    if (props->blurOpaqueValid) {
+        return props->blurOpaqueRegion;
+    }
+    QRegion region;
+    if (isOpaque(widget)) {
+        region = widget->mask().isEmpty() ? widget->rect() : widget->mask();
+    } else {
+        // TODO:
+        //     Maybe we should clip children with parent? In case we hit this[1] kind
+        //     of bugs again.
+        //     [1] https://bugs.kde.org/show_bug.cgi?id=306631
+        // loop over children, only the ones that changed are recomputed
+        for (QObject *childObject: widget->children()) {
+            QWidget *child = qtcToWidget(childObject);
+            if (!(child && !child->isWindow() && child->isVisible()))
+                continue;
+            region += opaqueRegion(child).translated(child->pos());
+        }
+    }
+    props->blurOpaqueRegion = region;
+    props->blurOpaqueValid = true;
     return region;
 }
 
 void
-BlurHelper::trimBlurRegion(QWidget *parent, QWidget *widget,
-                           QRegion &region) const
+BlurHelper::invalidate(QWidget *widget) const
 {
-    // TODO:
-    //     Maybe we should clip children with parent? In case we hit this[1] kind
-    //     of bugs again.
-    //     [1] https://bugs.kde.org/show_bug.cgi?id=306631
-    // loop over children
-    for (QObject *childObject: widget->children()) {
-        QWidget *child = qtcToWidget(childObject);
-        if (!(child && child->isVisible()))
-            continue;
-        if (isOpaque(child)) {
-            const QPoint offset(child->mapTo(parent, QPoint(0, 0)));
-            if (child->mask().isEmpty()) {
-                region -= child->rect().translated(offset);
-            } else {
-                region -= child->mask().translated(offset);
-            }
-        } else {
-            trimBlurRegion(parent, child, region);
+    for (QWidget *w = widget;w;w = w->parentWidget()) {
+        QtcQWidgetProps(w)->blurOpaqueValid = false;
+        if (w->isWindow()) {
+            break;
+        }
+    }
+}
+
+void
+BlurHelper::invalidateAll(QWidget *window) const
+{
+    QtcQWidgetProps props(window);
+    props->blurOpaqueValid = false;
+    props->blurRegionSent = false;
+    for (QWidget *child: window->findChildren<QWidget*>()) {
+        if (!child->isWindow()) {
+            QtcQWidgetProps(child)->blurOpaqueValid = false;
         }
     }
-    return;
 }
 
 void
@@ -185,6 +216,14 @@ BlurHelper::update(QWidget *widget) const
         return;
     }
     const QRegion region(blurRegion(widget));
+    QtcQWidgetProps props(widget);
+    if (props->blurRegionSent && props->blurRegion == region) {
+        // Nothing changed, save the round trip to the X server and the
+        // repaint.
+        return;
+    }
+    props->blurRegion = region;
+    props->blurRegionSent = true;
     if (region.isEmpty()) {
         clear(wid);
     } else {
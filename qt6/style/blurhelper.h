@@ -109,15 +109,30 @@ protected:
     //! get list of blur-behind regions matching a given widget
     QRegion blurRegion(QWidget*) const;
 
-    //! trim blur region to remove unnecessary areas (recursive)
-    void trimBlurRegion(QWidget*, QWidget*, QRegion&) const;
+    //! opaque area covered by a widget and its children, in widget
+    //! coordinates (cached)
+    QRegion opaqueRegion(QWidget*) const;
+
+    //! drop cached opaque region of a widget and all its ancestors
+    void invalidate(QWidget*) const;
+
+    //! drop cached opaque regions of a whole window
+    void invalidateAll(QWidget*) const;
+
+    //! schedule blur region update for a window
+    void scheduleUpdate(QWidget *window)
+    {
+        _pendingWidgets.insert(window, window);
+        delayedUpdate();
+    }
 
     //! update blur region for all pending widgets
-    /*! a timer is used to allow some buffering of the update requests */
+    /*! a zero timer is used to compress all requests of one event loop
+      iteration */
     void delayedUpdate()
     {
         if(!_timer.isActive()) {
-            _timer.start(10, this);
+            _timer.start(0, this);
         }
     }
 
@@ -21,12 +21,15 @@
  *****************************************************************************/
 
 #include <qtcurve-utils/qtprops.h>
+#include <qtcurve-utils/trace.h>
+#include <qtcurve-utils/stats.h>
 
 #include "qtcurve_p.h"
 #include "qtcurve_fonthelper.h"
 #include "argbhelper.h"
 #include "utils.h"
 #include "shortcuthandler.h"
+#include "kdesettings.h"
 #include "windowmanager.h"
 #include "blurhelper.h"
 #include <common/config_file.h>
@@ -94,6 +97,23 @@ horizontalAdvance(const QFontMetrics &fm, T &&text)
 
 static const char *constBoldProperty = "qtc-set-bold";
 
+// Whether the text drawn for \param option can contain a mnemonic. Options
+// that do not carry their text (e.g. QLabel's) are assumed to have one.
+static inline bool
+mayHaveMnemonic(const QStyleOption *option)
+{
+    if (auto button = styleOptCast<QStyleOptionButton>(option)) {
+        return button->text.contains(QLatin1Char('&'));
+    } else if (auto menuItem = styleOptCast<QStyleOptionMenuItem>(option)) {
+        return menuItem->text.contains(QLatin1Char('&'));
+    } else if (auto tab = styleOptCast<QStyleOptionTab>(option)) {
+        return tab->text.contains(QLatin1Char('&'));
+    } else if (auto groupBox = styleOptCast<QStyleOptionGroupBox>(option)) {
+        return groupBox->text.contains(QLatin1Char('&'));
+    }
+    return true;
+}
+
 Style::FontHelper::FontHelper()
     : m_fntDB(new QFontDatabase())
 {}
@@ -164,6 +184,7 @@ void Style::FontHelper::unSetBold(QWidget *widget)
 void
 Style::polish(QApplication *app)
 {
+    QTC_TRACE_SCOPE("Style::polish(QApplication*)");
     // appName = getFile(app->arguments()[0]);
 
     if (appName == "kwin" || appName == "kwin_x11" || appName == "kwin_wayland") {
@@ -189,13 +210,33 @@ Style::polish(QApplication *app)
         theThemedApp = APP_KDEVELOP;
     } else if("soffice.bin" == appName) {
         theThemedApp = APP_OPENOFFICE;
-    } else if("kdmgreet" == appName) {
-        opts.forceAlternateLvCols = false;
     }
 
     qtcInfo("QtCurve: Application name: \"%s\"\n",
             appName.toLatin1().constData());
 
+    adjustOptsForApp(opts);
+
+    if (APP_OPENOFFICE == theThemedApp && opts.useHighlightForMenu &&
+        blendOOMenuHighlight(QApplication::palette(),
+                             m_highlightCols[ORIGINAL_SHADE])) {
+        m_ooMenuCols=new QColor [TOTAL_SHADES+1];
+        shadeColors(tint(popupMenuCols()[ORIGINAL_SHADE], m_highlightCols[ORIGINAL_SHADE], 0.5), m_ooMenuCols);
+    }
+
+    ParentStyleClass::polish(app);
+    if (opts.hideShortcutUnderline) {
+        app->installEventFilter(m_shortcutHandler);
+    }
+}
+
+// Per application tweaks, also applied to the options read when the config
+// file changes.
+void
+Style::adjustOptsForApp(Options &opts)
+{
+    if ("kdmgreet" == appName)
+        opts.forceAlternateLvCols = false;
     if (theThemedApp == APP_REKONQ)
         opts.statusbarHiding=0;
     if(opts.menubarHiding)
@@ -223,33 +264,20 @@ Style::polish(QApplication *app)
         if(APPEARANCE_FADE == opts.menuitemAppearance)
             opts.menuitemAppearance = APPEARANCE_FLAT;
         opts.borderMenuitems=opts.etchEntry=false;
-
-        if(opts.useHighlightForMenu && blendOOMenuHighlight(QApplication::palette(), m_highlightCols[ORIGINAL_SHADE]))
-        {
-            m_ooMenuCols=new QColor [TOTAL_SHADES+1];
-            shadeColors(tint(popupMenuCols()[ORIGINAL_SHADE], m_highlightCols[ORIGINAL_SHADE], 0.5), m_ooMenuCols);
-        }
         opts.menubarHiding=opts.statusbarHiding=HIDE_NONE;
         opts.square|=SQUARE_POPUP_MENUS|SQUARE_TOOLTIPS;
         if(!qtcIsFlatBgnd(opts.menuBgndAppearance) && 0 == opts.lighterPopupMenuBgnd)
             opts.lighterPopupMenuBgnd=1; // shade so that we dont have 3d-ish borders...
         opts.menuBgndAppearance = APPEARANCE_FLAT;
     }
-
-    ParentStyleClass::polish(app);
-    if (opts.hideShortcutUnderline) {
-        app->installEventFilter(m_shortcutHandler);
-    }
 }
 
 void Style::polish(QPalette &palette)
 {
-    int  contrast(QSettings(QLatin1String("Trolltech")).value("/Qt/KDE/contrast", DEFAULT_CONTRAST).toInt());
+    QTC_TRACE_SCOPE("Style::polish(QPalette&)");
+    int  contrast(KdeSettings::instance()->contrast());
     bool newContrast(false);
 
-    if(contrast<0 || contrast>10)
-        contrast=DEFAULT_CONTRAST;
-
     if (contrast != opts.contrast) {
         opts.contrast = contrast;
         newContrast = true;
@@ -440,12 +468,14 @@ void Style::polish(QPalette &palette)
 
 void Style::polish(QWidget *widget)
 {
+    QTC_TRACE_SCOPE("Style::polish(QWidget*)");
     // TODO:
     //      Reorganize this polish function
     if (!widget)
         return;
 
     prePolish(widget);
+    const unsigned classes = classFlags(widget);
     QtcQWidgetProps qtcProps(widget);
     bool enableMouseOver(opts.highlightFactor || opts.coloredMouseOver);
 
@@ -465,7 +495,7 @@ void Style::polish(QWidget *widget)
     if ((opts.menuBgndOpacity != 100 &&
          (qobject_cast<QMenu*>(widget) ||
           // TODO temporary solution only
-          widget->inherits("QComboBoxPrivateContainer"))) ||
+          classes & CLASS_COMBO_CONTAINER)) ||
         (opts.bgndOpacity != 100 && (!widget->window() || !isDialog)) ||
         (opts.dlgOpacity != 100 && (!widget->window() || isDialog))) {
         m_blurHelper->registerWidget(widget);
@@ -548,9 +578,9 @@ void Style::polish(QWidget *widget)
         if(opts.forceAlternateLvCols &&
            viewport->autoFillBackground() && // Dolphins Folders panel
            //255==viewport->palette().color(itemView->viewport()->backgroundRole()).alpha() && // KFilePlacesView
-           !widget->inherits("KFilePlacesView") &&
+           !(classes & CLASS_FILE_PLACES_VIEW) &&
            // Exclude non-editable combo popup...
-           !(opts.gtkComboMenus && widget->inherits("QComboBoxListView") &&
+           !(opts.gtkComboMenus && classes & CLASS_COMBO_LIST_VIEW &&
              qtcCheckType<QComboBox>(getParent<2>(widget)) &&
              !static_cast<QComboBox*>(getParent<2>(widget))->isEditable()) &&
            // Exclude KAboutDialog...
@@ -581,9 +611,8 @@ void Style::polish(QWidget *widget)
         qobject_cast<QLineEdit*>(widget) ||
         qobject_cast<QDial*>(widget) ||
         // qobject_cast<QDockWidget*>(widget) ||
-        widget->inherits("QWorkspaceTitleBar") ||
-        widget->inherits("QDockSeparator") ||
-        widget->inherits("QDockWidgetSeparator")))
+        classes & CLASS_WORKSPACE_TITLE_BAR ||
+        classes & CLASS_DOCK_SEPARATOR))
         widget->setAttribute(Qt::WA_Hover, true);
 
     if (qobject_cast<QSplitterHandle*>(widget)) {
@@ -595,8 +624,8 @@ void Style::polish(QWidget *widget)
         if (!opts.gtkScrollViews) {
             widget->installEventFilter(this);
         }
-    } else if (qobject_cast<QAbstractScrollArea*>(widget) &&
-               widget->inherits("KFilePlacesView")) {
+    } else if (classes & CLASS_SCROLL_AREA &&
+               classes & CLASS_FILE_PLACES_VIEW) {
         if (qtcIsCustomBgnd(opts))
             polishScrollArea(static_cast<QAbstractScrollArea*>(widget), true);
         widget->installEventFilter(this);
@@ -660,13 +689,13 @@ void Style::polish(QWidget *widget)
             }
         }
     } else if (qobject_cast<QDialog*>(widget) &&
-               widget->inherits("QPrintPropertiesDialog") &&
+               classes & CLASS_PRINT_PROPERTIES_DIALOG &&
                widget->parentWidget() && widget->parentWidget()->window() &&
                widget->window() && widget->window()->windowTitle().isEmpty() &&
                !widget->parentWidget()->window()->windowTitle().isEmpty()) {
         widget->window()->setWindowTitle(widget->parentWidget()->window()
                                          ->windowTitle());
-    } else if (widget->inherits("QWhatsThat")) {
+    } else if (classes & CLASS_WHATS_THAT) {
         QPalette pal(widget->palette());
         QColor   shadow(pal.shadow().color());
 
@@ -679,7 +708,7 @@ void Style::polish(QWidget *widget)
                qtcCheckType(getParent<2>(widget), "KFileWidget"))
         ((QDockWidget*)widget)->setTitleBarWidget(new QtCurveDockWidgetTitleBar(widget));
 
-    if (widget->inherits("QTipLabel") && !qtcIsFlat(opts.tooltipAppearance)) {
+    if (classes & CLASS_TIP_LABEL && !qtcIsFlat(opts.tooltipAppearance)) {
         widget->setBackgroundRole(QPalette::NoRole);
         // TODO: turn this into addAlphaChannel
         widget->setAttribute(Qt::WA_TranslucentBackground);
@@ -748,7 +777,7 @@ void Style::polish(QWidget *widget)
     if ((!qtcIsFlatBgnd(opts.menuBgndAppearance) ||
          opts.menuBgndOpacity != 100 ||
          !(opts.square & SQUARE_POPUP_MENUS)) &&
-        widget->inherits("QComboBoxPrivateContainer")) {
+        classes & CLASS_COMBO_CONTAINER) {
         widget->installEventFilter(this);
         widget->setAttribute(Qt::WA_NoSystemBackground);
         addAlphaChannel(widget);
@@ -826,15 +855,15 @@ void Style::polish(QWidget *widget)
     }
 
     if ((theThemedApp == APP_K3B &&
-         widget->inherits("K3b::ThemedHeader") &&
-         qobject_cast<QFrame*>(widget)) ||
-        widget->inherits("KColorPatch")) {
+         classes & CLASS_K3B_THEMED_HEADER &&
+         classes & CLASS_FRAME) ||
+        classes & CLASS_KCOLOR_PATCH) {
         ((QFrame*)widget)->setLineWidth(0);
         ((QFrame*)widget)->setFrameShape(QFrame::NoFrame);
     }
 
     if (theThemedApp == APP_KDEVELOP && !opts.stdSidebarButtons &&
-        widget->inherits("Sublime::IdealButtonBarWidget") && widget->layout()) {
+        classes & CLASS_IDEAL_BUTTON_BAR && widget->layout()) {
         widget->layout()->setSpacing(0);
         widget->layout()->setContentsMargins(0, 0, 0, 0);;
     }
@@ -844,7 +873,7 @@ void Style::polish(QWidget *widget)
     if ((100 != opts.bgndOpacity && qtcIsWindow(window)) ||
         (100 != opts.dlgOpacity && qtcIsDialog(window))) {
         widget->installEventFilter(this);
-        if (widget->inherits("KFilePlacesView")) {
+        if (classes & CLASS_FILE_PLACES_VIEW) {
             widget->setAutoFillBackground(false);
             widget->setAttribute(Qt::WA_OpaquePaintEvent, false);
         }
@@ -867,6 +896,7 @@ Style::unpolish(QApplication *app)
 {
     if (opts.hideShortcutUnderline)
         app->removeEventFilter(m_shortcutHandler);
+    clearClassFlags();
     ParentStyleClass::unpolish(app);
 }
 
@@ -874,6 +904,7 @@ void Style::unpolish(QWidget *widget)
 {
     if (!widget)
         return;
+    const unsigned classes = classFlags(widget);
     widget->removeEventFilter(this);
     m_windowManager->unregisterWidget(widget);
     m_shadowHelper->unregisterWidget(widget);
@@ -937,9 +968,8 @@ void Style::unpolish(QWidget *widget)
        qobject_cast<QLineEdit*>(widget) ||
        qobject_cast<QDial*>(widget) ||
        // qobject_cast<QDockWidget *>(widget) ||
-       widget->inherits("QWorkspaceTitleBar") ||
-       widget->inherits("QDockSeparator") ||
-       widget->inherits("QDockWidgetSeparator"))
+       classes & CLASS_WORKSPACE_TITLE_BAR ||
+       classes & CLASS_DOCK_SEPARATOR)
         widget->setAttribute(Qt::WA_Hover, false);
     if (qobject_cast<QScrollBar*>(widget)) {
         widget->setAttribute(Qt::WA_Hover, false);
@@ -987,7 +1017,7 @@ void Style::unpolish(QWidget *widget)
         m_fntHelper->unSetBold(widget);
     }
 
-    if (widget->inherits("QTipLabel") && !qtcIsFlat(opts.tooltipAppearance)) {
+    if (classes & CLASS_TIP_LABEL && !qtcIsFlat(opts.tooltipAppearance)) {
         widget->setAttribute(Qt::WA_NoSystemBackground, false);
         widget->clearMask();
     }
@@ -1026,7 +1056,7 @@ void Style::unpolish(QWidget *widget)
     }
 
     if((!qtcIsFlatBgnd(opts.menuBgndAppearance) || 100!=opts.menuBgndOpacity || !(opts.square&SQUARE_POPUP_MENUS)) &&
-       widget->inherits("QComboBoxPrivateContainer")) {
+       classes & CLASS_COMBO_CONTAINER) {
         widget->setAttribute(Qt::WA_NoSystemBackground, false);
         widget->clearMask();
     }
@@ -1038,18 +1068,41 @@ void Style::unpolish(QWidget *widget)
     }
 }
 
+static inline bool
+isMouseEvent(QEvent::Type type)
+{
+    switch (type) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::MouseMove:
+    case QEvent::NonClientAreaMouseButtonPress:
+    case QEvent::NonClientAreaMouseButtonRelease:
+    case QEvent::NonClientAreaMouseButtonDblClick:
+    case QEvent::NonClientAreaMouseMove:
+        return true;
+    default:
+        return false;
+    }
+}
+
 bool Style::eventFilter(QObject *object, QEvent *event)
 {
-    if (qobject_cast<QMenuBar*>(object) &&
-        dynamic_cast<QMouseEvent*>(event)) {
+    const QEvent::Type type = event->type();
+    // just for performance - they can occur really often
+    if (type == QEvent::Timer || type == QEvent::Move) {
+        return false;
+    }
+    const unsigned classes = (object->isWidgetType() ?
+                              classFlags(object) : 0);
+
+    if (classes & CLASS_MENU_BAR && isMouseEvent(type)) {
         if (updateMenuBarEvent((QMouseEvent*)event, (QMenuBar*)object)) {
             return true;
         }
     }
 
-    if (event->type() == QEvent::Show &&
-        qobject_cast<QAbstractScrollArea*>(object) &&
-        object->inherits("KFilePlacesView")) {
+    if (type == QEvent::Show && classes & CLASS_FILE_PLACES_VIEW) {
         QWidget *view = ((QAbstractScrollArea*)object)->viewport();
         QPalette palette = view->palette();
         QColor color = ((QWidget*)object)->palette().window().color();
@@ -1062,12 +1115,16 @@ bool Style::eventFilter(QObject *object, QEvent *event)
         object->removeEventFilter(this);
     }
 
-    bool isSViewCont = (APP_KONTACT == theThemedApp &&
+    const bool scrollEvent = (type == QEvent::MouseMove ||
+                              type == QEvent::MouseButtonPress ||
+                              type == QEvent::MouseButtonRelease ||
+                              type == QEvent::Wheel);
+    bool isSViewCont = (scrollEvent && APP_KONTACT == theThemedApp &&
                         m_sViewContainers.contains((QWidget*)object));
-    if ((!opts.gtkScrollViews &&
-         qobject_cast<QAbstractScrollArea*>(object)) || isSViewCont) {
+    if (scrollEvent && ((!opts.gtkScrollViews && classes & CLASS_SCROLL_AREA) ||
+                        isSViewCont)) {
         QPoint pos;
-        switch (event->type()) {
+        switch (type) {
         case QEvent::MouseMove:
         case QEvent::MouseButtonPress:
         case QEvent::MouseButtonRelease:
@@ -1146,26 +1203,18 @@ bool Style::eventFilter(QObject *object, QEvent *event)
         }
     }
 
-    switch((int)(event->type())) {
-    case QEvent::Timer:
-    case QEvent::Move:
-        return false; // just for performance - they can occur really often
+    switch((int)type) {
     case QEvent::Resize:
         if(!(opts.square & SQUARE_POPUP_MENUS) &&
-           object->inherits("QComboBoxPrivateContainer")) {
-            QWidget *widget = static_cast<QWidget*>(object);
-            if (Utils::hasAlphaChannel(widget)) {
-                widget->clearMask();
-            } else {
-                widget->setMask(windowMask(widget->rect(),
-                                           opts.round > ROUND_SLIGHT));
-            }
+           classes & CLASS_COMBO_CONTAINER) {
+            setWindowMask(static_cast<QWidget*>(object),
+                          opts.round > ROUND_SLIGHT);
             return false;
         } else if ((BLEND_TITLEBAR ||
                  opts.windowBorder &
                  WINDOW_BORDER_USE_MENUBAR_COLOR_FOR_TITLEBAR ||
                  opts.menubarHiding & HIDE_KWIN) &&
-                qobject_cast<QMenuBar*>(object)) {
+                classes & CLASS_MENU_BAR) {
             QResizeEvent *re = static_cast<QResizeEvent*>(event);
 
             if (re->size().height() != re->oldSize().height()) {
@@ -1178,7 +1227,7 @@ bool Style::eventFilter(QObject *object, QEvent *event)
         break;
     case QEvent::ShortcutOverride:
         if ((opts.menubarHiding || opts.statusbarHiding) &&
-            qobject_cast<QMainWindow*>(object)) {
+            classes & CLASS_MAIN_WINDOW) {
             QMainWindow *window = static_cast<QMainWindow*>(object);
 
             if (window->isVisible()) {
@@ -1202,7 +1251,7 @@ bool Style::eventFilter(QObject *object, QEvent *event)
         }
         break;
     case QEvent::ShowToParent:
-        if (qobject_cast<QMenuBar *>(object)) {
+        if (classes & CLASS_MENU_BAR) {
             if(opts.menubarHiding && m_saveMenuBarStatus && qtcMenuBarHidden(appName))
                 static_cast<QMenuBar *>(object)->setHidden(true);
 #ifdef Q_OS_MACOS
@@ -1225,7 +1274,7 @@ bool Style::eventFilter(QObject *object, QEvent *event)
                 }
 #endif
         }
-        if(opts.statusbarHiding && m_saveStatusBarStatus && qobject_cast<QStatusBar *>(object) &&
+        if(opts.statusbarHiding && m_saveStatusBarStatus && classes & CLASS_STATUS_BAR &&
            qtcStatusBarHidden(appName))
             static_cast<QStatusBar *>(object)->setHidden(true);
         break;
@@ -1244,7 +1293,7 @@ bool Style::eventFilter(QObject *object, QEvent *event)
              opts.menuBgndImage.type != IMG_NONE ||
              opts.menuBgndOpacity != 100 ||
              !(opts.square & SQUARE_POPUP_MENUS)) &&
-            object->inherits("QComboBoxPrivateContainer")) {
+            classes & CLASS_COMBO_CONTAINER) {
             QWidget *widget = qtcToWidget(object);
             QPainter p(widget);
             QRect r(widget->rect());
@@ -1318,8 +1367,7 @@ bool Style::eventFilter(QObject *object, QEvent *event)
                     }
                 }
             }
-        } else if (m_clickedLabel == object &&
-                   qobject_cast<QLabel*>(object) &&
+        } else if (m_clickedLabel == object && classes & CLASS_LABEL &&
                    ((QLabel*)object)->buddy() &&
                    ((QLabel*)object)->buddy()->isEnabled()) {
             // paint focus rect
@@ -1330,30 +1378,27 @@ bool Style::eventFilter(QObject *object, QEvent *event)
             opts.palette = lbl->palette();
             opts.rect    = QRect(0, 0, lbl->width(), lbl->height());
             drawPrimitive(PE_FrameFocusRect, &opts, &painter, lbl);
-        } else {
-            QFrame *frame = qobject_cast<QFrame*>(object);
+        } else if (classes & CLASS_FRAME) {
+            QFrame *frame = static_cast<QFrame*>(object);
 
-            if (frame)
+            if(QFrame::HLine==frame->frameShape() || QFrame::VLine==frame->frameShape())
             {
-                if(QFrame::HLine==frame->frameShape() || QFrame::VLine==frame->frameShape())
-                {
-                    QPainter painter(frame);
-                    QRect    r(QFrame::HLine==frame->frameShape()
-                               ? QRect(frame->rect().x(), frame->rect().y()+ (frame->rect().height()/2), frame->rect().width(), 1)
-                               : QRect(frame->rect().x()+(frame->rect().width()/2),  frame->rect().y(), 1, frame->rect().height()));
+                QPainter painter(frame);
+                QRect    r(QFrame::HLine==frame->frameShape()
+                           ? QRect(frame->rect().x(), frame->rect().y()+ (frame->rect().height()/2), frame->rect().width(), 1)
+                           : QRect(frame->rect().x()+(frame->rect().width()/2),  frame->rect().y(), 1, frame->rect().height()));
 
-                    drawFadedLine(&painter, r, backgroundColors(frame->palette().window().color())[QTC_STD_BORDER], true, true,
-                                  QFrame::HLine==frame->frameShape());
-                    return true;
-                }
-                else
-                    return false;
+                drawFadedLine(&painter, r, backgroundColors(frame->palette().window().color())[QTC_STD_BORDER], true, true,
+                              QFrame::HLine==frame->frameShape());
+                return true;
             }
+            else
+                return false;
         }
         break;
     }
     case QEvent::MouseButtonPress:
-        if(dynamic_cast<QMouseEvent*>(event) && qobject_cast<QLabel*>(object) && ((QLabel *)object)->buddy())
+        if(classes & CLASS_LABEL && ((QLabel *)object)->buddy())
         {
             QLabel      *lbl = (QLabel *)object;
             QMouseEvent *mev = (QMouseEvent *)event;
@@ -1366,7 +1411,7 @@ bool Style::eventFilter(QObject *object, QEvent *event)
         }
         break;
     case QEvent::MouseButtonRelease:
-        if(dynamic_cast<QMouseEvent*>(event) && qobject_cast<QLabel*>(object) && ((QLabel *)object)->buddy())
+        if(classes & CLASS_LABEL && ((QLabel *)object)->buddy())
         {
             QLabel      *lbl = (QLabel *)object;
             QMouseEvent *mev = (QMouseEvent *)event;
@@ -1385,10 +1430,9 @@ bool Style::eventFilter(QObject *object, QEvent *event)
     case QEvent::StyleChange:
     case QEvent::Show:
     {
-        QProgressBar *bar = qobject_cast<QProgressBar *>(object);
+        if (classes & CLASS_PROGRESS_BAR) {
+            QProgressBar *bar = static_cast<QProgressBar*>(object);
 
-        if(bar)
-        {
             m_progressBars.insert(bar);
             if (!m_progressBarAnimateTimer) {
                 if (opts.animatedProgress || (0 == bar->minimum() && 0 == bar->maximum())) {
@@ -1400,25 +1444,20 @@ bool Style::eventFilter(QObject *object, QEvent *event)
                 }
             }
         } else if (!(opts.square & SQUARE_POPUP_MENUS) &&
-                   object->inherits("QComboBoxPrivateContainer")) {
-            QWidget *widget = static_cast<QWidget*>(object);
-            if (Utils::hasAlphaChannel(widget)) {
-                widget->clearMask();
-            } else {
-                widget->setMask(windowMask(widget->rect(),
-                                           opts.round > ROUND_SLIGHT));
-            }
+                   classes & CLASS_COMBO_CONTAINER) {
+            setWindowMask(static_cast<QWidget*>(object),
+                          opts.round > ROUND_SLIGHT);
             return false;
         } else if ((BLEND_TITLEBAR ||
                   opts.windowBorder &
                   WINDOW_BORDER_USE_MENUBAR_COLOR_FOR_TITLEBAR ||
                   opts.menubarHiding & HIDE_KWIN) &&
-                 qobject_cast<QMenuBar*>(object)) {
+                 classes & CLASS_MENU_BAR) {
             QMenuBar *mb=(QMenuBar*)object;
             emitMenuSize((QMenuBar*)mb, PREVIEW_MDI==m_isPreview ||
                          !((QMenuBar *)mb)->isVisible() ? 0 :
                          mb->size().height(), true);
-        } else if (QEvent::Show==event->type()) {
+        } else if (QEvent::Show==type) {
             QWidget *widget = qtcToWidget(object);
 
             if(widget && widget->isWindow() &&
@@ -1439,7 +1478,7 @@ bool Style::eventFilter(QObject *object, QEvent *event)
              opts.windowBorder &
              WINDOW_BORDER_USE_MENUBAR_COLOR_FOR_TITLEBAR ||
              opts.menubarHiding & HIDE_KWIN) &&
-           qobject_cast<QMenuBar*>(object)) {
+           classes & CLASS_MENU_BAR) {
             QMenuBar *mb = (QMenuBar*)object;
             emitMenuSize((QMenuBar*)mb, 0);
         }
@@ -1477,7 +1516,7 @@ bool Style::eventFilter(QObject *object, QEvent *event)
     case QEvent::FocusOut:
         break;
     case QEvent::WindowActivate:
-        if(opts.shadeMenubarOnlyWhenActive && SHADE_NONE!=opts.shadeMenubars && qobject_cast<QMenuBar *>(object))
+        if(opts.shadeMenubarOnlyWhenActive && SHADE_NONE!=opts.shadeMenubars && classes & CLASS_MENU_BAR)
         {
             m_active=true;
             ((QWidget *)object)->repaint();
@@ -1485,7 +1524,7 @@ bool Style::eventFilter(QObject *object, QEvent *event)
         }
         break;
     case QEvent::WindowDeactivate:
-        if(opts.shadeMenubarOnlyWhenActive && SHADE_NONE!=opts.shadeMenubars && qobject_cast<QMenuBar *>(object))
+        if(opts.shadeMenubarOnlyWhenActive && SHADE_NONE!=opts.shadeMenubars && classes & CLASS_MENU_BAR)
         {
             m_active=false;
             ((QWidget *)object)->repaint();
@@ -1849,8 +1888,23 @@ Style::styleHint(StyleHint hint, const QStyleOption *option,
     case SH_Menu_MouseTracking:
         return true;
     case SH_UnderlineShortcut:
-        return ((widget && opts.hideShortcutUnderline) ?
-                m_shortcutHandler->showShortcut(widget) : true);
+        if (widget && opts.hideShortcutUnderline) {
+            // Remember where the mnemonic is drawn so that pressing Alt
+            // only repaints that area.
+            if (mayHaveMnemonic(option)) {
+                QRect rect = option ? option->rect : widget->rect();
+                if (auto groupBox =
+                    styleOptCast<QStyleOptionGroupBox>(option)) {
+                    rect = (subControlRect(CC_GroupBox, groupBox,
+                                           SC_GroupBoxLabel, widget) |
+                            subControlRect(CC_GroupBox, groupBox,
+                                           SC_GroupBoxCheckBox, widget));
+                }
+                m_shortcutHandler->addMnemonic(widget, rect);
+            }
+            return m_shortcutHandler->showShortcut(widget);
+        }
+        return true;
     case SH_GroupBox_TextLabelVerticalAlignment:
         if (auto frame = styleOptCast<QStyleOptionGroupBox>(option)) {
             if (frame->features & QStyleOptionFrame::Flat) {
@@ -2059,6 +2113,8 @@ void
 Style::drawPrimitive(PrimitiveElement element, const QStyleOption *option,
                      QPainter *painter, const QWidget *widget) const
 {
+    QTC_TRACE_SCOPE("Style::drawPrimitive");
+    Stats::countDraw(Stats::Draw::Primitive, element);
     prePolish(widget);
     bool (Style::*drawFunc)(PrimitiveElement, const QStyleOption*,
                             QPainter*, const QWidget*) const = nullptr;
@@ -2185,6 +2241,8 @@ void
 Style::drawControl(ControlElement element, const QStyleOption *option,
                    QPainter *painter, const QWidget *widget) const
 {
+    QTC_TRACE_SCOPE("Style::drawControl");
+    Stats::countDraw(Stats::Draw::Control, element);
     prePolish(widget);
     QRect r = option->rect;
     const State &state = option->state;
@@ -4566,6 +4624,8 @@ Style::drawControl(ControlElement element, const QStyleOption *option,
 
 void Style::drawComplexControl(ComplexControl control, const QStyleOptionComplex *option, QPainter *painter, const QWidget *widget) const
 {
+    QTC_TRACE_SCOPE("Style::drawComplexControl");
+    Stats::countDraw(Stats::Draw::ComplexControl, control);
     prePolish(widget);
     QRect               r(option->rect);
     const State &state(option->state);
@@ -4674,9 +4734,9 @@ void Style::drawComplexControl(ComplexControl control, const QStyleOptionComplex
 
             if (widget) {
                 if ((opts.dwtSettings & DWT_BUTTONS_AS_PER_TITLEBAR) &&
-                    (widget->inherits("QDockWidgetTitleButton") ||
-                     qtcCheckType(getParent(widget),
-                                  "KoDockWidgetTitleBar"))) {
+                    (classFlags(widget) & CLASS_DOCK_WIDGET_TITLE_BUTTON ||
+                     classFlags(getParent(widget)) &
+                     CLASS_KO_DOCK_TITLE_BAR)) {
                     ETitleBarButtons btn = TITLEBAR_CLOSE;
                     Icon icon = ICN_CLOSE;
 
@@ -4810,7 +4870,7 @@ void Style::drawComplexControl(ComplexControl control, const QStyleOptionComplex
                 // are much thinner then normal, and QToolBarExtension does not
                 // seem to take this into account - so adjust the size here...
                 QWidget *parent = getParent(widget);
-                if (widget->inherits("QToolBarExtension") && parent) {
+                if (classFlags(widget) & CLASS_TOOL_BAR_EXTENSION && parent) {
                     if (r.height() > parent->rect().height()) {
                         heightAdjust = (r.height() -
                                         parent->rect().height()) + 2;
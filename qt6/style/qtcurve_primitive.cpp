@@ -150,7 +150,7 @@ Style::drawPrimitivePanelScrollAreaCorner(PrimitiveElement,
     // color which does not work for windows that have gradients.
     // ...but need to for WebView!!!
     if (!opts.gtkScrollViews || !qtcIsCustomBgnd(opts) ||
-        (widget && widget->inherits("WebView"))) {
+        classFlags(widget) & CLASS_WEB_VIEW) {
         painter->fillRect(option->rect,
                           option->palette.brush(QPalette::Window));
     }
@@ -322,7 +322,7 @@ Style::drawPrimitiveIndicatorArrow(PrimitiveElement element,
             r.adjust(1, 1, 1, 1);
         }
         if (col.alpha() < 255 && element == PE_IndicatorArrowRight &&
-            widget && widget->inherits("KUrlButton")) {
+            classFlags(widget) & CLASS_KURL_BUTTON) {
             col = blendColors(col, palette.window().color(), col.alphaF());
         }
         drawArrow(painter, r, element, col, false, false);
@@ -825,7 +825,8 @@ Style::drawPrimitivePanelItemViewItem(PrimitiveElement,
                         opt->backgroundBrush.color() :
                         palette.color(cg, QPalette::Highlight));
         bool square = ((opts.square & SQUARE_LISTVIEW_SELECTION) &&
-                       ((widget && !widget->inherits("KFilePlacesView") &&
+                       ((widget &&
+                         !(classFlags(widget) & CLASS_FILE_PLACES_VIEW) &&
                          (qobject_cast<const QTreeView*>(widget) ||
                           (qobject_cast<const QListView*>(widget) &&
                            ((const QListView*)widget)->viewMode() !=
@@ -1170,7 +1171,8 @@ Style::drawPrimitiveButton(PrimitiveElement element, const QStyleOption *option,
         } else if (constDwtFloat == widget->objectName()) {
             use = m_titleBarButtonsCols[TITLEBAR_MAX];
         } else if (qtcCheckType<QDockWidget>(getParent<2>(widget)) &&
-                   widget->parentWidget()->inherits("KoDockWidgetTitleBar")) {
+                   (classFlags(widget->parentWidget()) &
+                    CLASS_KO_DOCK_TITLE_BAR)) {
             QDockWidget *dw = (QDockWidget*)getParent<2>(widget);
             QWidget *koDw = widget->parentWidget();
             int fw = (dw->isFloating() ?
@@ -1372,7 +1374,7 @@ Style::drawPrimitiveFrameFocusRect(PrimitiveElement, const QStyleOption *option,
 
     if (auto focusFrame = styleOptCast<QStyleOptionFocusRect>(option)) {
         if (!(focusFrame->state & State_KeyboardFocusChange) ||
-            (widget && widget->inherits("QComboBoxListView"))) {
+            classFlags(widget) & CLASS_COMBO_LIST_VIEW) {
             return true;
         }
         if (widget && opts.focus == FOCUS_GLOW) {
@@ -1470,7 +1472,8 @@ Style::drawPrimitiveFrameFocusRect(PrimitiveElement, const QStyleOption *option,
                 if (opts.round != ROUND_NONE) {
                     bool square((opts.square & SQUARE_LISTVIEW_SELECTION) &&
                                 (((widget &&
-                                   !widget->inherits("KFilePlacesView") &&
+                                   !(classFlags(widget) &
+                                     CLASS_FILE_PLACES_VIEW) &&
                                    (qobject_cast<const QTreeView*>(widget) ||
                                     (qobject_cast<const QListView*>(widget) &&
                                      ((const QListView*)widget)->viewMode() !=
@@ -1803,10 +1806,7 @@ Style::drawPrimitiveIndicatorCheckBox(PrimitiveElement element,
                              opts.menuTick, QPalette::Text);
             painter->restore();
         } else {
-            QPixmap *pix = getPixmap(checkRadioCol(option), PIX_CHECK, 1.0);
-
-            painter->drawPixmap(rect.center().x() - pix->width() / 2,
-                                rect.center().y() - pix->height() / 2, *pix);
+            drawCheckMark(painter, rect.center(), checkRadioCol(option));
         }
     } else if (state & State_NoChange) {
         // tri-state
@@ -1952,9 +1952,9 @@ Style::drawPrimitiveButtonTool(PrimitiveElement element,
             return true;
         }
     }
-    bool dwt = widget && widget->inherits("QDockWidgetTitleButton");
-    bool koDwt = (!dwt && widget && widget->parentWidget() &&
-                  widget->parentWidget()->inherits("KoDockWidgetTitleBar"));
+    bool dwt = classFlags(widget) & CLASS_DOCK_WIDGET_TITLE_BUTTON;
+    bool koDwt = (!dwt && widget &&
+                  classFlags(widget->parentWidget()) & CLASS_KO_DOCK_TITLE_BAR);
     if (((state & State_Enabled) || !(state & State_AutoRaise)) &&
         (!widget || !(dwt || koDwt) || (state & State_MouseOver))) {
         QStyleOption opt(*option);
@@ -53,12 +53,17 @@
 #include <QSettings>
 #include <QPixmapCache>
 #include <QTextStream>
+#include <QHash>
+#include <QCache>
+#include <QMutex>
 
 #include "shadowhelper.h"
 #include <qtcurve-utils/x11qtc.h>
 #include <qtcurve-utils/qtutils.h>
 #include <sys/time.h>
 
+#include <atomic>
+
 namespace QtCurve {
 
 bool
@@ -218,26 +223,58 @@ updateMenuBarEvent(QMouseEvent *event, QMenuBar *menu)
     return false;
 }
 
-QRegion
-windowMask(const QRect &r, bool full)
+static QRegion
+createWindowMask(int w, int h, bool full)
 {
-    int x, y, w, h;
-    r.getRect(&x, &y, &w, &h);
-
     if (full) {
-        QRegion region(x + 4, y + 0, w-4*2, h-0*2);
-        region += QRegion(x + 0, y + 4, w-0*2, h-4*2);
-        region += QRegion(x + 2, y + 1, w-2*2, h-1*2);
-        region += QRegion(x + 1, y + 2, w-1*2, h-2*2);
+        QRegion region(4, 0, w-4*2, h-0*2);
+        region += QRegion(0, 4, w-0*2, h-4*2);
+        region += QRegion(2, 1, w-2*2, h-1*2);
+        region += QRegion(1, 2, w-1*2, h-2*2);
         return region;
     } else {
-        QRegion region(x+1, y+1, w-2, h-2);
-        region += QRegion(x, y+2, w, h-4);
-        region += QRegion(x+2, y, w-4, h);
+        QRegion region(1, 1, w-2, h-2);
+        region += QRegion(0, 2, w, h-4);
+        region += QRegion(2, 0, w-4, h);
         return region;
     }
 }
 
+QRegion
+windowMask(const QRect &r, bool full)
+{
+    // Popups keep their size while they are repainted and tend to come back
+    // with the same size, so keep the shapes of the last few sizes around.
+    static QCache<quint64, QRegion> cache(16);
+    static QMutex mutex;
+    const quint64 key = ((quint64(quint32(r.width())) << 33) |
+                         (quint64(quint32(r.height())) << 1) | (full ? 1 : 0));
+    QMutexLocker locker(&mutex);
+    QRegion *region = cache.object(key);
+    if (!region) {
+        region = new QRegion(createWindowMask(r.width(), r.height(), full));
+        cache.insert(key, region);
+    }
+    return region->translated(r.topLeft());
+}
+
+void
+setWindowMask(QWidget *widget, bool full)
+{
+    // With an alpha channel the corners are painted transparent instead,
+    // don't pay for shaping the window (a round trip on remote X).
+    if (Utils::hasAlphaChannel(widget)) {
+        if (!widget->mask().isEmpty()) {
+            widget->clearMask();
+        }
+        return;
+    }
+    QRegion mask(windowMask(widget->rect(), full));
+    if (mask != widget->mask()) {
+        widget->setMask(mask);
+    }
+}
+
 const QWidget*
 getWidget(const QPainter *p)
 {
@@ -420,4 +457,124 @@ isA(const QObject *w, const char *type)
                    0 == strcmp(w->parent()->metaObject()->className(), type))));
 }
 
+static const struct {
+    const char *name;
+    unsigned flag;
+} classNames[] = {
+    {"QMenuBar", CLASS_MENU_BAR},
+    {"QAbstractScrollArea", CLASS_SCROLL_AREA},
+    {"KFilePlacesView", CLASS_FILE_PLACES_VIEW},
+    {"QComboBoxPrivateContainer", CLASS_COMBO_CONTAINER},
+    {"QComboBoxListView", CLASS_COMBO_LIST_VIEW},
+    {"QMainWindow", CLASS_MAIN_WINDOW},
+    {"QStatusBar", CLASS_STATUS_BAR},
+    {"QLabel", CLASS_LABEL},
+    {"QFrame", CLASS_FRAME},
+    {"QProgressBar", CLASS_PROGRESS_BAR},
+    {"QTipLabel", CLASS_TIP_LABEL},
+    {"QWhatsThat", CLASS_WHATS_THAT},
+    {"QPrintPropertiesDialog", CLASS_PRINT_PROPERTIES_DIALOG},
+    {"QWorkspaceTitleBar", CLASS_WORKSPACE_TITLE_BAR},
+    {"QDockSeparator", CLASS_DOCK_SEPARATOR},
+    {"QDockWidgetSeparator", CLASS_DOCK_SEPARATOR},
+    {"QDockWidgetTitleButton", CLASS_DOCK_WIDGET_TITLE_BUTTON},
+    {"QToolBarExtension", CLASS_TOOL_BAR_EXTENSION},
+    {"K3b::ThemedHeader", CLASS_K3B_THEMED_HEADER},
+    {"KColorPatch", CLASS_KCOLOR_PATCH},
+    {"KUrlButton", CLASS_KURL_BUTTON},
+    {"KoDockWidgetTitleBar", CLASS_KO_DOCK_TITLE_BAR},
+    {"Sublime::IdealButtonBarWidget", CLASS_IDEAL_BUTTON_BAR},
+    {"WebView", CLASS_WEB_VIEW}
+};
+
+typedef QHash<const QMetaObject*, unsigned> ClassFlagsCache;
+
+// Caller must hold the lock.
+static unsigned
+metaClassFlags(ClassFlagsCache &cache, const QMetaObject *meta)
+{
+    if (!meta) {
+        return 0;
+    }
+    auto it = cache.constFind(meta);
+    if (it != cache.constEnd()) {
+        return *it;
+    }
+    unsigned flags = metaClassFlags(cache, meta->superClass());
+    const char *name = meta->className();
+    for (const auto &className: classNames) {
+        if (strcmp(className.name, name) == 0) {
+            flags |= className.flag;
+            break;
+        }
+    }
+    cache.insert(meta, flags);
+    return flags;
+}
+
+// Classes seen so far, for lookups without a lock. This is called for
+// every event the style filters and widgets may be painted from other
+// threads. Slots are only filled (under the lock) while the style is in
+// use and the flags are written before the meta object is published, so a
+// reader that finds its meta object can read the flags. Classes that don't
+// fit are still found in the locked cache. Both are emptied by
+// clearClassFlags().
+struct ClassFlagsSlot {
+    std::atomic<const QMetaObject*> meta;
+    unsigned flags;
+};
+static constexpr size_t classFlagsSlots = 1024;
+static constexpr size_t classFlagsProbes = 8;
+static ClassFlagsSlot classFlagsTable[classFlagsSlots];
+static ClassFlagsCache classFlagsCache;
+static QMutex classFlagsLock;
+
+static inline size_t
+classFlagsSlot(const QMetaObject *meta, size_t probe)
+{
+    return ((uintptr_t)meta / sizeof(void*) + probe) % classFlagsSlots;
+}
+
+unsigned
+classFlags(const QObject *w)
+{
+    if (!w) {
+        return 0;
+    }
+    const QMetaObject *meta = w->metaObject();
+    for (size_t i = 0;i < classFlagsProbes;i++) {
+        ClassFlagsSlot &slot = classFlagsTable[classFlagsSlot(meta, i)];
+        const QMetaObject *slotMeta = slot.meta.load(std::memory_order_acquire);
+        if (qtcLikely(slotMeta == meta)) {
+            return slot.flags;
+        } else if (!slotMeta) {
+            break;
+        }
+    }
+    QMutexLocker locker(&classFlagsLock);
+    const unsigned flags = metaClassFlags(classFlagsCache, meta);
+    for (size_t i = 0;i < classFlagsProbes;i++) {
+        ClassFlagsSlot &slot = classFlagsTable[classFlagsSlot(meta, i)];
+        const QMetaObject *slotMeta = slot.meta.load(std::memory_order_relaxed);
+        if (slotMeta == meta) {
+            break;
+        } else if (!slotMeta) {
+            slot.flags = flags;
+            slot.meta.store(meta, std::memory_order_release);
+            break;
+        }
+    }
+    return flags;
+}
+
+void
+clearClassFlags()
+{
+    QMutexLocker locker(&classFlagsLock);
+    for (auto &slot: classFlagsTable) {
+        slot.meta.store(nullptr, std::memory_order_relaxed);
+    }
+    classFlagsCache.clear();
+}
+
 }
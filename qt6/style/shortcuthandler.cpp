@@ -27,7 +27,6 @@
 
 #include <QWidget>
 #include <QMenu>
-#include <QMenuBar>
 #include <QEvent>
 #include <QKeyEvent>
 
@@ -70,19 +69,49 @@ bool ShortcutHandler::showShortcut(const QWidget *widget) const
     return m_altDown && hasSeenAlt(widget);
 }
 
+void ShortcutHandler::watchWidget(QWidget *w)
+{
+    connect(w, &QObject::destroyed, this, &ShortcutHandler::widgetDestroyed,
+            Qt::UniqueConnection);
+}
+
 void ShortcutHandler::widgetDestroyed(QObject *o)
 {
     m_updated.remove(static_cast<QWidget *>(o));
+    m_mnemonics.remove(static_cast<QWidget *>(o));
     m_openMenus.removeAll(static_cast<QWidget *>(o));
 }
 
+void ShortcutHandler::addMnemonic(const QWidget *widget, const QRect &rect)
+{
+    if (!widget || rect.isEmpty())
+        return;
+    QWidget *w = const_cast<QWidget*>(widget);
+    auto it = m_mnemonics.find(w);
+    if (it == m_mnemonics.end()) {
+        watchWidget(w);
+        it = m_mnemonics.insert(w, rect);
+    } else if (!it->contains(rect)) {
+        *it |= rect;
+    }
+    // Painted while the underline is shown, make sure it gets removed
+    // again when Alt is released.
+    if (m_altDown && !m_updated.contains(w) && hasSeenAlt(w)) {
+        m_updated.insert(w, *it);
+    }
+}
+
 void ShortcutHandler::updateWidget(QWidget *w)
+{
+    updateWidget(w, w->rect());
+}
+
+void ShortcutHandler::updateWidget(QWidget *w, const QRect &rect)
 {
     if (!m_updated.contains(w)) {
-        m_updated.insert(w);
-        w->update();
-        connect(qtcSlot(w, destroyed),
-                qtcSlot(this, widgetDestroyed));
+        m_updated.insert(w, rect);
+        w->update(rect);
+        watchWidget(w);
     }
 }
 
@@ -109,16 +138,14 @@ bool ShortcutHandler::eventFilter(QObject *o, QEvent *e)
             {
                 widget = widget->window();
                 m_seenAlt.insert(widget);
-                QList<QWidget*> l = widget->findChildren<QWidget*>();
-                for (int pos = 0;pos < l.size();++pos) {
-                    QWidget *w = l.at(pos);
-                    if (!(w->isWindow() || !w->isVisible())) // || w->style()->styleHint(QStyle::SH_UnderlineShortcut, 0, w)))
-                        updateWidget(w);
-                }
-
-                QList<QMenuBar*> m = widget->findChildren<QMenuBar*>();
-                for (int i = 0;i < m.size();++i) {
-                    updateWidget(m.at(i));
+                // Only repaint the text of widgets known to show mnemonics
+                // instead of every widget in the window.
+                for (auto it = m_mnemonics.cbegin();
+                     it != m_mnemonics.cend();++it) {
+                    QWidget *w = it.key();
+                    if (w->window() == widget && w->isVisible()) {
+                        updateWidget(w, it.value());
+                    }
                 }
             }
         }
@@ -128,11 +155,9 @@ bool ShortcutHandler::eventFilter(QObject *o, QEvent *e)
         if (QEvent::WindowDeactivate == e->type() ||
             static_cast<QKeyEvent*>(e)->key() == Qt::Key_Alt) {
             m_altDown = false;
-            for (QWidget *widget: const_(m_updated)) {
-                widget->update();
+            for (auto it = m_updated.cbegin();it != m_updated.cend();++it) {
+                it.key()->update(it.value());
             }
-            if (!m_updated.contains(widget))
-                widget->update();
             m_seenAlt.clear();
             m_updated.clear();
         }
@@ -144,8 +169,7 @@ bool ShortcutHandler::eventFilter(QObject *o, QEvent *e)
             m_openMenus.append(widget);
             if(m_altDown && prev)
                 prev->update();
-            connect(qtcSlot(widget, destroyed),
-                    qtcSlot(this, widgetDestroyed));
+            watchWidget(widget);
         }
         break;
     case QEvent::Hide:
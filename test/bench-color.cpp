@@ -0,0 +1,110 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+// Measures how many colors per second the color math in qtcurve-utils
+// processes, the way the styles use it when computing their palettes.
+//
+//     bench-color [colors]
+
+#include <qtcurve-utils/color.h>
+#include <qtcurve-utils/timer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+using namespace QtCurve;
+
+static volatile double sink;
+
+template<typename Func>
+static void
+run(const char *name, const std::vector<QtcColor> &colors, Func func)
+{
+    double sum = 0;
+    uint64_t start = getTime();
+    for (const QtcColor &color: colors) {
+        sum += func(color);
+    }
+    uint64_t elapse = getElapse(start);
+    sink = sum;
+    printf("%-12s %8.2f M colors/s\n", name,
+           colors.size() * 1e3 / (elapse ? elapse : 1));
+}
+
+int
+main(int argc, char **argv)
+{
+    const int total = argc > 1 ? atoi(argv[1]) : 1000000;
+    std::vector<QtcColor> colors(total);
+    srand(0);
+    for (QtcColor &color: colors) {
+        qtcColorFill(&color, rand() / (double)RAND_MAX,
+                     rand() / (double)RAND_MAX, rand() / (double)RAND_MAX);
+    }
+    const QtcColor base = {0.5, 0.6, 0.7};
+
+    run("luma", colors, [] (const QtcColor &color) {
+            return qtcColorHCYLuma(&color);
+        });
+    run("shade-hcy", colors, [] (const QtcColor &color) {
+            QtcColor out;
+            _qtcShade(&color, &out, 1.16, Shading::HCY);
+            return out.red;
+        });
+    run("darken-hcy", colors, [] (const QtcColor &color) {
+            QtcColor out;
+            _qtcShade(&color, &out, 0.62, Shading::HCY);
+            return out.green;
+        });
+    run("shade-hsv", colors, [] (const QtcColor &color) {
+            QtcColor out;
+            _qtcShade(&color, &out, 1.16, Shading::HSV);
+            return out.blue;
+        });
+    // The standard shades and highlight of a palette, one at a time and
+    // batched.
+    static const double shades[] = {1.16, 1.07, 0.9, 0.782, 0.84, 0.62, 1.2};
+    run("palette-1", colors, [] (const QtcColor &color) {
+            QtcColor out[7];
+            for (int i = 0;i < 7;i++) {
+                _qtcShade(&color, &out[i], shades[i], Shading::HCY);
+            }
+            return out[6].red;
+        });
+    run("palette-n", colors, [] (const QtcColor &color) {
+            QtcColor out[7];
+            _qtcShadeN(&color, shades, out, 7, Shading::HCY);
+            return out[6].red;
+        });
+    run("mix", colors, [&] (const QtcColor &color) {
+            QtcColor out;
+            _qtcColorMix(&base, &color, 0.3, &out);
+            return out.red;
+        });
+    run("tint", colors, [&] (const QtcColor &color) {
+            QtcColor out;
+            _qtcColorTint(&base, &color, 0.3, &out);
+            return out.red;
+        });
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+// Polishes a large form with the QtCurve style the way a dialog heavy
+// application does at startup and prints how long it takes.
+//
+//     bench-polish-qt5 [widgets] [rounds]
+
+#include <QApplication>
+#include <QPluginLoader>
+#include <QStylePlugin>
+#include <QElapsedTimer>
+#include <QVBoxLayout>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QLabel>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QRadioButton>
+#include <QPushButton>
+#include <QProgressBar>
+#include <QSlider>
+#include <QListWidget>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static QWidget*
+createField(int i, QWidget *parent)
+{
+    switch (i % 9) {
+    case 0:
+        return new QLineEdit(parent);
+    case 1: {
+        auto combo = new QComboBox(parent);
+        combo->addItems({"a", "b", "c"});
+        return combo;
+    }
+    case 2:
+        return new QSpinBox(parent);
+    case 3:
+        return new QCheckBox("Check", parent);
+    case 4:
+        return new QRadioButton("Radio", parent);
+    case 5:
+        return new QPushButton("Button", parent);
+    case 6:
+        return new QProgressBar(parent);
+    case 7:
+        return new QSlider(Qt::Horizontal, parent);
+    default:
+        return new QListWidget(parent);
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    const int total = argc > 1 ? atoi(argv[1]) : 5000;
+    const int rounds = argc > 2 ? atoi(argv[2]) : 10;
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QPluginLoader loader(QTC_STYLE_PLUGIN);
+    auto plugin = qobject_cast<QStylePlugin*>(loader.instance());
+    assert(plugin);
+    QStyle *style = plugin->create("qtcurve");
+    assert(style);
+    QApplication::setStyle(style);
+
+    // Rows of a label and a field, ten rows to a group box.
+    QWidget form;
+    auto top = new QVBoxLayout(&form);
+    QFormLayout *layout = nullptr;
+    int count = 0;
+    for (int i = 0;count < total;i++) {
+        if (i % 10 == 0) {
+            auto group = new QGroupBox("Group", &form);
+            top->addWidget(group);
+            layout = new QFormLayout(group);
+            count++;
+        }
+        layout->addRow(new QLabel("Label"), createField(i, &form));
+        count += 2;
+    }
+    const QList<QWidget*> widgets = form.findChildren<QWidget*>();
+
+    QElapsedTimer timer;
+    timer.start();
+    form.ensurePolished();
+    const qint64 first = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int r = 0;r < rounds;r++) {
+        for (QWidget *widget: widgets) {
+            style->unpolish(widget);
+            style->polish(widget);
+        }
+    }
+    const qint64 again = timer.nsecsElapsed();
+
+    printf("widgets: %d\n", int(widgets.size()) + 1);
+    printf("first polish: %.3f ms\n", first / 1e6);
+    printf("unpolish + polish: %.3f ms per round (%d rounds)\n",
+           again / 1e6 / (rounds > 0 ? rounds : 1), rounds);
+    return 0;
+}
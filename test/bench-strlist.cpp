@@ -0,0 +1,95 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+// Compares splitting a long application list with qtcStrLoadStrList, which
+// allocates every item, and with StrList::split, which returns views into
+// the string.
+//
+//     bench-strlist [rounds]
+
+#include <qtcurve-utils/strs.h>
+#include <qtcurve-utils/timer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+using namespace QtCurve;
+
+static volatile size_t sink;
+
+template<typename Func>
+static void
+run(const char *name, int rounds, Func func)
+{
+    // A long noBgndGradientApps style list.
+    std::string apps;
+    for (int i = 0;i < 200;i++) {
+        apps += i ? ",application" : "application";
+        apps += std::to_string(i);
+    }
+    size_t total = 0;
+    uint64_t start = getTime();
+    for (int r = 0;r < rounds;r++) {
+        total += func(apps);
+    }
+    uint64_t elapse = getElapse(start);
+    sink = total;
+    printf("%-18s %8.2f us/list\n", name, elapse / 1000. / rounds);
+}
+
+static size_t
+loadStrList(const std::string &apps)
+{
+    size_t total = 0;
+    size_t len;
+    char **list = qtcStrLoadStrList(apps.c_str(), , , &len, , ,);
+    for (size_t i = 0;i < len;i++) {
+        total += strlen(list[i]);
+        free(list[i]);
+    }
+    free(list);
+    return total;
+}
+
+static size_t
+split(const std::string &apps)
+{
+    size_t total = 0;
+    LocalBuff<std::string_view, 256> views;
+    Str::Buff<1024> arena;
+    size_t len = StrList::split(apps, views, arena);
+    for (size_t i = 0;i < len;i++) {
+        total += views[i].size();
+    }
+    return total;
+}
+
+int
+main(int argc, char **argv)
+{
+    const int rounds = argc > 1 ? atoi(argv[1]) : 2000;
+    run("qtcStrLoadStrList", rounds, loadStrList);
+    run("StrList::split", rounds, split);
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+// Measures the lookup time of the runtime StrMap and of the compile time
+// StaticStrMap.
+//
+//     bench-strmap [rounds]
+
+#include <qtcurve-utils/map.h>
+#include <qtcurve-utils/timer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace QtCurve;
+
+#define STRINGS "jk", "yz", "OP", "LM", "XY", "FG", "MN", "st", "VW", "qr", \
+        "vw", "bc", "xy", "gh", "cd", "mn", "op", "ab", "[\\", "WX", "BC", \
+        "CD", "IJ", "QR", "Z[", "uv", "_`", "ij", "hi", "no", "HI", "DE", \
+        "YZ", "PQ", "ef", "de", "pq", "tu", "fg", "lm", "JK", "kl", "AB", \
+        "KL", "TU", "]^", "ST", "EF", "z{", "RS", "wx", "^_", "rs", "`a", \
+        "\\]", "UV", "GH", "NO"
+
+static volatile int sink;
+
+static int
+search_map(const char *str)
+{
+    static const StrMap<> auto_map(STRINGS);
+    return auto_map.search(str);
+}
+
+static int
+search_static_map(const char *str)
+{
+    static constexpr auto static_map = makeStaticStrMap({STRINGS});
+    return static_map.search(str);
+}
+
+template<typename Func>
+static void
+run(const char *name, int rounds, Func func)
+{
+    static const char *const keys[] = {STRINGS, "ab", "AB", "xyz", "",
+                                       "qq", "Zz"};
+    const size_t nkeys = sizeof(keys) / sizeof(keys[0]);
+    int sum = 0;
+    uint64_t start = getTime();
+    for (int r = 0;r < rounds;r++) {
+        for (size_t i = 0;i < nkeys;i++) {
+            sum += func(keys[i]);
+        }
+    }
+    uint64_t elapse = getElapse(start);
+    sink = sum;
+    printf("%-14s %6.2f ns/lookup\n", name,
+           elapse / double(rounds * nkeys));
+}
+
+int
+main(int argc, char **argv)
+{
+    const int rounds = argc > 1 ? atoi(argv[1]) : 20000;
+    run("StrMap", rounds, search_map);
+    run("StaticStrMap", rounds, search_static_map);
+    return 0;
+}
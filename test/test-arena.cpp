@@ -0,0 +1,81 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include <qtcurve-utils/strs.h>
+#include <assert.h>
+
+using namespace QtCurve;
+
+static void
+fill_buffs()
+{
+    Arena::Scope scope;
+    for (int i = 0;i < 100;i++) {
+        Str::Buff<8, ArenaAlloc> buff;
+        buff.printf("%s-%d-%s", "some long enough prefix", i,
+                    "and a suffix");
+        assert(strncmp(buff, "some long enough prefix-", 24) == 0);
+        buff.append(", appended");
+        LocalBuff<int, 4, ArenaAlloc> ints(64);
+        for (int j = 0;j < 64;j++) {
+            ints[j] = j;
+        }
+        ints.resize(128);
+        assert(ints[63] == 63);
+    }
+}
+
+int
+main()
+{
+    // the first scope allocates the block
+    fill_buffs();
+    size_t count = heapAllocCount();
+    // which is reused afterwards
+    fill_buffs();
+    fill_buffs();
+    assert(heapAllocCount() == count);
+
+    {
+        Arena::Scope scope;
+        Str::Buff<4, ArenaAlloc> buff;
+        buff.cat("abc", "def", "ghi");
+        char *p = buff.get();
+        // the last allocation is grown in place
+        buff.append("jkl");
+        assert(buff.get() == p);
+        assert(strcmp(buff, "abcdefghijkl") == 0);
+        {
+            Arena::Scope inner;
+            // allocations larger than a block get their own
+            char *big = (char*)Arena::local().alloc(1 << 20);
+            memset(big, 1, 1 << 20);
+        }
+        assert(strcmp(buff, "abcdefghijkl") == 0);
+    }
+
+    count = heapAllocCount();
+    Str::Buff<4> heap_buff;
+    heap_buff.printf("%s", "longer than four");
+    assert(heapAllocCount() == count + 1);
+    assert(strcmp(heap_buff, "longer than four") == 0);
+    return 0;
+}
@@ -0,0 +1,40 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include <qtcurve-utils/color.h>
+#include <assert.h>
+#include <math.h>
+
+int
+main()
+{
+    // The tables have to match pow() closely enough that no 16 bit color
+    // channel changes.
+    for (int i = 0;i <= 65535;i++) {
+        double x = i / 65535.0;
+        assert(fabs(qtcColorHCYGamma(x) - pow(x, 2.2)) < 1e-6);
+        assert(fabs(qtcColorHCYIGamma(x) - pow(x, 1 / 2.2)) < 1e-5);
+    }
+    assert(qtcColorHCYGamma(-1) == 0 && qtcColorHCYIGamma(-1) == 0);
+    assert(qtcColorHCYGamma(2) == 1 && qtcColorHCYIGamma(2) == 1);
+    assert(qtcColorHCYGamma(NAN) == 1 && qtcColorHCYIGamma(NAN) == 1);
+    return 0;
+}
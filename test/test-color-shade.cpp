@@ -0,0 +1,56 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include <qtcurve-utils/color.h>
+#include <assert.h>
+
+int
+main()
+{
+    static const Shading shadings[] = {
+        Shading::Simple, Shading::HSL, Shading::HSV, Shading::HCY};
+    static const double k[] = {1.0, 1.16, 0.62, 1.0, 0.85};
+    const int n = sizeof(k) / sizeof(k[0]);
+    const QtcColor base = {0.3, 0.5, 0.7};
+    for (Shading shading: shadings) {
+        QtcColor out[n];
+        _qtcShadeN(&base, k, out, n, shading);
+        for (int i = 0;i < n;i++) {
+            QtcColor single;
+            _qtcShade(&base, &single, k[i], shading);
+            assert(qtcEqual(single.red, out[i].red) &&
+                   qtcEqual(single.green, out[i].green) &&
+                   qtcEqual(single.blue, out[i].blue));
+        }
+        assert(out[0].red == base.red && out[0].green == base.green &&
+               out[0].blue == base.blue);
+        // The first result overwrites the input.
+        QtcColor in_place[n];
+        in_place[0] = base;
+        _qtcShadeN(&in_place[0], k, in_place, n, shading);
+        for (int i = 0;i < n;i++) {
+            assert(in_place[i].red == out[i].red &&
+                   in_place[i].green == out[i].green &&
+                   in_place[i].blue == out[i].blue);
+        }
+    }
+    return 0;
+}
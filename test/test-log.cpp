@@ -0,0 +1,125 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include <qtcurve-utils/log.h>
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+static const char *log_file = "test-log.out";
+
+// Run func in a child process with the given logging configuration and
+// return the number of lines it wrote to the log file.
+template<typename Func>
+static int
+runLogged(bool async, int rate, Func &&func, bool color=false)
+{
+    unlink(log_file);
+    pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        setenv("QTCURVE_LOG_FILE", log_file, 1);
+        setenv("QTCURVE_LOG_COLOR", color ? "1" : "0", 1);
+        setenv("QTCURVE_LOG_ASYNC", async ? "1" : "0", 1);
+        char rate_str[16];
+        sprintf(rate_str, "%d", rate);
+        setenv("QTCURVE_LOG_RATE", rate_str, 1);
+        func();
+        exit(0);
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    FILE *file = fopen(log_file, "r");
+    assert(file);
+    int lines = 0;
+    int resets = 0;
+    char line[1024];
+    while (fgets(line, sizeof(line), file)) {
+        const char *start = line;
+        if (color) {
+            // the color is reset after the newline of the message
+            for (const char *p = line;(p = strstr(p, "\e[0m"));p++) {
+                resets++;
+            }
+            if (strncmp(start, "\e[0m", 4) == 0) {
+                start += 4;
+            }
+            if (!*start) {
+                continue;
+            }
+            assert(strncmp(start, "\e[01;35m", 8) == 0);
+            start += 8;
+        }
+        assert(strncmp(start, "qtcLog-", strlen("qtcLog-")) == 0);
+        assert(line[strlen(line) - 1] == '\n');
+        lines++;
+    }
+    fclose(file);
+    unlink(log_file);
+    assert(!color || resets == lines);
+    return lines;
+}
+
+static void
+logFromThreads(int nthreads, int count)
+{
+    std::vector<std::thread> threads;
+    for (int i = 0;i < nthreads;i++) {
+        threads.emplace_back([=] {
+                for (int j = 0;j < count;j++) {
+                    qtcForceLog("thread %d message %d\n", i, j);
+                }
+            });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+}
+
+int
+main()
+{
+    assert(runLogged(false, 0, [] {logFromThreads(4, 100);}) == 400);
+    // everything queued is flushed on exit
+    assert(runLogged(true, 0, [] {logFromThreads(4, 100);}) == 400);
+    // one site, limited to 10 messages per second
+    int limited = runLogged(false, 10, [] {logFromThreads(1, 1000);});
+    assert(limited >= 10 && limited < 1000);
+    // the long message is truncated but still ends the line
+    assert(runLogged(true, 0, [] {
+                qtcForceLog("%s\n", std::string(2000, 'a').c_str());
+                qtcForceLog("short\n");
+            }) == 2);
+    // and resets the color
+    assert(runLogged(true, 0, [] {
+                qtcForceLog("%s\n", std::string(2000, 'a').c_str());
+                qtcForceLog("short\n");
+            }, true) == 2);
+    return 0;
+}
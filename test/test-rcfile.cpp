@@ -0,0 +1,113 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include <qtcurve-utils/rcfile.h>
+#include <assert.h>
+#include <stdio.h>
+#include <unistd.h>
+
+using namespace QtCurve;
+
+static const char rc_str[] =
+    "[Settings]\n"
+    "version=1.8.18\n"
+    "round=full\r\n"
+    "focus=glow\n"
+    "=ignored\n"
+    "no value line\n"
+    "animatedProgress=true\n"
+    "lighterPopupMenuBgnd=-5\n"
+    "menubarApps=amarok,arora\n"
+    "tabMouseOver=bot\n"
+    "round=extra\n"
+    "emptyEntry=\n"
+    "scrollbarType=next";
+
+int
+main()
+{
+    Config::RcFile cfg;
+    assert(!cfg.ok());
+    assert(!cfg.value("round"));
+
+    cfg.parse(rc_str, sizeof(rc_str) - 1);
+    assert(cfg.ok());
+    assert(cfg.size() == 9);
+    assert(!cfg.hasKey(""));
+    assert(!cfg.hasKey("no value line"));
+    assert(!cfg.hasKey("[Settings]"));
+    assert(strcmp(cfg.value("menubarApps"), "amarok,arora") == 0);
+    assert(strcmp(cfg.value("emptyEntry"), "") == 0);
+
+    assert(cfg.versionValue("version") == qtcMakeVersion(1, 8, 18));
+    assert(cfg.versionValue("round") == 0);
+    assert(cfg.intValue("lighterPopupMenuBgnd", 0) == -5);
+    assert(cfg.intValue("emptyEntry", 3) == 3);
+    assert(cfg.intValue("missing", 7) == 7);
+    assert(cfg.boolValue("animatedProgress", false));
+    assert(!cfg.boolValue("menubarApps", true));
+    assert(cfg.boolValue("emptyEntry", true));
+
+    // Repeated keys, the last one wins.
+    assert(cfg.value<ERound>("round", ROUND_NONE) == ROUND_EXTRA);
+    assert(cfg.value<EFocus>("focus", FOCUS_STANDARD) == FOCUS_GLOW);
+    assert(cfg.value<ETabMo>("tabMouseOver", TAB_MO_TOP) == TAB_MO_BOTTOM);
+    assert(cfg.value<EScrollbar>("scrollbarType",
+                                 SCROLLBAR_KDE) == SCROLLBAR_NEXT);
+    assert(cfg.value<EFocus>("menubarApps", FOCUS_LINE) == FOCUS_LINE);
+    assert(cfg.value<EGlow>("missing", GLOW_END) == GLOW_END);
+
+    assert(Config::loadValue<EMouseOver>("true", MO_NONE) == MO_COLORED);
+    assert(Config::loadValue<ETBarBorder>("light-all",
+                                          TB_NONE) == TB_LIGHT_ALL);
+    assert(Config::loadValue<EAlign>("center-full",
+                                     ALIGN_LEFT) == ALIGN_FULL_CENTER);
+    assert(Config::loadValue<EDefBtnIndicator>("border",
+                                               IND_NONE) == IND_FONT_COLOR);
+    assert(Config::loadValue<EStripe>(nullptr, STRIPE_FADE) == STRIPE_FADE);
+
+    const char *rc_file = "test-rcfile.rc";
+    FILE *file = fopen(rc_file, "w");
+    assert(file);
+    fwrite(rc_str, 1, sizeof(rc_str) - 1, file);
+    fclose(file);
+    assert(cfg.load(rc_file));
+    unlink(rc_file);
+    assert(cfg.size() == 9);
+    assert(strcmp(cfg.value("scrollbarType"), "next") == 0);
+    assert(cfg.value<ERound>("round", ROUND_NONE) == ROUND_EXTRA);
+
+    // The buffers are returned to the arena with the RcFile, so reading the
+    // config again does not allocate.
+    for (int i = 0;i < 3;i++) {
+        size_t count = heapAllocCount();
+        {
+            Config::RcFile tmp;
+            tmp.parse(rc_str, sizeof(rc_str) - 1);
+            assert(tmp.size() == 9);
+        }
+        assert(i == 0 || heapAllocCount() == count);
+    }
+
+    assert(!cfg.load("/nonexistent/qtcurve/stylerc"));
+    assert(!cfg.ok());
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include <qtcurve-utils/sprite.h>
+#include <assert.h>
+#include <stdint.h>
+
+using namespace QtCurve;
+
+static uint32_t
+pixel(const SpriteAtlas &atlas, int x, int y)
+{
+    return ((const uint32_t*)atlas.data())[y * atlas.width() + x];
+}
+
+int
+main()
+{
+    // 2x2 RGBA glyph: opaque black, half transparent black, transparent and
+    // opaque gray.
+    const unsigned char glyph[] = {
+        0, 0, 0, 255,  0, 0, 0, 128,
+        0, 0, 0, 0,  64, 64, 64, 255};
+    SpriteAtlas atlas(8, 16);
+    assert(atlas.size() == 0);
+    assert(atlas.get(0, 0, 0, 0).width == 0);
+    const int id = atlas.addGlyph(glyph, 2, 2, 8, QTC_PIXEL_RGBA);
+
+    const SpriteAtlas::Cell red = atlas.get(id, 255, 0, 0);
+    assert(red.width == 2 && red.height == 2);
+    assert(atlas.size() == 1);
+    assert(pixel(atlas, red.x, red.y) == 0xffff0000);
+    // premultiplied
+    assert(pixel(atlas, red.x + 1, red.y) == 0x80800000);
+    assert(pixel(atlas, red.x, red.y + 1) == 0);
+    // the tint minus the source
+    assert(pixel(atlas, red.x + 1, red.y + 1) == 0xffbf0000);
+
+    // Same key, same cell.
+    const unsigned gen = atlas.generation();
+    const SpriteAtlas::Cell again = atlas.get(id, 255, 0, 0);
+    assert(again.x == red.x && again.y == red.y);
+    assert(atlas.size() == 1 && atlas.generation() == gen);
+
+    const SpriteAtlas::Cell dark = atlas.get(id, 255, 0, 0, 0.5);
+    assert(dark.x != red.x || dark.y != red.y);
+    assert(pixel(atlas, dark.x, dark.y) == 0xff800000);
+
+    const SpriteAtlas::Cell big = atlas.get(id, 0, 0, 255, 1.0, 2.0);
+    assert(big.width == 4 && big.height == 4);
+    assert(pixel(atlas, big.x, big.y) == 0xff0000ff);
+    assert(pixel(atlas, big.x, big.y + 3) == 0);
+    assert(atlas.size() == 3);
+    // Cells do not overlap and stay inside the atlas.
+    assert(big.y >= red.y + red.height || big.x >= dark.x + dark.width);
+    assert(big.y + big.height <= atlas.height());
+
+    // Running out of space starts over.
+    for (int i = 0;i < 64;i++) {
+        const SpriteAtlas::Cell cell = atlas.get(id, i, 0, 0);
+        assert(cell.y + cell.height <= 16 && atlas.height() <= 16);
+        assert(pixel(atlas, cell.x, cell.y) == (0xff000000 | i << 16));
+    }
+    assert(atlas.size() < 64 && atlas.generation() != gen);
+
+    // Too large for the atlas.
+    assert(atlas.get(id, 0, 0, 0, 1.0, 5.0).width == 0);
+    return 0;
+}
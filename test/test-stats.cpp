@@ -0,0 +1,84 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include <qtcurve-utils/stats.h>
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <string>
+
+using namespace QtCurve;
+
+static const char *stats_file = "test-stats-%p.txt";
+
+static bool
+hasLine(const std::string &report, const std::string &line)
+{
+    return report.find("\n" + line + "\n") != std::string::npos;
+}
+
+int
+main()
+{
+    setenv("QTCURVE_STATS", stats_file, 1);
+    assert(Stats::enabled());
+    for (int i = 0;i < 10;i++) {
+        Stats::countCache(i % 3 == 0);
+    }
+    Stats::add(Stats::Counter::PixmapBytes, 1024);
+    {
+        Stats::Timer timer(Stats::Counter::ConfigLoad,
+                           Stats::Counter::ConfigLoadTime);
+    }
+    static const char primitive[] = "primitive";
+    for (int i = 0;i < 5;i++) {
+        Stats::countDraw(primitive, 3);
+        Stats::countDraw("primitive", 3);
+        Stats::countDraw(__func__);
+        Stats::countDraw(Stats::Draw::Primitive, 3);
+        // beyond the fixed counters, like CE_CustomBase
+        Stats::countDraw(Stats::Draw::Control, 0xf000000);
+    }
+    Stats::countDraw(primitive, 4);
+
+    std::string report = Stats::report();
+    assert(report.compare(0, 4, "pid ") == 0);
+    assert(hasLine(report, "pixmap_cache.hits 4"));
+    assert(hasLine(report, "pixmap_cache.misses 6"));
+    assert(hasLine(report, "pixmap_cache.bytes 1024"));
+    assert(hasLine(report, "config.loads 1"));
+    assert(hasLine(report, "draw.primitive.3 15"));
+    assert(hasLine(report, "draw.primitive.4 1"));
+    assert(hasLine(report, "draw.main 5"));
+    assert(hasLine(report, "draw.control.251658240 5"));
+
+    std::string fname = "test-stats-" + std::to_string(getpid()) + ".txt";
+    assert(Stats::dump());
+    FILE *file = fopen(fname.c_str(), "r");
+    assert(file);
+    char buff[4096];
+    size_t len = fread(buff, 1, sizeof(buff), file);
+    fclose(file);
+    assert(std::string(buff, len) == report);
+    return 0;
+}
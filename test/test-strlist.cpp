@@ -66,9 +66,47 @@ qtcStrListFunc2(const char *str, QtcStrListTest *data)
     return true;
 }
 
+static void
+test_views()
+{
+    LocalBuff<std::string_view, 4> views;
+    Str::Buff<8> arena;
+    size_t n = StrList::split(str1, views, arena, ';');
+    assert(n == sizeof(str_list1) / sizeof(char*));
+    assert(n == StrList::count(str1, ';'));
+    for (size_t i = 0;i < n;i++) {
+        assert(views[i] == str_list1[i]);
+    }
+    n = StrList::split(str2, views, arena);
+    assert(n == sizeof(str_list2) / sizeof(char*));
+    for (size_t i = 0;i < n;i++) {
+        assert(views[i] == str_list2[i]);
+    }
+    // no escapes, everything points into the original string
+    const char *plain = "a,bc,,d";
+    n = StrList::split(plain, views, arena);
+    assert(n == 4 && views[1] == "bc" && views[2].empty() && views[3] == "d");
+    assert(views[3].data() == plain + 6);
+
+    long ints[sizeof(int_list) / sizeof(long)];
+    n = StrList::loadNumbers(int_str, ints, sizeof(ints) / sizeof(long));
+    assert(n == sizeof(int_list) / sizeof(long));
+    assert(memcmp(int_list, ints, sizeof(int_list)) == 0);
+    double floats[3];
+    n = StrList::loadNumbers(float_str, floats, 3, 0.0);
+    assert(n == 3);
+    assert(memcmp(float_list, floats, sizeof(floats)) == 0);
+    int with_def[3];
+    n = StrList::loadNumbers("1,x,3", with_def, 3, 7);
+    assert(n == 3 && with_def[0] == 1 && with_def[1] == 7 &&
+           with_def[2] == 3);
+}
+
 int
 main()
 {
+    test_views();
+
     QtcStrListTest test1 = {
         .strs = str_list1,
         .index = 0,
@@ -74,8 +74,24 @@ search_case_map(const char *str)
     static const QtCurve::StrMap<int, false> auto_map(CASE_STRINGS);
     return auto_map.search(str);
 }
+
+static int
+search_static_case_map(const char *str)
+{
+    static constexpr auto static_map =
+        QtCurve::makeStaticStrMap<int, false>({CASE_STRINGS});
+    return static_map.search(str);
+}
 #endif
 
+static int
+search_static_map(const char *str)
+{
+    static constexpr auto static_map =
+        QtCurve::makeStaticStrMap({STRINGS});
+    return static_map.search(str);
+}
+
 int
 main()
 {
@@ -94,6 +110,7 @@ main()
                 } else {
                     assert(res == -1);
                 }
+                assert(search_static_map(key) == res);
             }
         }
     }
@@ -116,6 +133,7 @@ main()
                 } else {
                     assert(res == -1);
                 }
+                assert(search_static_case_map(key) == res);
             }
         }
     }
@@ -0,0 +1,101 @@
+/*****************************************************************************
+ *   Copyright 2026 Yichao Yu <yyc1992@gmail.com>                            *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU Lesser General Public License as          *
+ *   published by the Free Software Foundation; either version 2.1 of the    *
+ *   License, or (at your option) version 3, or any later version accepted   *
+ *   by the membership of KDE e.V. (or its successor approved by the         *
+ *   membership of KDE e.V.), which shall act as a proxy defined in          *
+ *   Section 6 of version 3 of the license.                                  *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU       *
+ *   Lesser General Public License for more details.                         *
+ *                                                                           *
+ *   You should have received a copy of the GNU Lesser General Public        *
+ *   License along with this library. If not,                                *
+ *   see <http://www.gnu.org/licenses/>.                                     *
+ *****************************************************************************/
+
+#include <qtcurve-utils/trace.h>
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>
+
+using namespace QtCurve;
+
+static const char *trace_file = "test-trace-%p.json";
+static char fname[64];
+
+static void
+nested(int depth)
+{
+    Trace::Scope scope(depth % 2 ? "odd \"scope\"" : "even scope");
+    if (depth > 0) {
+        nested(depth - 1);
+    }
+}
+
+static std::string
+readFile(const char *fname)
+{
+    std::string res;
+    FILE *file = fopen(fname, "r");
+    assert(file);
+    char buff[4096];
+    size_t len;
+    while ((len = fread(buff, 1, sizeof(buff), file)) > 0) {
+        res.append(buff, len);
+    }
+    fclose(file);
+    return res;
+}
+
+static size_t
+countOf(const std::string &str, const char *needle)
+{
+    size_t count = 0;
+    for (size_t pos = str.find(needle);pos != std::string::npos;
+         pos = str.find(needle, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+int
+main()
+{
+    snprintf(fname, sizeof(fname), "test-trace-%d.json", (int)getpid());
+    // registered first so that it runs after the dump at exit
+    atexit([] {unlink(fname);});
+    setenv("QTCURVE_TRACE", trace_file, 1);
+    assert(Trace::enabled());
+    nested(9);
+    std::thread([] {nested(3);}).join();
+    // wrap around the ring of the main thread
+    for (int i = 0;i < 100000;i++) {
+        Trace::Scope scope("loop");
+    }
+    assert(Trace::dump());
+    std::string json = readFile(fname);
+    assert(json.compare(0, 16, "{\"traceEvents\":[") == 0);
+    assert(json.compare(json.size() - 3, 3, "]}\n") == 0);
+    assert(countOf(json, "\"name\":\"odd \\\"scope\\\"\"") == 2);
+    assert(countOf(json, "\"name\":\"even scope\"") == 2);
+    assert(countOf(json, "\"tid\":1}") == (1 << 15));
+    assert(countOf(json, "\"tid\":2}") == 4);
+    // the buffer of the exited thread is reused by the next one
+    std::thread([] {nested(1);}).join();
+    assert(Trace::dump());
+    json = readFile(fname);
+    assert(countOf(json, "\"tid\":2}") == 0);
+    assert(countOf(json, "\"tid\":3}") == 2);
+    return 0;
+}
@@ -42,9 +42,15 @@ main(int argc, char **argv)
         size++;
     }
     fclose(inputfile);
+    // Decoded the first time it is used rather than when the style is loaded.
     fprintf(outputfile, "};\n"
-            "static const QImage %s __attribute__((unused)) = "
+            "static inline const QImage&\n"
+            "%s()\n"
+            "{\n"
+            "    static const QImage image = "
             "QImage::fromData(_%s_data, %d);\n"
+            "    return image;\n"
+            "}\n"
             "#endif\n", varname, varname, size);
     fclose(outputfile);
     return 0;